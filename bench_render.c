@@ -0,0 +1,132 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <SDL2/SDL.h>
+#include "snake_core.h"
+#include "snake_sdl.h"
+
+// Référence du rendu SDL : draw_game en boucle sur des états synthétiques
+// (toutes les tailles de grille, longueur du serpent, obstacles, nourriture)
+// avec le pilote vidéo "dummy" et le renderer logiciel, donc sans écran ni
+// GPU. Pour chaque état : ns par image et appels de dessin SDL par image,
+// pour le rendu SDL direct et pour --software.
+// Usage : ./bench_render [secondes par état]   (0.1 par défaut)
+// SDL_VIDEODRIVER et SDL_RENDER_DRIVER restent prioritaires s'ils sont définis.
+
+// ===== OUTILS =====
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Serpent en zigzag depuis le coin haut gauche, tête en bout de chaîne
+static void lay_snake(Game *game, int length) {
+    Snake *snake = &game->snake1;
+    snake->length = length;
+    for (int i = 0; i < length; i++) {
+        int y = i / game->grid_width, x = i % game->grid_width;
+        snake->body[length - 1 - i] = (Position){y % 2 ? game->grid_width - 1 - x : x, y};
+    }
+}
+
+// Murs sur des cases tirées au hasard (graine fixe : mêmes états à chaque
+// lancement), nourriture de tous les types sur des cases libres.
+static void lay_items(Game *game, int obstacles, int foods, unsigned int seed) {
+    tilemap_clear(&game->map);
+    game->obstacle_count = 0;
+    while (game->obstacle_count < obstacles) {
+        Position pos = {snake_rand(&seed) % game->grid_width, snake_rand(&seed) % game->grid_height};
+        if (tilemap_set_wall(&game->map, pos)) game->obstacle_count++;
+    }
+    game->food_count = foods;
+    for (int i = 0; i < foods; i++) {
+        Position pos;
+        do {
+            pos = (Position){snake_rand(&seed) % game->grid_width, snake_rand(&seed) % game->grid_height};
+        } while (tilemap_get(&game->map, pos) != TILE_EMPTY);
+        game->foods[i].pos = pos;
+        game->foods[i].type = (FoodType)(i % (FOOD_BONUS + 1));
+    }
+}
+
+// Temps par image (ns) et appels de dessin par image sur l'état courant.
+// La première image (couche statique, mise en page du HUD) est hors mesure.
+static void measure(Game *game, double seconds, double *ns, double *calls) {
+    draw_game(game);
+    unsigned long first = sdl_draw_calls;
+    long frames = 0;
+    double begin = now_seconds(), elapsed = 0;
+    while (elapsed < seconds) {
+        for (int i = 0; i < 10; i++) draw_game(game);
+        frames += 10;
+        elapsed = now_seconds() - begin;
+    }
+    *ns = elapsed / frames * 1e9;
+    *calls = (double)(sdl_draw_calls - first) / frames;
+}
+
+// ===== PROGRAMME PRINCIPAL =====
+
+int main(int argc, char *argv[]) {
+    double seconds = argc > 1 ? atof(argv[1]) : 0.1;
+    if (seconds <= 0) {
+        fprintf(stderr, "Usage : %s [secondes par état]\n", argv[0]);
+        return 1;
+    }
+    setenv("SDL_VIDEODRIVER", "dummy", 0);
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    SDL_SetHint(SDL_HINT_RENDER_VSYNC, "0");
+    // Fenêtre à la taille de la plus grande grille (facile, 80x30)
+    screen_w = 80 * CELL_SIZE;
+    screen_h = 30 * CELL_SIZE + 100;
+    if (!init_sdl()) return 1;
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) == 0) {
+        printf("Pilote vidéo : %s, renderer : %s, fenêtre %dx%d\n", SDL_GetCurrentVideoDriver(), info.name,
+               screen_w, screen_h);
+    }
+
+    static const Difficulty grids[] = {DIFF_EASY, DIFF_MEDIUM, DIFF_HARD, DIFF_EXTREME};
+    static const int lengths[] = {3, 300, MAX_LENGTH};
+    static const int obstacle_counts[] = {0, 100, 1000};
+    static const int food_counts[] = {1, MAX_FOOD};
+    Game *game = malloc(sizeof(Game));
+    if (!game) {
+        cleanup_sdl();
+        return 1;
+    }
+    printf("%-7s %8s %9s %6s %12s %8s %12s %8s\n", "grille", "longueur", "obstacles", "repas", "sdl ns/img",
+           "appels", "logiciel ns", "appels");
+    for (int g = 0; g < 4; g++) {
+        init_game_seeded(game, MODE_CLASSIC, grids[g], 0, 1);
+        int cells = game->grid_width * game->grid_height;
+        char grid[16];
+        snprintf(grid, sizeof(grid), "%dx%d", game->grid_width, game->grid_height);
+        for (int o = 0; o < 3; o++) {
+            // Au plus la moitié des cases : la nourriture doit encore trouver place
+            int obstacles = obstacle_counts[o] < cells / 2 ? obstacle_counts[o] : cells / 2;
+            for (int f = 0; f < 2; f++) {
+                lay_items(game, obstacles, food_counts[f], 1234u + o * 16 + f);
+                for (int l = 0; l < 3; l++) {
+                    int length = lengths[l] < cells ? lengths[l] : cells;
+                    lay_snake(game, length);
+                    double ns[2], calls[2];
+                    for (int soft = 0; soft < 2; soft++) {
+                        software_render = soft;
+                        measure(game, seconds, &ns[soft], &calls[soft]);
+                    }
+                    printf("%-7s %8d %9d %6d %12.0f %8.1f %12.0f %8.1f\n", grid, length, obstacles,
+                           food_counts[f], ns[0], calls[0], ns[1], calls[1]);
+                }
+            }
+        }
+        free_game(game);
+    }
+    free(game);
+    cleanup_sdl();
+    return 0;
+}
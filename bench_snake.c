@@ -0,0 +1,1087 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/wait.h>
+#include "snake_core.h"
+#include "snake_arena.h"
+#include "snake_mapgen.h"
+#include "snake_net.h"
+#include "snake_rollback.h"
+#include "snake_shm.h"
+#include "snake_profile.h"
+#include "snake_botpipe.h"
+#include "snake_vec_env.h"
+#include "snake_features.h"
+#include "snake_bitboard.h"
+#include "snake_raster.h"
+#include "snake_session.h"
+#include "snake_leaderboard.h"
+
+// Benchmarks des modules sans affichage.
+// Usage : ./bench_snake [suite...]   (sans argument : toutes les suites)
+
+// ===== OUTILS =====
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// ===== ARÈNE =====
+
+// Passe de collision naïve : chaque tête candidate est comparée à tous les
+// segments de tous les serpents, comme le fait move_snake avec `other`.
+static long naive_collision_pass(const Arena *arena) {
+    long hits = 0;
+    for (int id = 0; id < arena->snake_count; id++) {
+        const ArenaSnake *snake = &arena->snakes[id];
+        if (!snake->alive) continue;
+        Position head = arena_segment(snake, 0);
+        for (int other = 0; other < arena->snake_count; other++) {
+            const ArenaSnake *o = &arena->snakes[other];
+            if (!o->alive) continue;
+            for (int i = (other == id) ? 1 : 0; i < o->length; i++) {
+                Position p = arena_segment(o, i);
+                if (p.x == head.x && p.y == head.y) hits++;
+            }
+        }
+    }
+    return hits;
+}
+
+static void bench_arena() {
+    printf("\n=== Arène : ticks par seconde (grille 1024x1024, longueur max 256) ===\n");
+    printf("%8s %14s %14s %12s %16s\n", "serpents", "ticks/s", "ns/serpent", "longueur moy", "naïf ticks/s");
+    int counts[] = {10, 100, 1000};
+    for (int c = 0; c < 3; c++) {
+        int n = counts[c];
+        Arena arena;
+        if (!arena_init(&arena, 1024, 1024, n, 256, n, 12345)) {
+            fprintf(stderr, "Erreur : allocation de l'arène\n");
+            return;
+        }
+        // Échauffement : laisser les serpents grandir
+        for (int t = 0; t < 500; t++) arena_tick(&arena);
+
+        int ticks = 0;
+        double start = now_seconds();
+        double elapsed = 0;
+        while (elapsed < 0.5) {
+            for (int t = 0; t < 100; t++) arena_tick(&arena);
+            ticks += 100;
+            elapsed = now_seconds() - start;
+        }
+        double rate = ticks / elapsed;
+
+        long total_length = 0;
+        for (int id = 0; id < n; id++) {
+            if (arena.snakes[id].alive) total_length += arena.snakes[id].length;
+        }
+        double avg_length = arena.alive_count ? (double)total_length / arena.alive_count : 0;
+
+        int naive_ticks = 0;
+        long sink = 0;
+        start = now_seconds();
+        elapsed = 0;
+        while (elapsed < 0.5) {
+            sink += naive_collision_pass(&arena);
+            naive_ticks++;
+            elapsed = now_seconds() - start;
+        }
+        double naive_rate = naive_ticks / elapsed;
+
+        printf("%8d %14.0f %14.1f %12.1f %16.1f\n", n, rate, 1e9 / (rate * n),
+               avg_length, naive_rate + (sink < 0));
+        arena_free(&arena);
+    }
+}
+
+// Phase d'intention répartie sur 1..16 threads (IA avec remplissage borné).
+// L'empreinte finale doit être identique pour tous les nombres de threads.
+static void bench_arena_threads() {
+    printf("\n=== Arène multi-thread : 2000 serpents, grille 1024x1024, lookahead 32 ===\n");
+    printf("%8s %12s %10s %20s\n", "threads", "ticks/s", "speedup", "empreinte");
+    int threads[] = {1, 2, 4, 8, 16};
+    double base = 0;
+    for (int t = 0; t < 5; t++) {
+        Arena arena;
+        if (!arena_init(&arena, 1024, 1024, 2000, 256, 2000, 4242)) {
+            fprintf(stderr, "Erreur : allocation de l'arène\n");
+            return;
+        }
+        arena.lookahead = 32;
+        if (!arena_set_threads(&arena, threads[t])) {
+            fprintf(stderr, "Erreur : création des threads\n");
+            arena_free(&arena);
+            return;
+        }
+        for (int i = 0; i < 50; i++) arena_tick(&arena);
+        int ticks = 100;
+        double start = now_seconds();
+        for (int i = 0; i < ticks; i++) arena_tick(&arena);
+        double rate = ticks / (now_seconds() - start);
+        if (t == 0) base = rate;
+        printf("%8d %12.1f %9.2fx %20lx\n", threads[t], rate, rate / base, arena_hash(&arena));
+        arena_free(&arena);
+    }
+}
+
+// ===== GÉNÉRATION DE CARTES =====
+
+// Carte 4096x4096 par motif : génération sous contrainte puis vérification.
+static void bench_mapgen() {
+    printf("\n=== Génération de cartes : 4096x4096, densité 0.20 ===\n");
+    printf("%10s %12s %14s %14s %12s\n", "motif", "obstacles", "génération ms", "vérif. ms", "composantes");
+    TileMap map;
+    if (!tilemap_init(&map, 4096, 4096)) {
+        fprintf(stderr, "Erreur : allocation de la carte\n");
+        return;
+    }
+    MapGenParams params;
+    mapgen_default_params(&params);
+    params.density = 0.2;
+    params.seed = 99;
+    for (int p = 0; p < MAPGEN_PATTERN_COUNT; p++) {
+        params.pattern = (MapPattern)p;
+        double start = now_seconds();
+        int placed = mapgen_generate(&map, &params);
+        double gen = now_seconds() - start;
+        MapReport report;
+        start = now_seconds();
+        mapgen_check(&map, &report);
+        double check = now_seconds() - start;
+        printf("%10s %12d %14.1f %14.1f %12d\n", mapgen_pattern_name(params.pattern), placed,
+               gen * 1000.0, check * 1000.0, report.components);
+    }
+    tilemap_free(&map);
+}
+
+// ===== SERVEUR UDP =====
+
+typedef struct {
+    NetClient *clients;
+    int count;
+    volatile int stop;
+} ClientPool;
+
+// Clients simulés : lisent leurs paquets, acquittent et tournent de temps en temps.
+static void *run_clients(void *data) {
+    ClientPool *pool = data;
+    struct pollfd fds[NET_MAX_CLIENTS];
+    unsigned int rng = 99;
+    for (int i = 0; i < pool->count; i++) fds[i] = (struct pollfd){pool->clients[i].fd, POLLIN, 0};
+    while (!pool->stop) {
+        if (poll(fds, pool->count, 5) <= 0) continue;
+        for (int i = 0; i < pool->count; i++) {
+            if (!(fds[i].revents & POLLIN)) continue;
+            if (net_client_poll(&pool->clients[i]) > 0) {
+                net_client_send_input(&pool->clients[i], (Direction)(snake_rand(&rng) % 4));
+            }
+        }
+    }
+    return NULL;
+}
+
+static double thread_cpu_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Serveur et clients sur la boucle locale, 200 ticks à 100 ticks/s.
+// Débit rapporté à 10 ticks/s (vitesse « moyenne » du jeu).
+static void bench_server() {
+    printf("\n=== Serveur UDP : grille 128x96, 16 bots, 200 ticks sur la boucle locale ===\n");
+    printf("%8s %12s %12s %14s %14s %12s %10s\n", "clients", "octets/tick", "complet", "ko/s à 10 Hz",
+           "CPU µs/tick", "instantanés", "synchro");
+    int counts[] = {2, 8, 64};
+    for (int c = 0; c < 3; c++) {
+        int n = counts[c];
+        NetServer server;
+        if (!net_server_init(&server, 0, 128, 96, n, 16, 128, 16, 2024)) {
+            fprintf(stderr, "Erreur : démarrage du serveur\n");
+            return;
+        }
+        NetClient clients[NET_MAX_CLIENTS];
+        for (int i = 0; i < n; i++) {
+            net_client_init(&clients[i], "127.0.0.1", server.port);
+            net_client_hello(&clients[i]);
+        }
+        ClientPool pool = {clients, n, 0};
+        pthread_t thread;
+        pthread_create(&thread, NULL, run_clients, &pool);
+
+        int ticks = 200;
+        double cpu = 0;
+        for (int t = 0; t < ticks; t++) {
+            double start = thread_cpu_seconds();
+            net_server_poll(&server);
+            net_server_step(&server);
+            net_server_flush(&server);
+            cpu += thread_cpu_seconds() - start;
+            struct timespec ts = {0, 10 * 1000000L};
+            nanosleep(&ts, NULL);
+        }
+        pool.stop = 1;
+        pthread_join(thread, NULL);
+
+        unsigned long bytes = 0, full = 0;
+        int synced = 0;
+        for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+            bytes += server.clients[i].bytes_sent;
+            full += server.clients[i].full_sent;
+        }
+        for (int i = 0; i < n; i++) {
+            net_client_poll(&clients[i]);
+            if (clients[i].ready && clients[i].mirror.tick == server.arena.tick &&
+                arena_hash(&clients[i].mirror) == arena_hash(&server.arena))
+                synced++;
+        }
+        double per_tick = (double)bytes / n / ticks;
+        printf("%8d %12.1f %12d %14.2f %14.1f %12lu %7d/%-2d\n", n, per_tick,
+               net_full_size_bound(&server.arena), per_tick * 10 / 1024.0, cpu / ticks * 1e6,
+               full, synced, n);
+        for (int i = 0; i < n; i++) net_client_free(&clients[i]);
+        net_server_free(&server);
+    }
+}
+
+// ===== ROLLBACK =====
+
+// Coût d'un tick, d'un instantané et d'un rollback de N ticks (restauration,
+// re-simulation des N ticks mal prédits, puis le nouveau tick).
+static void bench_rollback() {
+    printf("\n=== Rollback : deux serpents, mode arcade, grille 60x20 ===\n");
+    Game *game = malloc(sizeof(Game)), *copy = malloc(sizeof(Game));
+    init_game_seeded(game, MODE_ARCADE, DIFF_MEDIUM, 1, 7);
+    int iterations = 100000;
+    double start = now_seconds();
+    for (int i = 0; i < iterations; i++) game_copy_state(copy, game);
+    double snapshot = (now_seconds() - start) / iterations;
+    start = now_seconds();
+    for (int i = 0; i < iterations; i++) memcpy(copy, game, sizeof(Game));
+    double full_copy = (now_seconds() - start) / iterations;
+    start = now_seconds();
+    volatile unsigned long hash = 0;
+    for (int i = 0; i < iterations; i++) hash ^= game_hash(game);
+    double hashing = (now_seconds() - start) / iterations;
+    printf("instantané %.3f µs (copie complète de %zu octets : %.3f µs), empreinte %.3f µs\n",
+           snapshot * 1e6, sizeof(Game), full_copy * 1e6, hashing * 1e6);
+    free_game(game);
+    free(game);
+    free(copy);
+
+    printf("%12s %14s %16s %14s\n", "profondeur", "tick µs", "rollback µs", "rollbacks");
+    int depths[] = {1, 5, 10, 15};
+    Rollback *rb = malloc(sizeof(Rollback));
+    for (int d = 0; d < 4; d++) {
+        int depth = depths[d];
+        double rollback_time = 0, tick_time = 0;
+        long ticks = 0;
+        unsigned long rollbacks = 0;
+        Direction remote = UP;
+        rollback_init(rb, 0, MODE_ARCADE, DIFF_MEDIUM, 7, 0);
+        for (int i = 0; i < 2000; i++) {
+            if (rb->game.game_over) {
+                rollbacks += rb->rollbacks;
+                rollback_free(rb);
+                rollback_init(rb, 0, MODE_ARCADE, DIFF_MEDIUM, 7 + i, 0);
+            }
+            rollback_local_input(rb, i % 2 ? DOWN : RIGHT);
+            start = now_seconds();
+            for (int t = 0; t < depth; t++) rollback_advance(rb);
+            tick_time += now_seconds() - start;
+            ticks += depth;
+            // Le joueur distant a tourné au premier tick prédit : tout est à refaire
+            remote = remote == UP ? RIGHT : UP;
+            for (unsigned long t = rb->known[1]; t < rb->tick; t++) rollback_remote_input(rb, t, remote);
+            start = now_seconds();
+            rollback_advance(rb);
+            rollback_time += now_seconds() - start;
+        }
+        printf("%12d %14.2f %16.2f %14lu\n", depth, tick_time / ticks * 1e6,
+               rollback_time / 2000 * 1e6, rollbacks + rb->rollbacks);
+        rollback_free(rb);
+    }
+    free(rb);
+}
+
+// ===== MÉMOIRE PARTAGÉE =====
+
+// Bot minimal dans un processus fils : attend un nouveau tick, lit la tête et
+// répond aussitôt. S'arrête quand le jeu publie game_over.
+static void shm_bot_process(const char *name) {
+    ShmLink link;
+    if (!shm_attach(&link, name)) _exit(1);
+    uint64_t answered = 0;
+    for (;;) {
+        uint32_t seq = shm_read_begin(&link);
+        uint64_t tick = link.region->state.tick;
+        int over = link.region->state.game_over;
+        Direction direction = (Direction)((link.region->state.snakes[0].direction + (tick % 7 == 0)) % 4);
+        if (shm_read_retry(&link, seq)) continue;
+        if (over) break;
+        if (tick == answered) {
+            sched_yield();
+            continue;
+        }
+        shm_send(&link, 0, tick, direction);
+        answered = tick;
+    }
+    shm_close(&link);
+    _exit(0);
+}
+
+// Aller-retour par tick : publication de l'état, réponse du bot (autre
+// processus), lecture de la commande. Les deux côtés attendent en cédant le
+// processeur (sched_yield), sans autre appel système.
+static void bench_shm() {
+    printf("\n=== Mémoire partagée : aller-retour jeu -> bot -> jeu, 20000 ticks ===\n");
+    char name[64];
+    snprintf(name, sizeof(name), "snake_bench_%d", (int)getpid());
+    ShmLink link;
+    if (!shm_create(&link, name, 1)) {
+        fprintf(stderr, "Erreur : création de la région %s\n", name);
+        return;
+    }
+    Game *game = malloc(sizeof(Game));
+    init_game_seeded(game, MODE_FREE, DIFF_MEDIUM, 0, 5);
+    pid_t pid = fork();
+    if (pid == 0) shm_bot_process(name);
+
+    ProfileSeries *latency = calloc(1, sizeof(ProfileSeries));
+    double publish = 0;
+    int ticks = 20000;
+    for (int t = 0; t < ticks; t++) {
+        step_game(game);
+        game->game_over = 0;
+        double start = profiler_now_ms();
+        shm_publish(&link, game);
+        publish += profiler_now_ms() - start;
+        for (;;) {
+            uint64_t command = atomic_load_explicit(&link.region->commands[0], memory_order_acquire);
+            if ((command >> 8) == game->tick) break;
+            sched_yield();
+        }
+        profile_add(latency, profiler_now_ms() - start);
+        shm_apply_commands(&link, game);
+    }
+    game->game_over = 1;
+    shm_publish(&link, game);
+    waitpid(pid, NULL, 0);
+
+    printf("publication %.2f µs, aller-retour médian %.2f µs, p99 %.2f µs, max %.1f µs, %lu commandes\n",
+           publish / ticks * 1000.0, profile_percentile(latency, 50) * 1000.0,
+           profile_percentile(latency, 99) * 1000.0, latency->max * 1000.0, link.commands);
+    shm_close(&link);
+    free_game(game);
+    free(game);
+    free(latency);
+}
+
+// ===== PROTOCOLE STDIN/STDOUT =====
+
+// Bot trivial : vers la nourriture, en évitant les cases signalées dangereuses.
+static unsigned char trivial_action(const unsigned char *obs) {
+    int hx = obs[4], hy = obs[5], dir = obs[6], flags = obs[7], fx = obs[8], fy = obs[9];
+    int wanted = fx > hx ? RIGHT : fx < hx ? LEFT : fy > hy ? DOWN : UP;
+    for (int k = 0; k < 4; k++) {
+        int d = (wanted + k) % 4;
+        if (d != (dir + 2) % 4 && !(flags & (1 << (BOTPIPE_DANGER_SHIFT + d)))) return (unsigned char)d;
+    }
+    return BOTPIPE_KEEP;
+}
+
+// Pas par seconde, bot compris : le jeu tourne dans un processus fils relié
+// par deux tubes, le bot (ce processus) répond à chaque message. Sur une
+// machine à un cœur, les deux processus se partagent ce cœur.
+static void bench_botpipe() {
+    printf("\n=== Protocole --bot-pipe : grille 60x20, bot trivial, tubes ===\n");
+    printf("%8s %8s %14s %14s %12s\n", "envs", "batch", "pas/s", "ns/pas", "épisodes");
+    int configs[][2] = {{1, 1}, {64, 1}, {1, 64}, {16, 16}, {64, 64}, {256, 16}};
+    for (int c = 0; c < 6; c++) {
+        BotPipeParams params;
+        botpipe_default_params(&params);
+        params.envs = configs[c][0];
+        params.batch = configs[c][1];
+        params.max_steps = 1000;
+        int to_game[2], to_bot[2];
+        if (pipe(to_game) != 0 || pipe(to_bot) != 0) return;
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(to_game[1]);
+            close(to_bot[0]);
+            BotPipe bp;
+            if (!botpipe_init(&bp, &params)) _exit(1);
+            int status = botpipe_run(&bp, to_game[0], to_bot[1]);
+            botpipe_free(&bp);
+            _exit(status ? 0 : 1);
+        }
+        close(to_game[0]);
+        close(to_bot[1]);
+
+        FILE *in = fdopen(to_bot[0], "rb");
+        unsigned char header[BOTPIPE_HEADER_SIZE];
+        size_t steps = (size_t)params.envs * params.batch;
+        unsigned char *actions = malloc(steps);
+        unsigned char *obs = malloc(steps * BOTPIPE_OBS_SIZE);
+        if (fread(header, 1, sizeof(header), in) != sizeof(header)) return;
+        memset(actions, BOTPIPE_KEEP, steps);
+        long total = 0, episodes = 0;
+        double start = now_seconds();
+        while (now_seconds() - start < 0.5) {
+            if (write(to_game[1], actions, steps) != (ssize_t)steps) break;
+            if (fread(obs, BOTPIPE_OBS_SIZE, steps, in) != steps) break;
+            // La dernière observation de chaque environnement décide du prochain message
+            const unsigned char *last = obs + (steps - params.envs) * BOTPIPE_OBS_SIZE;
+            for (int i = 0; i < params.envs; i++) {
+                unsigned char action = trivial_action(last + i * BOTPIPE_OBS_SIZE);
+                for (int k = 0; k < params.batch; k++) actions[k * params.envs + i] = k == 0 ? action : BOTPIPE_KEEP;
+            }
+            for (size_t i = 0; i < steps; i++) episodes += obs[i * BOTPIPE_OBS_SIZE + 7] & BOTPIPE_FLAG_DONE;
+            total += (long)steps;
+        }
+        double elapsed = now_seconds() - start;
+        close(to_game[1]);
+        fclose(in);
+        waitpid(pid, NULL, 0);
+        printf("%8d %8d %14.0f %14.1f %12ld\n", params.envs, params.batch, total / elapsed,
+               elapsed / total * 1e9, episodes);
+        free(actions);
+        free(obs);
+    }
+}
+
+// ===== ENVIRONNEMENT VECTORISÉ =====
+
+// Pas par seconde de vec_env_step, dans le même processus (pas de tube) :
+// avec observation complète (grille de N x 20 x 60 octets) puis sans.
+static void bench_vec_env() {
+    printf("\n=== Environnement vectorisé : grille 60x20, actions aléatoires ===\n");
+    printf("%8s %8s %14s %14s %12s\n", "envs", "obs", "pas/s", "ns/pas", "épisodes");
+    int sizes[] = {1, 16, 256};
+    for (int c = 0; c < 3; c++) {
+        for (int with_obs = 1; with_obs >= 0; with_obs--) {
+            int n = sizes[c];
+            VecEnv env;
+            if (!vec_env_init(&env, n, MODE_CLASSIC, DIFF_MEDIUM, 1000)) return;
+            unsigned char *obs = malloc((size_t)n * env.width * env.height);
+            unsigned char *actions = malloc(n), *dones = malloc(n);
+            float *rewards = malloc(n * sizeof(float));
+            unsigned int rng = 9;
+            vec_env_reset(&env, NULL, obs);
+            double start = now_seconds();
+            while (now_seconds() - start < 0.5) {
+                for (int k = 0; k < 64; k++) {
+                    for (int i = 0; i < n; i++) {
+                        unsigned int r = snake_rand(&rng) % 16;
+                        actions[i] = r < 4 ? (unsigned char)r : VEC_ENV_KEEP;
+                    }
+                    vec_env_step(&env, actions, with_obs ? obs : NULL, rewards, dones);
+                }
+            }
+            double elapsed = now_seconds() - start;
+            printf("%8d %8s %14.0f %14.1f %12lu\n", n, with_obs ? "oui" : "non", env.steps / elapsed,
+                   elapsed / env.steps * 1e9, env.episodes_done);
+            free(obs);
+            free(actions);
+            free(dones);
+            free(rewards);
+            vec_env_free(&env);
+        }
+    }
+}
+
+// ===== PLANS DE CARACTÉRISTIQUES =====
+
+// Temps d'encodage d'un lot de 64 parties du mode défi (10 plans 60x20),
+// version naïve puis chaque jeu d'instructions disponible.
+static void bench_features() {
+    static const char *names[] = {"scalaire", "sse2", "avx2"};
+    printf("\n=== Plans de caractéristiques : 64 parties, 10 x 20 x 60 ===\n");
+    printf("%-10s %16s %16s\n", "encodeur", "uint8 ns/partie", "float ns/partie");
+    int count = 64;
+    Game *games = malloc(count * sizeof(Game));
+    for (int i = 0; i < count; i++) {
+        init_game_seeded(&games[i], MODE_CHALLENGE, DIFF_HARD, 0, 200 + i);
+        for (int t = 0; t < 30; t++) step_game(&games[i]);
+    }
+    size_t size = features_size(&games[0]);
+    unsigned char *u8 = malloc(count * size);
+    float *f32 = malloc(count * size * sizeof(float));
+    FeaturesSimd best = features_simd_available();
+    for (int level = -1; level <= (int)best; level++) {
+        double ns[2];
+        for (int type = 0; type < 2; type++) {
+            if (level >= 0) features_set_simd((FeaturesSimd)level);
+            long encoded = 0;
+            double start = now_seconds();
+            while (now_seconds() - start < 0.3) {
+                for (int i = 0; i < count; i++) {
+                    if (level < 0 && type == 0) features_encode_naive_u8(&games[i], u8 + i * size);
+                    else if (level < 0) features_encode_naive_f32(&games[i], f32 + i * size);
+                }
+                if (level >= 0 && type == 0) features_encode_batch_u8(games, count, u8);
+                else if (level >= 0) features_encode_batch_f32(games, count, f32);
+                encoded += count;
+            }
+            ns[type] = (now_seconds() - start) / encoded * 1e9;
+        }
+        printf("%-10s %16.0f %16.0f\n", level < 0 ? "naïf" : names[level], ns[0], ns[1]);
+    }
+    features_set_simd(best);
+    for (int i = 0; i < count; i++) free_game(&games[i]);
+    free(games);
+    free(u8);
+    free(f32);
+}
+
+// ===== NOYAUX PAR TAILLE DE GRILLE =====
+
+// Ticks par seconde pour chaque difficulté, noyau spécialisé et générique
+// (game->kernel = NULL) en alternance, meilleur de 5 manches de 0,1 s.
+// 64 parties en mode arcade, virages aléatoires.
+static double kernel_rate(Game *games, int count, Difficulty diff, int generic) {
+    for (int i = 0; i < count; i++) {
+        init_game_seeded(&games[i], MODE_ARCADE, diff, 0, 500 + i);
+        if (generic) games[i].kernel = NULL;
+    }
+    unsigned int rng = 5;
+    long ticks = 0;
+    double start = now_seconds();
+    while (now_seconds() - start < 0.1) {
+        for (int k = 0; k < 100; k++) {
+            for (int i = 0; i < count; i++) {
+                unsigned int r = snake_rand(&rng);
+                if (r % 8 == 0) queue_turn(&games[i].snake1, (Direction)(r / 8 % 4), 0);
+                step_game(&games[i]);
+                if (games[i].game_over) reset_game(&games[i], r);
+            }
+        }
+        ticks += 100L * count;
+    }
+    double rate = ticks / (now_seconds() - start);
+    for (int i = 0; i < count; i++) free_game(&games[i]);
+    return rate;
+}
+
+static void bench_kernels() {
+    static const char *names[] = {"facile", "moyen", "difficile", "extrême"};
+    static const int sizes[][2] = {{80, 30}, {GRID_WIDTH, GRID_HEIGHT}, {50, 18}, {40, 15}};
+    printf("\n=== Noyaux par taille de grille : 64 parties arcade ===\n");
+    printf("%-10s %8s %16s %16s %8s\n", "difficulté", "grille", "spécialisé t/s", "générique t/s", "gain");
+    int count = 64;
+    Game *games = malloc(count * sizeof(Game));
+    for (int diff = DIFF_EASY; diff <= DIFF_EXTREME; diff++) {
+        double best[2] = {0, 0};
+        for (int round = 0; round < 5; round++) {
+            for (int generic = 0; generic < 2; generic++) {
+                double rate = kernel_rate(games, count, (Difficulty)diff, generic);
+                if (rate > best[generic]) best[generic] = rate;
+            }
+        }
+        char grid[16];
+        snprintf(grid, sizeof(grid), "%dx%d", sizes[diff][0], sizes[diff][1]);
+        printf("%-10s %8s %16.0f %16.0f %7.2fx\n", names[diff], grid, best[0], best[1], best[0] / best[1]);
+    }
+    free(games);
+}
+
+// ===== BITBOARDS =====
+
+// Serpent de `length` cases posé en lacets à partir du coin haut gauche.
+static void lay_snake(Game *game, int length) {
+    Snake *snake = &game->snake1;
+    snake->length = length;
+    for (int i = 0; i < length; i++) {
+        int y = i / game->grid_width, x = i % game->grid_width;
+        snake->body[length - 1 - i] = (Position){y % 2 ? game->grid_width - 1 - x : x, y};
+    }
+}
+
+// Tirage par essais, comme avant les bitboards
+static int pick_by_attempts(Game *game, Position *pos) {
+    int attempts = 0;
+    do {
+        *pos = generate_random_position(game);
+        attempts++;
+    } while (!is_position_valid(game, *pos, 1) && attempts < 100);
+    return attempts < 100;
+}
+
+static int pick_by_bitboard(Game *game, Position *pos) {
+    Bitboard free_cells;
+    bitboard_game_free(game, &free_cells);
+    long count = bitboard_count(&free_cells);
+    return count > 0 && bitboard_nth(&free_cells, snake_rand(&game->rng) % count, pos);
+}
+
+// Région atteignable case par case (parcours en largeur sur la grille)
+static long area_by_cells(const Game *game, Position start, unsigned char *seen, Position *queue) {
+    int width = game->grid_width, height = game->grid_height;
+    memset(seen, 0, (size_t)width * height);
+    for (int i = 0; i < game->snake1.length; i++) seen[game->snake1.body[i].y * width + game->snake1.body[i].x] = 1;
+    for (long i = 0; i < (long)width * height; i++) if (game->map.tiles[i] == TILE_WALL) seen[i] = 1;
+    if (start.x < 0 || start.x >= width || start.y < 0 || start.y >= height || seen[start.y * width + start.x]) return 0;
+    long head = 0, tail = 0;
+    seen[start.y * width + start.x] = 1;
+    queue[tail++] = start;
+    static const int dx[4] = {0, 1, 0, -1}, dy[4] = {-1, 0, 1, 0};
+    while (head < tail) {
+        Position p = queue[head++];
+        for (int d = 0; d < 4; d++) {
+            Position n = {p.x + dx[d], p.y + dy[d]};
+            if (n.x < 0 || n.x >= width || n.y < 0 || n.y >= height || seen[n.y * width + n.x]) continue;
+            seen[n.y * width + n.x] = 1;
+            queue[tail++] = n;
+        }
+    }
+    return tail;
+}
+
+static double time_loop(double seconds, long *calls, void (*body)(void *), void *arg) {
+    long n = 0;
+    double start = now_seconds(), elapsed;
+    do {
+        for (int i = 0; i < 100; i++) body(arg);
+        n += 100;
+    } while ((elapsed = now_seconds() - start) < seconds);
+    *calls = n;
+    return elapsed / n * 1e9;
+}
+
+typedef struct {
+    Game *game;
+    long found;
+    unsigned char *seen;
+    Position *queue;
+    Bitboard passable;
+    TileMap *map;
+} BitboardCase;
+
+static void run_pick_attempts(void *arg) {
+    BitboardCase *c = arg;
+    Position pos;
+    c->found += pick_by_attempts(c->game, &pos);
+}
+
+static void run_pick_bitboard(void *arg) {
+    BitboardCase *c = arg;
+    Position pos;
+    c->found += pick_by_bitboard(c->game, &pos);
+}
+
+static void run_area_cells(void *arg) {
+    BitboardCase *c = arg;
+    c->found += area_by_cells(c->game, (Position){c->game->grid_width - 1, c->game->grid_height - 1}, c->seen, c->queue);
+}
+
+static void run_area_bitboard(void *arg) {
+    BitboardCase *c = arg;
+    Bitboard passable;
+    bitboard_game_passable(c->game, &passable);
+    c->found += bitboard_game_area(c->game, &passable, (Position){c->game->grid_width - 1, c->game->grid_height - 1});
+}
+
+static void run_check_runs(void *arg) {
+    BitboardCase *c = arg;
+    MapReport report;
+    c->found += mapgen_check(c->map, &report);
+}
+
+static void run_check_bitboard(void *arg) {
+    BitboardCase *c = arg;
+    Bitboard blocked, free_cells;
+    bitboard_from_map(&blocked, &free_cells, c->map);
+    bitboard_or(&blocked, &blocked, &free_cells);
+    bitboard_fill(&free_cells);
+    bitboard_andnot(&free_cells, &free_cells, &blocked);
+    long largest;
+    c->found += bitboard_components(&free_cells, &largest) <= 1;
+}
+
+// Boucles par case contre bitboards. Case libre au hasard : grille extrême
+// (40x15), de vide à presque pleine ; région atteignable : grille facile
+// (80x30, deux mots par ligne) ; connexité des cartes générées en 80x30.
+static void bench_bitboard() {
+    printf("\n=== Bitboards ===\n");
+    printf("%-30s %9s %12s %12s %7s %s\n", "opération", "occupé", "par case ns", "bitboard ns", "gain",
+           "échecs par essais");
+    Game *game = malloc(sizeof(Game));
+    init_game_seeded(game, MODE_CHALLENGE, DIFF_EXTREME, 0, 77);
+    BitboardCase c = {game, 0, malloc(80 * 30), malloc(80 * 30 * sizeof(Position)), {0}, &game->map};
+    int cells = game->grid_width * game->grid_height;
+    int lengths[] = {3, 300, 500, 570};
+    for (int k = 0; k < 4; k++) {
+        lay_snake(game, lengths[k]);
+        long calls, attempts_calls;
+        double by_bits = time_loop(0.2, &calls, run_pick_bitboard, &c);
+        c.found = 0;
+        double by_cells = time_loop(0.2, &attempts_calls, run_pick_attempts, &c);
+        char occupied[16];
+        snprintf(occupied, sizeof(occupied), "%d %%", lengths[k] * 100 / cells);
+        printf("%-30s %9s %12.0f %12.0f %6.1fx %ld %%\n", "case libre au hasard (40x15)", occupied, by_cells,
+               by_bits, by_cells / by_bits, 100 - c.found * 100 / attempts_calls);
+    }
+    free_game(game);
+
+    init_game_seeded(game, MODE_CHALLENGE, DIFF_EASY, 0, 77);
+    cells = game->grid_width * game->grid_height;
+    int area_lengths[] = {3, 300, 999};
+    for (int k = 0; k < 3; k++) {
+        lay_snake(game, area_lengths[k]);
+        long calls;
+        double by_cells = time_loop(0.2, &calls, run_area_cells, &c);
+        double by_bits = time_loop(0.2, &calls, run_area_bitboard, &c);
+        char occupied[16];
+        snprintf(occupied, sizeof(occupied), "%d %%", area_lengths[k] * 100 / cells);
+        printf("%-30s %9s %12.0f %12.0f %6.1fx\n", "région atteignable (80x30)", occupied, by_cells, by_bits,
+               by_cells / by_bits);
+    }
+    static const MapPattern patterns[] = {MAPGEN_SCATTER, MAPGEN_SEGMENTS, MAPGEN_BLOCKS};
+    for (int p = 0; p < 3; p++) {
+        MapGenParams params;
+        mapgen_default_params(&params);
+        params.pattern = patterns[p];
+        params.density = 0.2;
+        TileMap map;
+        tilemap_init(&map, 80, 30);
+        mapgen_generate(&map, &params);
+        c.map = &map;
+        long calls;
+        double runs = time_loop(0.2, &calls, run_check_runs, &c);
+        double bits = time_loop(0.2, &calls, run_check_bitboard, &c);
+        char label[64];
+        snprintf(label, sizeof(label), "connexité %s (80x30)", mapgen_pattern_name(patterns[p]));
+        printf("%-30s %9s %12.0f %12.0f %6.1fx\n", label, "20 %", runs, bits, runs / bits);
+        tilemap_free(&map);
+    }
+    free(c.seen);
+    free(c.queue);
+    free_game(game);
+    free(game);
+}
+
+// ===== RENDU LOGICIEL =====
+
+// Coût d'une image (grille facile 80x30, cases de 20 pixels, HUD compris)
+// par niveau SIMD, pour un plateau de défi au départ et un serpent de 999
+// cases, puis écriture d'une image en PPM et en PNG.
+static void bench_raster() {
+    static const char *names[] = {"scalaire", "sse2", "avx2"};
+    Game *game = malloc(sizeof(Game));
+    init_game_seeded(game, MODE_CHALLENGE, DIFF_EASY, 0, 21);
+    int cell = 20, width, height;
+    raster_game_size(game->grid_width, game->grid_height, cell, &width, &height);
+    RasterImage image;
+    raster_init(&image, width, height);
+    printf("\n=== Rendu logiciel : %dx%d pixels ===\n", width, height);
+    printf("%-10s %16s %16s\n", "remplissage", "départ µs/image", "long µs/image");
+    RasterSimd best = raster_simd_available();
+    Snake start = game->snake1;
+    for (int level = RASTER_SCALAR; level <= (int)best; level++) {
+        raster_set_simd((RasterSimd)level);
+        double us[2];
+        for (int k = 0; k < 2; k++) {
+            if (k == 0) game->snake1 = start;
+            else lay_snake(game, MAX_LENGTH - 1);
+            long frames = 0;
+            double begin = now_seconds();
+            while (now_seconds() - begin < 0.3) {
+                raster_draw_game(&image, game, cell);
+                frames++;
+            }
+            us[k] = (now_seconds() - begin) / frames * 1e6;
+        }
+        printf("%-10s %16.1f %16.1f\n", names[level], us[0], us[1]);
+    }
+    raster_set_simd(best);
+    const char *path = "/tmp/bench_snake_raster.img";
+    for (int png = 0; png < 2; png++) {
+        int images = 0;
+        double begin = now_seconds();
+        while (now_seconds() - begin < 0.3 && (png ? raster_write_png(&image, path) : raster_write_ppm(&image, path))) {
+            images++;
+        }
+        printf("écriture %s : %.0f µs/image\n", png ? "PNG" : "PPM", images ? (now_seconds() - begin) / images * 1e6 : 0);
+    }
+    remove(path);
+    raster_free(&image);
+    free_game(game);
+    free(game);
+}
+
+// ===== JOURNAL DES PARTIES =====
+
+static void sum_scores(const SessionRecord *record, void *context) {
+    *(long *)context += record->score;
+}
+
+// Un million de parties en séries de tournoi (même mode et difficulté par
+// série de 5000), étalées sur 90 jours : débit d'ajout, construction de
+// l'index, puis « arcade / difficile, 30 derniers jours » avec et sans index.
+static void bench_sessions() {
+    const char *path = "/tmp/bench_snake_sessions";
+    char index_path[64];
+    snprintf(index_path, sizeof(index_path), "%s.idx", path);
+    unlink(path);
+    unlink(index_path);
+    const long total = 1000000;
+    Game *game = malloc(sizeof(Game));
+    init_game_seeded(game, MODE_CLASSIC, DIFF_MEDIUM, 0, 1);
+    printf("\n=== Journal des parties : %ld parties ===\n", total);
+
+    SessionLog log;
+    if (!session_log_open(&log, path, SESSION_SYNC_EVERY)) {
+        printf("journal impossible à créer\n");
+        free_game(game);
+        free(game);
+        return;
+    }
+    unsigned int rng = 5;
+    int64_t now = (int64_t)time(NULL), span = 90 * 86400;
+    SessionRecord record;
+    session_record_fill(&record, game, 0, SESSION_HEADLESS);
+    double begin = now_seconds();
+    for (long i = 0; i < total; i++) {
+        if (i % 5000 == 0) {
+            record.mode = (uint8_t)(snake_rand(&rng) % SESSION_MODES);
+            record.difficulty = (uint8_t)(snake_rand(&rng) % SESSION_DIFFICULTIES);
+        }
+        record.end_time = now - span + span * i / total;
+        record.seed = (uint32_t)i;
+        record.score = (int32_t)(snake_rand(&rng) % 2000);
+        session_log_append(&log, &record);
+    }
+    session_log_close(&log);
+    double append = now_seconds() - begin;
+    printf("ajout : %.0f ns/partie, %lu fdatasync\n", append / total * 1e9, log.syncs);
+
+    SessionMap map;
+    SessionIndex index;
+    if (!session_map_open(&map, path)) {
+        printf("journal illisible\n");
+        free_game(game);
+        free(game);
+        return;
+    }
+    for (int pass = 0; pass < 2; pass++) {
+        begin = now_seconds();
+        session_index_open(&index, index_path, &map);
+        printf("index %s : %.2f ms, %zu blocs\n", pass ? "relu" : "construit", (now_seconds() - begin) * 1000,
+               index.count);
+        if (pass == 0) session_index_free(&index);
+    }
+
+    SessionQuery query = {MODE_ARCADE, DIFF_HARD, now - 30 * 86400, 0};
+    printf("%-10s %10s %12s %12s %10s\n", "requête", "retenues", "blocs lus", "enreg. lus", "ms");
+    for (int use = 1; use >= 0; use--) {
+        SessionScan scan;
+        long sum = 0;
+        begin = now_seconds();
+        session_query(&map, use ? &index : NULL, &query, sum_scores, &sum, &scan);
+        printf("%-10s %10zu %12zu %12zu %10.2f\n", use ? "index" : "sans index", scan.matched, scan.blocks_read,
+               scan.records_read, (now_seconds() - begin) * 1000);
+    }
+    session_index_free(&index);
+    session_map_close(&map);
+    unlink(path);
+    unlink(index_path);
+    free_game(game);
+    free(game);
+}
+
+// ===== CLASSEMENTS =====
+
+static int tree_depth(const Leaderboard *board, int node) {
+    if (node < 0) return 0;
+    int left = tree_depth(board, board->nodes[node].left), right = tree_depth(board, board->nodes[node].right);
+    return 1 + (left > right ? left : right);
+}
+
+// Un million de scores dans un classement de 100000 places, puis rangs et
+// entrées au hasard ; comparaison avec l'ancien tableau trié à décalage
+// (classement plein) et coût du chargement paresseux après écriture.
+static void bench_leaderboard() {
+    const long total = 1000000;
+    const char *path = "/tmp/bench_snake_leaderboard.bin";
+    unlink(path);
+    printf("\n=== Classements : %ld scores, %d places ===\n", total, LEADERBOARD_CAPACITY);
+    Leaderboard board;
+    leaderboard_open(&board, path, LEADERBOARD_CAPACITY);
+    unsigned int rng = 17;
+    long accepted = 0;
+    double begin = now_seconds();
+    for (long i = 0; i < total; i++) {
+        accepted += leaderboard_insert(&board, (int)(snake_rand(&rng) % 1000000), 1, "Bench", i) > 0;
+    }
+    double insert = now_seconds() - begin;
+    printf("ajout : %.0f ns/score (%ld retenus), profondeur de l'arbre %d\n", insert / total * 1e9, accepted,
+           tree_depth(&board, board.root));
+
+    // Scores tirés dans la plage du classement (sinon presque tous tombent après la dernière place)
+    LeaderEntry entry;
+    leaderboard_entry(&board, LEADERBOARD_CAPACITY, &entry);
+    int low = entry.score;
+    long checksum = 0;
+    begin = now_seconds();
+    for (long i = 0; i < total; i++) {
+        checksum += leaderboard_rank(&board, low + (int)(snake_rand(&rng) % (unsigned int)(1000000 - low)));
+    }
+    double rank = now_seconds() - begin;
+    begin = now_seconds();
+    for (long i = 0; i < total; i++) {
+        leaderboard_entry(&board, 1 + snake_rand(&rng) % LEADERBOARD_CAPACITY, &entry);
+        checksum += entry.score;
+    }
+    double select = now_seconds() - begin;
+    printf("rang d'un score : %.0f ns, entrée d'un rang : %.0f ns (%ld)\n", rank / total * 1e9,
+           select / total * 1e9, checksum % 10);
+
+    begin = now_seconds();
+    leaderboard_save(&board);
+    double save = now_seconds() - begin;
+    leaderboard_close(&board);
+    begin = now_seconds();
+    leaderboard_open(&board, path, LEADERBOARD_CAPACITY);
+    checksum = leaderboard_rank(&board, 500000);
+    double lazy = now_seconds() - begin;
+    begin = now_seconds();
+    leaderboard_insert(&board, 500000, 1, "Bench", 0);
+    double build = now_seconds() - begin;
+    printf("écriture : %.1f ms, ouverture + rang : %.1f µs, premier ajout (arbre) : %.1f ms\n", save * 1000,
+           lazy * 1e6, build * 1000);
+    leaderboard_close(&board);
+    unlink(path);
+
+    // Ancien format : tableau trié, insertion par décalage, classement plein
+    LeaderEntry *table = malloc(LEADERBOARD_CAPACITY * sizeof(LeaderEntry));
+    if (!table) return;
+    for (int i = 0; i < LEADERBOARD_CAPACITY; i++) table[i].score = LEADERBOARD_CAPACITY - i;
+    const int naive = 2000;
+    begin = now_seconds();
+    for (int i = 0; i < naive; i++) {
+        int score = (int)(snake_rand(&rng) % LEADERBOARD_CAPACITY), pos = 0;
+        while (pos < LEADERBOARD_CAPACITY && table[pos].score >= score) pos++;
+        if (pos >= LEADERBOARD_CAPACITY) continue;
+        memmove(table + pos + 1, table + pos, (LEADERBOARD_CAPACITY - 1 - pos) * sizeof(LeaderEntry));
+        table[pos].score = score;
+    }
+    printf("tableau trié à décalage : %.0f ns/score\n", (now_seconds() - begin) / naive * 1e9);
+    free(table);
+}
+
+// Un processus soumetteur. Mode 0 : journal (leaderboard_submit). Mode 1 :
+// lecture-fusion-écriture de tout le classement sous flock exclusif. Mode 2 :
+// ancienne écriture sans verrou (ouverture, ajout, réécriture).
+static void leaderboard_writer(const char *path, int mode, int writer, int submits) {
+    char lock_path[128];
+    snprintf(lock_path, sizeof(lock_path), "%s.lock", path);
+    int lock = mode == 1 ? open(lock_path, O_RDWR | O_CREAT, 0644) : -1;
+    int ok = 1;
+    for (int i = 0; i < submits; i++) {
+        int score = writer * submits + i;
+        if (mode == 0) {
+            ok &= leaderboard_submit(path, LEADERBOARD_CAPACITY, score, 1, "Bench", i);
+            continue;
+        }
+        if (lock >= 0) flock(lock, LOCK_EX);
+        Leaderboard board;
+        ok &= leaderboard_open(&board, path, LEADERBOARD_CAPACITY) &&
+              leaderboard_insert(&board, score, 1, "Bench", i) > 0 && leaderboard_save(&board);
+        leaderboard_close(&board);
+        if (lock >= 0) flock(lock, LOCK_UN);
+    }
+    _exit(ok ? 0 : 1);
+}
+
+// 64 processus soumettent leurs scores au même classement en même temps ;
+// débit total et scores retrouvés ensuite (tous différents).
+static void bench_leaderboard_writers() {
+    const int writers = 64;
+    const char *path = "/tmp/bench_snake_writers.bin";
+    const char *labels[] = {"journal + fusion", "flock + réécriture", "sans verrou"};
+    const int submits[] = {500, 20, 20};
+    printf("\n=== Classements : %d processus soumettent en même temps ===\n", writers);
+    printf("%-20s %10s %12s %12s %10s\n", "méthode", "scores", "scores/s", "retrouvés", "perdus");
+    for (int mode = 0; mode < 3; mode++) {
+        char journal[128], lock_path[128];
+        snprintf(journal, sizeof(journal), "%s.journal", path);
+        snprintf(lock_path, sizeof(lock_path), "%s.lock", path);
+        unlink(path);
+        unlink(journal);
+        unlink(lock_path);
+        pid_t pids[64];
+        double begin = now_seconds();
+        for (int w = 0; w < writers; w++) {
+            pids[w] = fork();
+            if (pids[w] == 0) leaderboard_writer(path, mode, w, submits[mode]);
+        }
+        for (int w = 0; w < writers; w++) {
+            if (pids[w] > 0) waitpid(pids[w], NULL, 0);
+        }
+        double elapsed = now_seconds() - begin;
+        long total = (long)writers * submits[mode];
+        Leaderboard board;
+        long found = leaderboard_open(&board, path, LEADERBOARD_CAPACITY) ? leaderboard_count(&board) : 0;
+        leaderboard_close(&board);
+        printf("%-20s %10ld %12.0f %12ld %10ld\n", labels[mode], total, total / elapsed, found, total - found);
+        unlink(path);
+        unlink(journal);
+        unlink(lock_path);
+    }
+}
+
+// ===== PROGRAMME PRINCIPAL =====
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+} BenchSuite;
+
+static const BenchSuite suites[] = {
+    {"arena", bench_arena},
+    {"arena-threads", bench_arena_threads},
+    {"mapgen", bench_mapgen},
+    {"server", bench_server},
+    {"rollback", bench_rollback},
+    {"shm", bench_shm},
+    {"botpipe", bench_botpipe},
+    {"vecenv", bench_vec_env},
+    {"features", bench_features},
+    {"kernels", bench_kernels},
+    {"bitboard", bench_bitboard},
+    {"raster", bench_raster},
+    {"sessions", bench_sessions},
+    {"leaderboard", bench_leaderboard},
+    {"leaderboard-writers", bench_leaderboard_writers},
+};
+
+int main(int argc, char *argv[]) {
+    int suite_count = sizeof(suites) / sizeof(suites[0]);
+    if (argc < 2) {
+        for (int i = 0; i < suite_count; i++) suites[i].run();
+        return 0;
+    }
+    for (int a = 1; a < argc; a++) {
+        int found = 0;
+        for (int i = 0; i < suite_count; i++) {
+            if (strcmp(argv[a], suites[i].name) == 0) {
+                suites[i].run();
+                found = 1;
+            }
+        }
+        if (!found) {
+            fprintf(stderr, "Suite inconnue : %s\n", argv[a]);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+"""Bot minimal pour le protocole --bot-pipe (voir snake_botpipe.h).
+
+    python3 examples/pipe_bot.py [envs] [batch] [messages]
+
+Lance ./snake_headless, lit l'en-tête puis joue : pour chaque environnement,
+va vers la nourriture en évitant les cases signalées dangereuses. Affiche le
+débit et le score moyen par épisode. Bibliothèque standard uniquement.
+"""
+import struct
+import subprocess
+import sys
+import time
+
+OBS = struct.Struct("<IBBBBBBHhH")  # 16 octets
+KEEP, DONE, DANGER_SHIFT = 4, 0x01, 4
+
+
+def act(head_x, head_y, direction, flags, food_x, food_y):
+    wanted = 1 if food_x > head_x else 3 if food_x < head_x else 2 if food_y > head_y else 0
+    for k in range(4):
+        d = (wanted + k) % 4
+        if d != (direction + 2) % 4 and not flags & (1 << (DANGER_SHIFT + d)):
+            return d
+    return KEEP
+
+
+def main():
+    envs = int(sys.argv[1]) if len(sys.argv) > 1 else 16
+    batch = int(sys.argv[2]) if len(sys.argv) > 2 else 1
+    messages = int(sys.argv[3]) if len(sys.argv) > 3 else 2000
+    game = subprocess.Popen(["./snake_headless", "--bot-pipe", "--envs", str(envs), "--batch", str(batch),
+                             "--max-steps", "2000"], stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+    header = game.stdout.read(16)
+    magic, _version, obs_size, envs, batch = struct.unpack_from("<IHHHH", header)
+    assert magic == 0x504B4E53 and obs_size == OBS.size
+
+    actions = bytearray([KEEP] * envs * batch)
+    episodes, points = 0, 0
+    start = time.perf_counter()
+    for _ in range(messages):
+        game.stdin.write(actions)
+        game.stdin.flush()
+        data = game.stdout.read(envs * batch * OBS.size)
+        for i, obs in enumerate(OBS.iter_unpack(data)):
+            _tick, hx, hy, direction, flags, fx, fy, _length, reward, _episode = obs
+            points += reward
+            episodes += flags & DONE
+            if i >= (batch - 1) * envs:  # dernier tick du message : décide du suivant
+                actions[i - (batch - 1) * envs] = act(hx, hy, direction, flags, fx, fy)
+    elapsed = time.perf_counter() - start
+    game.stdin.close()
+    game.wait()
+    steps = messages * envs * batch
+    print(f"{steps} pas en {elapsed:.2f} s ({steps / elapsed:.0f} pas/s), "
+          f"{episodes} épisodes, {points / max(episodes, 1):.0f} points par épisode")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""Bot externe branché sur la mémoire partagée du jeu (voir snake_shm.h).
+
+    ./snake --shm snake_bot          # le jeu crée /dev/shm/snake_bot
+    python3 examples/shm_bot.py snake_bot [joueur]
+
+À chaque nouveau tick, le bot lit l'état sur place (seqlock), va vers la
+nourriture la plus proche en évitant les cases occupées et écrit sa
+direction dans son emplacement de commande. Aucune dépendance hors de la
+bibliothèque standard.
+"""
+import mmap
+import struct
+import sys
+import time
+
+MAGIC = 0x314B4E53
+VERSION = 1
+UP, RIGHT, DOWN, LEFT = range(4)
+MOVES = {UP: (0, -1), RIGHT: (1, 0), DOWN: (0, 1), LEFT: (-1, 0)}
+
+# Offsets dans ShmState (snake_shm.h) ; ceux de la région sont lus dans l'en-tête
+STATE_TICK, STATE_WIDTH, STATE_GAME_OVER = 0, 8, 24
+STATE_FOOD_COUNT, STATE_FOODS, STATE_SNAKES, STATE_CELLS = 32, 48, 88, 8120
+FOOD_SIZE, SNAKE_SIZE, SNAKE_BODY = 8, 4016, 16
+CELL_FOOD, CELL_POWERUP = 3, 4
+
+
+def open_region(name):
+    with open("/dev/shm/" + name.lstrip("/"), "r+b") as f:
+        mm = mmap.mmap(f.fileno(), 0)
+    magic, version, size, _players, state, seq, commands, _ = struct.unpack_from("<8I", mm, 0)
+    if magic != MAGIC or version != VERSION or size > len(mm):
+        raise SystemExit("région invalide ou d'une autre version")
+    return mm, state, seq, commands
+
+
+def read_state(mm, state, seq_offset, player):
+    """Copie cohérente de ce dont le bot a besoin (boucle du seqlock)."""
+    while True:
+        seq = struct.unpack_from("<I", mm, seq_offset)[0]
+        if seq & 1:
+            continue
+        tick = struct.unpack_from("<Q", mm, state + STATE_TICK)[0]
+        width, height = struct.unpack_from("<2i", mm, state + STATE_WIDTH)
+        game_over = struct.unpack_from("<i", mm, state + STATE_GAME_OVER)[0]
+        food_count = struct.unpack_from("<i", mm, state + STATE_FOOD_COUNT)[0]
+        foods = [struct.unpack_from("<2h", mm, state + STATE_FOODS + i * FOOD_SIZE)
+                 for i in range(max(0, min(food_count, 5)))]
+        snake = state + STATE_SNAKES + player * SNAKE_SIZE
+        _length, direction = struct.unpack_from("<2I", mm, snake)
+        head = struct.unpack_from("<2h", mm, snake + SNAKE_BODY)
+        cells = mm[state + STATE_CELLS:state + STATE_CELLS + width * height]
+        if struct.unpack_from("<I", mm, seq_offset)[0] == seq:
+            return tick, width, height, game_over, foods, direction, head, cells
+
+
+def choose(width, height, foods, direction, head, cells):
+    target = min(foods, key=lambda f: abs(f[0] - head[0]) + abs(f[1] - head[1]), default=head)
+    best, best_distance = direction, None
+    for move, (dx, dy) in MOVES.items():
+        if move == (direction + 2) % 4:
+            continue
+        x, y = head[0] + dx, head[1] + dy
+        if not (0 <= x < width and 0 <= y < height):
+            continue
+        cell = cells[y * width + x]
+        if cell != 0 and cell not in (CELL_FOOD, CELL_POWERUP):
+            continue
+        distance = abs(target[0] - x) + abs(target[1] - y)
+        if best_distance is None or distance < best_distance:
+            best, best_distance = move, distance
+    return best
+
+
+def main():
+    name = sys.argv[1] if len(sys.argv) > 1 else "snake_bot"
+    player = int(sys.argv[2]) - 1 if len(sys.argv) > 2 else 0
+    mm, state, seq_offset, commands = open_region(name)
+    answered = None
+    while True:
+        tick, width, height, game_over, foods, direction, head, cells = read_state(mm, state, seq_offset, player)
+        if game_over:
+            break
+        if tick == answered:
+            time.sleep(0.0002)
+            continue
+        move = choose(width, height, foods, direction, head, cells)
+        # Un seul mot de 64 bits, aligné : (tick << 8) | (direction + 1)
+        struct.pack_into("<Q", mm, commands + 8 * player, (tick << 8) | (move + 1))
+        answered = tick
+
+
+if __name__ == "__main__":
+    main()
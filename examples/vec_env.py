@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""Environnement vectorisé (snake_vec_env.h) depuis Python via ctypes et numpy.
+
+    make lib && python3 examples/vec_env.py [envs] [steps]
+
+Les tableaux numpy sont passés tels quels à vec_env_step : le noyau écrit
+observations, récompenses et fins directement dans leur mémoire, sans copie
+ni allocation à chaque pas. Le bot est aléatoire ; le script affiche le débit.
+"""
+import ctypes
+import os
+import sys
+import time
+
+import numpy as np
+
+KEEP, DONE, TRUNCATED = 4, 0x01, 0x02
+CELLS = ["vide", "mur", "portail", "nourriture", "power-up", "corps", "tête"]
+MODES = {"classic": 0, "arcade": 1, "challenge": 2, "free": 3}
+
+lib = ctypes.CDLL(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "libsnake.so"))
+u8p, f32p = ctypes.POINTER(ctypes.c_uint8), ctypes.POINTER(ctypes.c_float)
+lib.vec_env_create.restype = ctypes.c_void_p
+lib.vec_env_create.argtypes = [ctypes.c_int, ctypes.c_int, ctypes.c_int, ctypes.c_ulong]
+lib.vec_env_destroy.argtypes = [ctypes.c_void_p]
+lib.vec_env_shape.argtypes = [ctypes.c_void_p] + [ctypes.POINTER(ctypes.c_int)] * 3
+lib.vec_env_reset.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_uint), u8p]
+lib.vec_env_step.argtypes = [ctypes.c_void_p, u8p, u8p, f32p, u8p]
+
+
+class VecEnv:
+    def __init__(self, num_envs, mode="classic", difficulty=1, max_steps=1000):
+        self.handle = lib.vec_env_create(num_envs, MODES[mode], difficulty, max_steps)
+        if not self.handle:
+            raise MemoryError("vec_env_create")
+        n, h, w = ctypes.c_int(), ctypes.c_int(), ctypes.c_int()
+        lib.vec_env_shape(self.handle, n, h, w)
+        # Tampons alloués une fois ; step() renvoie des vues sur ces tableaux
+        self.obs = np.zeros((n.value, h.value, w.value), dtype=np.uint8)
+        self.rewards = np.zeros(n.value, dtype=np.float32)
+        self.dones = np.zeros(n.value, dtype=np.uint8)
+        self._obs_p = self.obs.ctypes.data_as(u8p)
+        self._rewards_p = self.rewards.ctypes.data_as(f32p)
+        self._dones_p = self.dones.ctypes.data_as(u8p)
+
+    def reset(self, seeds=None):
+        if seeds is not None:
+            seeds = np.ascontiguousarray(seeds, dtype=np.uint32)
+            lib.vec_env_reset(self.handle, seeds.ctypes.data_as(ctypes.POINTER(ctypes.c_uint)), self._obs_p)
+        else:
+            lib.vec_env_reset(self.handle, None, self._obs_p)
+        return self.obs
+
+    def step(self, actions):
+        # actions : tableau uint8 contigu de taille N (0-3 direction, 4 garder)
+        lib.vec_env_step(self.handle, actions.ctypes.data_as(u8p), self._obs_p, self._rewards_p, self._dones_p)
+        return self.obs, self.rewards, self.dones
+
+    def close(self):
+        if self.handle:
+            lib.vec_env_destroy(self.handle)
+            self.handle = None
+
+
+def main():
+    envs = int(sys.argv[1]) if len(sys.argv) > 1 else 64
+    steps = int(sys.argv[2]) if len(sys.argv) > 2 else 2000
+    env = VecEnv(envs)
+    obs = env.reset(np.arange(envs) + 1)
+    print(f"observations {obs.shape} {obs.dtype}, cases de l'environnement 0 :",
+          {CELLS[c]: int((obs[0] == c).sum()) for c in np.unique(obs[0])})
+
+    rng = np.random.default_rng(0)
+    actions = np.empty(envs, dtype=np.uint8)
+    episodes, points = 0, 0.0
+    start = time.perf_counter()
+    for _ in range(steps):
+        actions[:] = rng.integers(0, 8, envs)  # la moitié du temps : garder la direction
+        obs, rewards, dones = env.step(actions)
+        points += float(rewards.sum())
+        episodes += int(np.count_nonzero(dones & DONE))
+    elapsed = time.perf_counter() - start
+    env.close()
+    total = steps * envs
+    print(f"{total} pas en {elapsed:.2f} s ({total / elapsed:.0f} pas/s), "
+          f"{episodes} épisodes, {points / max(episodes, 1):.1f} points par épisode")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,422 @@
+#define _DEFAULT_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include "snake_arena.h"
+
+// ===== OUTILS =====
+
+static Position step_position(Position pos, Direction dir) {
+    switch (dir) {
+        case UP: pos.y--; break;
+        case RIGHT: pos.x++; break;
+        case DOWN: pos.y++; break;
+        case LEFT: pos.x--; break;
+    }
+    return pos;
+}
+
+Position arena_segment(const ArenaSnake *snake, int i) {
+    return snake->body[(snake->head + i) % snake->capacity];
+}
+
+static int random_empty_cell(Arena *arena, Position *out) {
+    for (int attempt = 0; attempt < ARENA_SPAWN_ATTEMPTS; attempt++) {
+        Position pos;
+        pos.x = snake_rand(&arena->rng) % arena->width;
+        pos.y = snake_rand(&arena->rng) % arena->height;
+        if (arena->cells[arena_index(arena, pos)] == ARENA_CELL_EMPTY) {
+            *out = pos;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// ===== NOURRITURE =====
+
+static void place_food(Arena *arena, int i) {
+    Position pos;
+    if (random_empty_cell(arena, &pos)) {
+        arena->foods[i] = pos;
+        arena->cells[arena_index(arena, pos)] = -(i + 1);
+    } else {
+        arena->foods[i].x = -1;
+        arena->food_missing++;
+    }
+}
+
+static void place_missing_food(Arena *arena) {
+    int missing = arena->food_missing;
+    arena->food_missing = 0;
+    for (int i = 0; i < arena->food_count && missing > 0; i++) {
+        if (arena->foods[i].x < 0) {
+            missing--;
+            place_food(arena, i);
+        }
+    }
+}
+
+// ===== SERPENTS =====
+
+static void spawn_snake(Arena *arena, int id) {
+    ArenaSnake *snake = &arena->snakes[id];
+    Position pos;
+    if (!random_empty_cell(arena, &pos)) {
+        snake->respawn_timer = 1;  // grille saturée : on réessaie au tick suivant
+        return;
+    }
+    snake->head = 0;
+    snake->body[0] = pos;
+    snake->length = 1;
+    snake->grow = ARENA_START_LENGTH - 1;
+    snake->direction = (Direction)(snake_rand(&snake->rng) % 4);
+    snake->requested = snake->direction;
+    snake->alive = 1;
+    snake->respawn_timer = 0;
+    arena->cells[arena_index(arena, pos)] = id + 1;
+    arena->alive_count++;
+}
+
+static void kill_snake(Arena *arena, int id) {
+    ArenaSnake *snake = &arena->snakes[id];
+    for (int i = 0; i < snake->length; i++) {
+        int idx = arena_index(arena, arena_segment(snake, i));
+        if (arena->cells[idx] == id + 1) arena->cells[idx] = ARENA_CELL_EMPTY;
+    }
+    snake->alive = 0;
+    snake->respawn_timer = ARENA_RESPAWN_TICKS;
+    arena->alive_count--;
+    arena->deaths++;
+}
+
+// Nombre de cases libres atteignables depuis `start`, plafonné à `limit`.
+// Parcours en largeur avec un petit ensemble haché sur la pile : la grille
+// partagée n'est que lue, ce qui permet de l'appeler depuis plusieurs threads.
+#define ARENA_VISITED_SLOTS (4 * ARENA_MAX_LOOKAHEAD)
+
+static int visit(int *slots, int key) {
+    unsigned int h = ((unsigned int)key * 2654435761u) & (ARENA_VISITED_SLOTS - 1);
+    while (slots[h] != -1) {
+        if (slots[h] == key) return 0;
+        h = (h + 1) & (ARENA_VISITED_SLOTS - 1);
+    }
+    slots[h] = key;
+    return 1;
+}
+
+// limit est borné à ARENA_MAX_LOOKAHEAD (taille de la file et de la table)
+static int bounded_free_area(const Arena *arena, Position start, int limit) {
+    if (limit > ARENA_MAX_LOOKAHEAD) limit = ARENA_MAX_LOOKAHEAD;
+    int slots[ARENA_VISITED_SLOTS];
+    Position queue[ARENA_MAX_LOOKAHEAD];
+    memset(slots, 0xff, sizeof(slots));
+    int head = 0, tail = 0;
+    visit(slots, arena_index(arena, start));
+    queue[tail++] = start;
+    while (head < tail && tail < limit) {
+        Position p = queue[head++];
+        for (int d = 0; d < 4 && tail < limit; d++) {
+            Position n = step_position(p, (Direction)d);
+            if (!arena_in_bounds(arena, n)) continue;
+            int idx = arena_index(arena, n);
+            if (arena->cells[idx] > 0 || !visit(slots, idx)) continue;
+            queue[tail++] = n;
+        }
+    }
+    return tail;
+}
+
+// IA gloutonne : parmi tout droit / gauche / droite, la case libre la plus
+// proche de la nourriture visée (une par serpent), égalités tirées au sort.
+// Avec `lookahead`, les candidats qui mènent à une poche trop petite sont pénalisés.
+static Direction choose_direction(const Arena *arena, ArenaSnake *snake, int id) {
+    Position head = arena_segment(snake, 0);
+    Position target = arena->foods[id % arena->food_count];
+    Direction candidates[3] = {
+        snake->direction,
+        (Direction)((snake->direction + 3) % 4),
+        (Direction)((snake->direction + 1) % 4)
+    };
+    if (snake_rand(&snake->rng) & 1) {
+        Direction tmp = candidates[1];
+        candidates[1] = candidates[2];
+        candidates[2] = tmp;
+    }
+
+    Direction best = snake->direction;
+    int best_score = -1;
+    int lookahead = arena->lookahead < ARENA_MAX_LOOKAHEAD ? arena->lookahead : ARENA_MAX_LOOKAHEAD;
+    for (int i = 0; i < 3; i++) {
+        Position next = step_position(head, candidates[i]);
+        if (!arena_in_bounds(arena, next)) continue;
+        if (arena->cells[arena_index(arena, next)] > 0) continue;
+        int score = 0;
+        if (target.x >= 0) score = abs(target.x - next.x) + abs(target.y - next.y);
+        if (lookahead > 0) {
+            int area = bounded_free_area(arena, next, lookahead);
+            score += (lookahead - area) * 1000;
+        }
+        if (best_score < 0 || score < best_score) {
+            best = candidates[i];
+            best_score = score;
+        }
+    }
+    return best;
+}
+
+// ===== PHASE D'INTENTION =====
+
+static void compute_intents(Arena *arena, int worker) {
+    int begin = (int)((long)arena->snake_count * worker / arena->thread_count);
+    int end = (int)((long)arena->snake_count * (worker + 1) / arena->thread_count);
+    for (int id = begin; id < end; id++) {
+        ArenaSnake *snake = &arena->snakes[id];
+        if (!snake->alive) continue;
+        if (!snake->controlled) {
+            snake->direction = choose_direction(arena, snake, id);
+        } else if (snake->requested != (snake->direction + 2) % 4) {
+            snake->direction = snake->requested;
+        }
+        snake->intent = step_position(arena_segment(snake, 0), snake->direction);
+    }
+}
+
+// Les threads attendent une nouvelle génération, calculent leur tranche
+// d'intentions puis décrémentent `pending` ; le thread appelant traite la tranche 0.
+static void *worker_main(void *data) {
+    ArenaWorker *worker = data;
+    Arena *arena = worker->arena;
+    unsigned long seen = 0;
+    for (;;) {
+        pthread_mutex_lock(&arena->pool_lock);
+        while (arena->generation == seen && !arena->stopping) {
+            pthread_cond_wait(&arena->start_cond, &arena->pool_lock);
+        }
+        seen = arena->generation;
+        int stopping = arena->stopping;
+        pthread_mutex_unlock(&arena->pool_lock);
+        if (stopping) break;
+
+        compute_intents(arena, worker->index);
+
+        pthread_mutex_lock(&arena->pool_lock);
+        if (--arena->pending == 0) pthread_cond_signal(&arena->done_cond);
+        pthread_mutex_unlock(&arena->pool_lock);
+    }
+    return NULL;
+}
+
+static void run_intent_phase(Arena *arena) {
+    if (arena->thread_count <= 1) {
+        compute_intents(arena, 0);
+        return;
+    }
+    pthread_mutex_lock(&arena->pool_lock);
+    arena->pending = arena->thread_count - 1;
+    arena->generation++;
+    pthread_cond_broadcast(&arena->start_cond);
+    pthread_mutex_unlock(&arena->pool_lock);
+
+    compute_intents(arena, 0);
+
+    pthread_mutex_lock(&arena->pool_lock);
+    while (arena->pending > 0) {
+        pthread_cond_wait(&arena->done_cond, &arena->pool_lock);
+    }
+    pthread_mutex_unlock(&arena->pool_lock);
+}
+
+static void stop_workers(Arena *arena) {
+    if (!arena->workers) return;
+    pthread_mutex_lock(&arena->pool_lock);
+    arena->stopping = 1;
+    pthread_cond_broadcast(&arena->start_cond);
+    pthread_mutex_unlock(&arena->pool_lock);
+    for (int i = 1; i < arena->thread_count; i++) {
+        pthread_join(arena->workers[i].thread, NULL);
+    }
+    pthread_mutex_destroy(&arena->pool_lock);
+    pthread_cond_destroy(&arena->start_cond);
+    pthread_cond_destroy(&arena->done_cond);
+    free(arena->workers);
+    arena->workers = NULL;
+    arena->stopping = 0;
+    arena->thread_count = 1;
+}
+
+int arena_set_threads(Arena *arena, int thread_count) {
+    if (thread_count < 1 || thread_count > ARENA_MAX_THREADS) return 0;
+    stop_workers(arena);
+    if (thread_count == 1) return 1;
+
+    arena->workers = calloc(thread_count, sizeof(ArenaWorker));
+    if (!arena->workers) return 0;
+    pthread_mutex_init(&arena->pool_lock, NULL);
+    pthread_cond_init(&arena->start_cond, NULL);
+    pthread_cond_init(&arena->done_cond, NULL);
+    arena->generation = 0;
+    arena->thread_count = thread_count;
+    for (int i = 1; i < thread_count; i++) {
+        arena->workers[i].arena = arena;
+        arena->workers[i].index = i;
+        if (pthread_create(&arena->workers[i].thread, NULL, worker_main, &arena->workers[i]) != 0) {
+            arena->thread_count = i;  // seuls les threads 1..i-1 existent
+            stop_workers(arena);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// ===== CYCLE DE VIE =====
+
+int arena_init(Arena *arena, int width, int height, int snake_count,
+               int max_length, int food_count, unsigned int seed) {
+    memset(arena, 0, sizeof(*arena));
+    if (width <= 0 || height <= 0 || snake_count <= 0 || food_count <= 0 ||
+        max_length < ARENA_START_LENGTH)
+        return 0;
+
+    arena->width = width;
+    arena->height = height;
+    arena->snake_count = snake_count;
+    arena->food_count = food_count;
+    arena->rng = seed ? seed : 1;
+    arena->thread_count = 1;
+
+    arena->cells = calloc((size_t)width * height, sizeof(int));
+    arena->claims = calloc((size_t)width * height, sizeof(int));
+    arena->snakes = calloc(snake_count, sizeof(ArenaSnake));
+    arena->foods = calloc(food_count, sizeof(Position));
+    Position *bodies = malloc((size_t)snake_count * max_length * sizeof(Position));
+    if (!arena->cells || !arena->claims || !arena->snakes || !arena->foods || !bodies) {
+        free(bodies);
+        arena_free(arena);
+        return 0;
+    }
+
+    for (int id = 0; id < snake_count; id++) {
+        ArenaSnake *snake = &arena->snakes[id];
+        snake->body = bodies + (size_t)id * max_length;
+        snake->capacity = max_length;
+        snake->rng = (arena->rng ^ ((unsigned int)id * 0x9E3779B9u)) + 1;
+        spawn_snake(arena, id);
+    }
+    for (int i = 0; i < food_count; i++) {
+        place_food(arena, i);
+    }
+    return 1;
+}
+
+void arena_free(Arena *arena) {
+    stop_workers(arena);
+    if (arena->snakes) free(arena->snakes[0].body);
+    free(arena->snakes);
+    free(arena->cells);
+    free(arena->claims);
+    free(arena->foods);
+    memset(arena, 0, sizeof(*arena));
+}
+
+// ===== TICK =====
+
+static int is_growing(const ArenaSnake *snake) {
+    return snake->grow > 0 && snake->length < snake->capacity;
+}
+
+// Résolution déterministe, dans l'ordre des identifiants :
+//  1. les queues qui avancent libèrent leur case (on peut y entrer ce tick) ;
+//  2. une case visée par plusieurs têtes tue tous les prétendants (face à face,
+//     deux têtes sur la même nourriture) ;
+//  3. une tête qui entre dans un corps (ou sort de la grille) meurt ;
+//  4. les survivants avancent, puis la nourriture mangée est replacée.
+static void resolve_intents(Arena *arena) {
+    int n = arena->snake_count;
+
+    for (int id = 0; id < n; id++) {
+        ArenaSnake *snake = &arena->snakes[id];
+        if (!snake->alive) continue;
+        snake->dying = 0;
+        if (!is_growing(snake)) {
+            Position tail = arena_segment(snake, snake->length - 1);
+            arena->cells[arena_index(arena, tail)] = ARENA_CELL_EMPTY;
+        }
+        if (arena_in_bounds(arena, snake->intent)) {
+            arena->claims[arena_index(arena, snake->intent)]++;
+        } else {
+            snake->dying = 1;
+        }
+    }
+
+    for (int id = 0; id < n; id++) {
+        ArenaSnake *snake = &arena->snakes[id];
+        if (!snake->alive || snake->dying) continue;
+        int idx = arena_index(arena, snake->intent);
+        if (arena->claims[idx] > 1) {
+            snake->dying = 1;
+            arena->head_on++;
+        } else if (arena->cells[idx] > 0) {
+            snake->dying = 1;
+        }
+    }
+
+    for (int id = 0; id < n; id++) {
+        ArenaSnake *snake = &arena->snakes[id];
+        if (!snake->alive) continue;
+        if (arena_in_bounds(arena, snake->intent)) {
+            arena->claims[arena_index(arena, snake->intent)] = 0;
+        }
+        if (snake->dying) kill_snake(arena, id);
+    }
+
+    for (int id = 0; id < n; id++) {
+        ArenaSnake *snake = &arena->snakes[id];
+        if (!snake->alive) continue;
+        int idx = arena_index(arena, snake->intent);
+        int cell = arena->cells[idx];
+        int growing = is_growing(snake);
+        snake->head = (snake->head + snake->capacity - 1) % snake->capacity;
+        snake->body[snake->head] = snake->intent;
+        arena->cells[idx] = id + 1;
+        if (growing) {
+            snake->length++;
+            snake->grow--;
+        }
+        if (ARENA_CELL_IS_FOOD(cell)) {
+            snake->grow++;
+            snake->score++;
+            arena->food_eaten++;
+            arena->foods[-cell - 1].x = -1;
+            arena->food_missing++;
+        }
+    }
+}
+
+void arena_tick(Arena *arena) {
+    run_intent_phase(arena);
+    resolve_intents(arena);
+    if (arena->food_missing > 0) place_missing_food(arena);
+
+    for (int id = 0; id < arena->snake_count; id++) {
+        ArenaSnake *snake = &arena->snakes[id];
+        if (!snake->alive && --snake->respawn_timer <= 0) spawn_snake(arena, id);
+    }
+    arena->tick++;
+}
+
+// Empreinte FNV-1a de l'état : grille, puis tête, longueur et score de chaque serpent.
+unsigned long arena_hash(const Arena *arena) {
+    unsigned long long h = 1469598103934665603ULL;
+    size_t cells = (size_t)arena->width * arena->height;
+    for (size_t i = 0; i < cells; i++) {
+        h = (h ^ (unsigned int)arena->cells[i]) * 1099511628211ULL;
+    }
+    for (int id = 0; id < arena->snake_count; id++) {
+        const ArenaSnake *snake = &arena->snakes[id];
+        Position head = snake->alive ? arena_segment(snake, 0) : (Position){-1, -1};
+        h = (h ^ (unsigned int)(head.y * arena->width + head.x)) * 1099511628211ULL;
+        h = (h ^ (unsigned int)snake->length) * 1099511628211ULL;
+        h = (h ^ (unsigned int)snake->score) * 1099511628211ULL;
+    }
+    return (unsigned long)h;
+}
@@ -0,0 +1,103 @@
+#ifndef SNAKE_ARENA_H
+#define SNAKE_ARENA_H
+
+#include <pthread.h>
+#include "snake_core.h"
+
+// Mode arène : N serpents pilotés par l'IA sur une grande grille.
+// Les collisions passent par une grille d'occupation partagée (une case =
+// un propriétaire) : un tick coûte O(N) au lieu de O(N x longueur totale).
+//
+// Un tick se fait en deux phases : chaque serpent calcule sa tête voulue à
+// partir de la grille du tick précédent (en parallèle sur les threads), puis
+// les conflits sont résolus dans l'ordre des identifiants. Tous les serpents
+// bougent simultanément et le résultat ne dépend pas du nombre de threads.
+
+// ===== CONSTANTES =====
+#define ARENA_CELL_EMPTY 0
+// Cases > 0 : identifiant du serpent + 1 ; cases < 0 : nourriture i
+// stockée comme -(i + 1)
+#define ARENA_CELL_IS_FOOD(c) ((c) < 0)
+#define ARENA_START_LENGTH 3
+#define ARENA_RESPAWN_TICKS 20
+#define ARENA_SPAWN_ATTEMPTS 32
+#define ARENA_MAX_LOOKAHEAD 128    // cases explorées par l'IA pour éviter les impasses
+#define ARENA_MAX_THREADS 64
+
+// ===== STRUCTURES =====
+typedef struct {
+    Position *body;      // anneau de `capacity` positions, la tête est à body[head]
+    int head;
+    int length;
+    int capacity;
+    int grow;            // segments restant à ajouter
+    Direction direction;
+    int alive;
+    int respawn_timer;
+    int score;
+    unsigned int rng;
+    int controlled;      // piloté de l'extérieur (joueur réseau) au lieu de l'IA
+    Direction requested; // direction demandée par le joueur, ignorée si demi-tour
+
+    // Phase d'intention
+    Position intent;
+    int dying;
+} ArenaSnake;
+
+typedef struct Arena Arena;
+
+typedef struct {
+    Arena *arena;
+    int index;
+    pthread_t thread;
+} ArenaWorker;
+
+struct Arena {
+    int width;
+    int height;
+    int *cells;          // occupation partagée, width * height cases
+    int *claims;         // têtes voulues par case pendant la résolution
+    ArenaSnake *snakes;
+    int snake_count;
+    int alive_count;
+    Position *foods;     // x = -1 : nourriture en attente de placement
+    int food_count;
+    int food_missing;
+    unsigned int rng;
+    unsigned long tick;
+    int lookahead;       // 0 : IA gloutonne, sinon remplissage borné par candidat (au plus ARENA_MAX_LOOKAHEAD)
+
+    // Threads de la phase d'intention (le thread appelant est le numéro 0)
+    int thread_count;
+    ArenaWorker *workers;
+    pthread_mutex_t pool_lock;
+    pthread_cond_t start_cond;
+    pthread_cond_t done_cond;
+    unsigned long generation;
+    int pending;
+    int stopping;
+
+    // Statistiques
+    unsigned long deaths;
+    unsigned long head_on;
+    unsigned long food_eaten;
+};
+
+// ===== PROTOTYPES =====
+int arena_init(Arena *arena, int width, int height, int snake_count,
+               int max_length, int food_count, unsigned int seed);
+void arena_free(Arena *arena);
+int arena_set_threads(Arena *arena, int thread_count);
+void arena_tick(Arena *arena);
+Position arena_segment(const ArenaSnake *snake, int i);
+unsigned long arena_hash(const Arena *arena);
+
+static inline int arena_index(const Arena *arena, Position pos) {
+    return pos.y * arena->width + pos.x;
+}
+
+static inline int arena_in_bounds(const Arena *arena, Position pos) {
+    return pos.x >= 0 && pos.x < arena->width && pos.y >= 0 && pos.y < arena->height;
+}
+
+#endif
@@ -0,0 +1,309 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "snake_bitboard.h"
+
+// ===== LIGNES =====
+
+// Compte des bits sans dépendre de -mpopcnt (sinon popcount64
+// appelle une fonction de libgcc, plusieurs fois plus lente).
+static inline int popcount64(uint64_t x) {
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x * 0x0101010101010101ULL) >> 56);
+}
+
+static inline BitRow row_or(BitRow a, BitRow b) {
+    return (BitRow){{a.w[0] | b.w[0], a.w[1] | b.w[1]}};
+}
+
+static inline BitRow row_and(BitRow a, BitRow b) {
+    return (BitRow){{a.w[0] & b.w[0], a.w[1] & b.w[1]}};
+}
+
+static inline int row_equal(BitRow a, BitRow b) {
+    return a.w[0] == b.w[0] && a.w[1] == b.w[1];
+}
+
+static inline int row_empty(BitRow a) {
+    return (a.w[0] | a.w[1]) == 0;
+}
+
+// Décalage vers les x croissants (bit x -> bit x + n), 1 <= n <= 64
+static inline BitRow row_shl(BitRow r, int n) {
+    if (n == 64) return (BitRow){{0, r.w[0]}};
+    return (BitRow){{r.w[0] << n, (r.w[1] << n) | (r.w[0] >> (64 - n))}};
+}
+
+// Décalage vers les x décroissants (bit x -> bit x - n), 1 <= n <= 64
+static inline BitRow row_shr(BitRow r, int n) {
+    if (n == 64) return (BitRow){{r.w[1], 0}};
+    return (BitRow){{(r.w[0] >> n) | (r.w[1] << (64 - n)), r.w[1] >> n}};
+}
+
+// Étend chaque bit de `seeds` vers les x croissants jusqu'au bout de sa suite
+// de bits dans `pass` (seeds inclus dans pass). L'addition propage une
+// retenue à travers la suite ; les bits qu'elle a basculés sont la suite.
+static inline BitRow fill_high(BitRow seeds, BitRow pass) {
+    uint64_t lo = pass.w[0] + seeds.w[0];
+    uint64_t carry = lo < pass.w[0];
+    uint64_t hi = pass.w[1] + seeds.w[1] + carry;
+    return (BitRow){{((lo ^ pass.w[0]) | seeds.w[0]) & pass.w[0],
+                     ((hi ^ pass.w[1]) | seeds.w[1]) & pass.w[1]}};
+}
+
+// Même chose vers les x décroissants : remplissage de Kogge-Stone, des
+// décalages de 1, 2, 4... 64 cases à travers les cases de `pass`.
+static inline BitRow fill_low(BitRow seeds, BitRow pass) {
+    for (int n = 1; n <= 64; n *= 2) {
+        seeds = row_or(seeds, row_and(pass, row_shr(seeds, n)));
+        pass = row_and(pass, row_shr(pass, n));
+    }
+    return seeds;
+}
+
+// ===== PLATEAUX =====
+
+int bitboard_fits(int width, int height) {
+    return width > 0 && width <= BITBOARD_MAX_WIDTH && height > 0 && height <= BITBOARD_MAX_HEIGHT;
+}
+
+int bitboard_init(Bitboard *bb, int width, int height) {
+    if (!bitboard_fits(width, height)) return 0;
+    bb->width = width;
+    bb->height = height;
+    bb->mask.w[0] = width >= 64 ? ~0ULL : (1ULL << width) - 1;
+    bb->mask.w[1] = width <= 64 ? 0 : width == 128 ? ~0ULL : (1ULL << (width - 64)) - 1;
+    bitboard_clear(bb);
+    return 1;
+}
+
+void bitboard_clear(Bitboard *bb) {
+    memset(bb->rows, 0, bb->height * sizeof(BitRow));
+}
+
+void bitboard_fill(Bitboard *bb) {
+    for (int y = 0; y < bb->height; y++) bb->rows[y] = bb->mask;
+}
+
+static inline void copy_shape(Bitboard *dst, const Bitboard *src) {
+    dst->width = src->width;
+    dst->height = src->height;
+    dst->mask = src->mask;
+}
+
+// Les trois opérandes ont la même taille ; dst peut être a ou b.
+void bitboard_and(Bitboard *dst, const Bitboard *a, const Bitboard *b) {
+    copy_shape(dst, a);
+    for (int y = 0; y < a->height; y++) dst->rows[y] = row_and(a->rows[y], b->rows[y]);
+}
+
+void bitboard_or(Bitboard *dst, const Bitboard *a, const Bitboard *b) {
+    copy_shape(dst, a);
+    for (int y = 0; y < a->height; y++) dst->rows[y] = row_or(a->rows[y], b->rows[y]);
+}
+
+void bitboard_andnot(Bitboard *dst, const Bitboard *a, const Bitboard *b) {
+    copy_shape(dst, a);
+    for (int y = 0; y < a->height; y++) {
+        dst->rows[y] = (BitRow){{a->rows[y].w[0] & ~b->rows[y].w[0], a->rows[y].w[1] & ~b->rows[y].w[1]}};
+    }
+}
+
+long bitboard_count(const Bitboard *bb) {
+    long count = 0;
+    for (int y = 0; y < bb->height; y++) {
+        count += popcount64(bb->rows[y].w[0]) + popcount64(bb->rows[y].w[1]);
+    }
+    return count;
+}
+
+// n-ième case occupée (à partir de 0), dans l'ordre des lignes. Retourne 0
+// s'il y en a moins de n + 1.
+int bitboard_nth(const Bitboard *bb, long n, Position *pos) {
+    for (int y = 0; y < bb->height; y++) {
+        for (int k = 0; k < 2; k++) {
+            uint64_t word = bb->rows[y].w[k];
+            int bits = popcount64(word);
+            if (n >= bits) {
+                n -= bits;
+                continue;
+            }
+            while (n-- > 0) word &= word - 1;
+            pos->x = k * 64 + __builtin_ctzll(word);
+            pos->y = y;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int bitboard_first(const Bitboard *bb, Position *pos) {
+    return bitboard_nth(bb, 0, pos);
+}
+
+// Cases voisines (4-connexité) des cases de src, src exclu sauf si une case
+// de src est voisine d'une autre.
+void bitboard_neighbors(Bitboard *dst, const Bitboard *src) {
+    Bitboard out = *src;
+    for (int y = 0; y < src->height; y++) {
+        BitRow row = row_or(row_shl(src->rows[y], 1), row_shr(src->rows[y], 1));
+        if (y > 0) row = row_or(row, src->rows[y - 1]);
+        if (y + 1 < src->height) row = row_or(row, src->rows[y + 1]);
+        out.rows[y] = row_and(row, src->mask);
+    }
+    *dst = out;
+}
+
+// Cases de `passable` reliées (4-connexité, sans sortir de passable) à une
+// case de `seeds`. Chaque ligne reçoit ses voisines du dessus et du dessous
+// puis est remplie d'un coup le long de ses suites de cases ; on balaie vers
+// le bas puis vers le haut, en ne reprenant que les lignes dont une voisine
+// a changé, jusqu'à ce que plus rien ne bouge. Retourne le nombre de cases
+// atteintes. dst peut être seeds.
+long bitboard_flood(Bitboard *dst, const Bitboard *seeds, const Bitboard *passable) {
+    int height = passable->height;
+    unsigned char dirty[BITBOARD_MAX_HEIGHT];
+    bitboard_and(dst, seeds, passable);
+    for (int y = 0; y < height; y++) {
+        dirty[y] = !row_empty(dst->rows[y]) || (y > 0 && !row_empty(dst->rows[y - 1])) ||
+                   (y + 1 < height && !row_empty(dst->rows[y + 1]));
+    }
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (int pass = 0; pass < 2; pass++) {
+            for (int i = 0; i < height; i++) {
+                int y = pass == 0 ? i : height - 1 - i;
+                if (!dirty[y]) continue;
+                dirty[y] = 0;
+                BitRow row = dst->rows[y];
+                if (y > 0) row = row_or(row, dst->rows[y - 1]);
+                if (y + 1 < height) row = row_or(row, dst->rows[y + 1]);
+                row = row_and(row, passable->rows[y]);
+                if (row_empty(row)) continue;
+                row = row_or(fill_high(row, passable->rows[y]), fill_low(row, passable->rows[y]));
+                if (!row_equal(row, dst->rows[y])) {
+                    dst->rows[y] = row;
+                    if (y > 0) dirty[y - 1] = 1;
+                    if (y + 1 < height) dirty[y + 1] = 1;
+                    changed = 1;
+                }
+            }
+        }
+    }
+    return bitboard_count(dst);
+}
+
+// Composantes 4-connexes des cases de `cells` ; `largest` (facultatif)
+// reçoit la taille de la plus grande.
+int bitboard_components(const Bitboard *cells, long *largest) {
+    Bitboard remaining = *cells, component;
+    int components = 0;
+    long best = 0;
+    Position pos;
+    while (bitboard_first(&remaining, &pos)) {
+        bitboard_init(&component, cells->width, cells->height);
+        bitboard_set(&component, pos);
+        long size = bitboard_flood(&component, &component, &remaining);
+        bitboard_andnot(&remaining, &remaining, &component);
+        components++;
+        if (size > best) best = size;
+    }
+    if (largest) *largest = best;
+    return components;
+}
+
+// ===== COUCHES D'UNE PARTIE =====
+
+// walls et portals peuvent être NULL.
+int bitboard_from_map(Bitboard *walls, Bitboard *portals, const TileMap *map) {
+    Bitboard ignored;
+    if (!walls) walls = &ignored;
+    if (!portals) portals = &ignored;
+    if (!bitboard_init(walls, map->width, map->height) || !bitboard_init(portals, map->width, map->height)) return 0;
+    if (!map->tiles || (map->wall_count == 0 && map->portal_count == 0)) return 1;
+    for (int y = 0; y < map->height; y++) {
+        const Tile *row = map->tiles + (long)y * map->width;
+        for (int x = 0; x < map->width; x++) {
+            if (row[x] == TILE_WALL) walls->rows[y].w[x >> 6] |= 1ULL << (x & 63);
+            else if (row[x] != TILE_EMPTY) portals->rows[y].w[x >> 6] |= 1ULL << (x & 63);
+        }
+    }
+    return 1;
+}
+
+void bitboard_add_snake(Bitboard *bb, const Snake *snake) {
+    for (int i = 0; i < snake->length; i++) {
+        Position p = snake->body[i];
+        if (p.x >= 0 && p.x < bb->width && p.y >= 0 && p.y < bb->height) bitboard_set(bb, p);
+    }
+}
+
+// Murs et portails de la carte, recalculés seulement quand elle change
+// (TileMap.version). Un cache par thread : les parties de plusieurs threads
+// ne se gênent pas.
+static _Thread_local struct {
+    const Tile *tiles;
+    unsigned int version;
+    Bitboard walls;
+    Bitboard blocked;
+} map_cache;
+
+static const Bitboard *cached_layers(const TileMap *map, const Bitboard **walls) {
+    if (map_cache.tiles != map->tiles || map_cache.version != map->version ||
+        map_cache.blocked.width != map->width || map_cache.blocked.height != map->height) {
+        Bitboard portals;
+        if (!bitboard_from_map(&map_cache.walls, &portals, map)) return NULL;
+        bitboard_or(&map_cache.blocked, &map_cache.walls, &portals);
+        map_cache.tiles = map->tiles;
+        map_cache.version = map->version;
+    }
+    if (walls) *walls = &map_cache.walls;
+    return &map_cache.blocked;
+}
+
+// Cases où peut apparaître un objet : ni mur, ni portail, ni serpent, ni
+// nourriture (comme is_position_valid avec check_snake). Retourne 0 si la
+// grille ne tient pas dans un bitboard.
+int bitboard_game_free(const Game *game, Bitboard *free_cells) {
+    const Bitboard *blocked = cached_layers(&game->map, NULL);
+    if (!blocked) return 0;
+    Bitboard occupied = *blocked;
+    bitboard_add_snake(&occupied, &game->snake1);
+    if (game->multiplayer) bitboard_add_snake(&occupied, &game->snake2);
+    for (int i = 0; i < game->food_count; i++) {
+        Position p = game->foods[i].pos;
+        if (p.x >= 0 && p.x < occupied.width && p.y >= 0 && p.y < occupied.height) bitboard_set(&occupied, p);
+    }
+    bitboard_init(free_cells, game->grid_width, game->grid_height);
+    bitboard_fill(free_cells);
+    bitboard_andnot(free_cells, free_cells, &occupied);
+    return 1;
+}
+
+// Cases où une tête peut entrer sans mourir : ni mur ni serpent (les
+// portails et la nourriture se traversent).
+int bitboard_game_passable(const Game *game, Bitboard *passable) {
+    const Bitboard *walls;
+    if (!cached_layers(&game->map, &walls)) return 0;
+    Bitboard occupied = *walls;
+    bitboard_add_snake(&occupied, &game->snake1);
+    if (game->multiplayer) bitboard_add_snake(&occupied, &game->snake2);
+    bitboard_init(passable, game->grid_width, game->grid_height);
+    bitboard_fill(passable);
+    bitboard_andnot(passable, passable, &occupied);
+    return 1;
+}
+
+// Taille de la région de `passable` atteignable depuis start (0 si start
+// n'en fait pas partie) : test de sécurité des bots avant un virage.
+long bitboard_game_area(const Game *game, const Bitboard *passable, Position start) {
+    if (!bitboard_get(passable, start)) return 0;
+    Bitboard region;
+    bitboard_init(&region, game->grid_width, game->grid_height);
+    bitboard_set(&region, start);
+    return bitboard_flood(&region, &region, passable);
+}
@@ -0,0 +1,68 @@
+#ifndef SNAKE_BITBOARD_H
+#define SNAKE_BITBOARD_H
+
+#include <stdint.h>
+#include "snake_core.h"
+
+// Représentation bitboard d'une couche de la grille : une ligne = deux mots
+// de 64 bits (jusqu'à 128 colonnes, donc les quatre grilles du jeu), bit x de
+// la ligne y = case (x, y). Les opérations travaillent un mot à la fois :
+// cases libres (and / andnot), voisines d'une case (décalages), région
+// atteignable (remplissage par décalages et masques, ligne par ligne).
+//
+// Les grilles trop grandes (bitboard_fits) gardent leurs boucles par case ;
+// les appelants du noyau retombent dessus d'eux-mêmes.
+
+// ===== CONSTANTES =====
+#define BITBOARD_MAX_WIDTH 128
+#define BITBOARD_MAX_HEIGHT 64
+
+// ===== STRUCTURES =====
+typedef struct {
+    uint64_t w[2];  // w[0] : colonnes 0-63, w[1] : colonnes 64-127
+} BitRow;
+
+typedef struct {
+    int width;
+    int height;
+    BitRow mask;    // colonnes valides d'une ligne
+    BitRow rows[BITBOARD_MAX_HEIGHT];
+} Bitboard;
+
+// ===== CASES =====
+static inline void bitboard_set(Bitboard *bb, Position pos) {
+    bb->rows[pos.y].w[pos.x >> 6] |= 1ULL << (pos.x & 63);
+}
+
+static inline void bitboard_reset(Bitboard *bb, Position pos) {
+    bb->rows[pos.y].w[pos.x >> 6] &= ~(1ULL << (pos.x & 63));
+}
+
+static inline int bitboard_get(const Bitboard *bb, Position pos) {
+    if (pos.x < 0 || pos.x >= bb->width || pos.y < 0 || pos.y >= bb->height) return 0;
+    return (int)((bb->rows[pos.y].w[pos.x >> 6] >> (pos.x & 63)) & 1);
+}
+
+// ===== PROTOTYPES =====
+int bitboard_fits(int width, int height);
+int bitboard_init(Bitboard *bb, int width, int height);
+void bitboard_clear(Bitboard *bb);
+void bitboard_fill(Bitboard *bb);
+void bitboard_and(Bitboard *dst, const Bitboard *a, const Bitboard *b);
+void bitboard_or(Bitboard *dst, const Bitboard *a, const Bitboard *b);
+void bitboard_andnot(Bitboard *dst, const Bitboard *a, const Bitboard *b);
+long bitboard_count(const Bitboard *bb);
+int bitboard_nth(const Bitboard *bb, long n, Position *pos);
+int bitboard_first(const Bitboard *bb, Position *pos);
+void bitboard_neighbors(Bitboard *dst, const Bitboard *src);
+long bitboard_flood(Bitboard *dst, const Bitboard *seeds, const Bitboard *passable);
+int bitboard_components(const Bitboard *cells, long *largest);
+
+// Couches d'une partie (la grille doit tenir : bitboard_fits)
+int bitboard_from_map(Bitboard *walls, Bitboard *portals, const TileMap *map);
+void bitboard_add_snake(Bitboard *bb, const Snake *snake);
+int bitboard_game_free(const Game *game, Bitboard *free_cells);
+int bitboard_game_passable(const Game *game, Bitboard *passable);
+long bitboard_game_area(const Game *game, const Bitboard *passable, Position start);
+
+#endif
@@ -0,0 +1,168 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "snake_botpipe.h"
+
+// ===== ENTRÉES / SORTIES =====
+
+static void put16(unsigned char *p, unsigned int v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+}
+
+static void put32(unsigned char *p, unsigned long v) {
+    put16(p, v & 0xffff);
+    put16(p + 2, (v >> 16) & 0xffff);
+}
+
+// Lit exactement `size` octets. Retourne 1, 0 sur fin de fichier avant le
+// premier octet, -1 sur erreur ou message tronqué.
+static int read_full(int fd, unsigned char *buffer, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = read(fd, buffer + done, size - done);
+        if (n > 0) {
+            done += (size_t)n;
+        } else if (n == 0) {
+            return done == 0 ? 0 : -1;
+        } else if (errno != EINTR) {
+            return -1;
+        }
+    }
+    return 1;
+}
+
+static int write_full(int fd, const unsigned char *buffer, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = write(fd, buffer + done, size - done);
+        if (n > 0) {
+            done += (size_t)n;
+        } else if (n < 0 && errno != EINTR) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// ===== ENVIRONNEMENTS =====
+
+void botpipe_default_params(BotPipeParams *params) {
+    params->envs = 1;
+    params->batch = 1;
+    params->mode = MODE_CLASSIC;
+    params->difficulty = DIFF_MEDIUM;
+    params->seed = 1;
+    params->max_steps = 0;
+}
+
+int botpipe_init(BotPipe *bp, const BotPipeParams *params) {
+    memset(bp, 0, sizeof(*bp));
+    if (params->envs <= 0 || params->batch <= 0 ||
+        (long)params->envs * params->batch > BOTPIPE_MAX_STEPS) return 0;
+    bp->params = *params;
+    int steps = params->envs * params->batch;
+    if (!vec_env_init(&bp->env, params->envs, params->mode, params->difficulty, params->max_steps)) return 0;
+    bp->actions = malloc(steps);
+    bp->observations = malloc((size_t)steps * BOTPIPE_OBS_SIZE);
+    bp->rewards = malloc(params->envs * sizeof(float));
+    bp->dones = malloc(params->envs);
+    unsigned int *seeds = malloc(params->envs * sizeof(unsigned int));
+    if (!bp->actions || !bp->observations || !bp->rewards || !bp->dones || !seeds) {
+        free(seeds);
+        botpipe_free(bp);
+        return 0;
+    }
+    for (int i = 0; i < params->envs; i++) seeds[i] = params->seed + (unsigned int)i;
+    vec_env_reset(&bp->env, seeds, NULL);
+    free(seeds);
+    return 1;
+}
+
+void botpipe_free(BotPipe *bp) {
+    vec_env_free(&bp->env);
+    free(bp->actions);
+    free(bp->observations);
+    free(bp->rewards);
+    free(bp->dones);
+    memset(bp, 0, sizeof(*bp));
+}
+
+void botpipe_header(const BotPipe *bp, unsigned char *out) {
+    memset(out, 0, BOTPIPE_HEADER_SIZE);
+    put32(out, BOTPIPE_MAGIC);
+    put16(out + 4, BOTPIPE_VERSION);
+    put16(out + 6, BOTPIPE_OBS_SIZE);
+    put16(out + 8, (unsigned int)bp->params.envs);
+    put16(out + 10, (unsigned int)bp->params.batch);
+    out[12] = (unsigned char)bp->env.width;
+    out[13] = (unsigned char)bp->env.height;
+}
+
+// Case mortelle pour la tête : hors grille (sauf mode libre), mur, ou corps.
+static int is_deadly(const Game *game, Position pos) {
+    if (pos.x < 0 || pos.x >= game->grid_width || pos.y < 0 || pos.y >= game->grid_height) {
+        return game->mode != MODE_FREE;
+    }
+    if (tilemap_get(&game->map, pos) == TILE_WALL) return 1;
+    const Snake *snake = &game->snake1;
+    for (int i = 0; i < snake->length; i++) {
+        if (snake->body[i].x == pos.x && snake->body[i].y == pos.y) return 1;
+    }
+    return 0;
+}
+
+void botpipe_observe(const Game *game, int reward, int flags, unsigned long episode, unsigned char *out) {
+    const Snake *snake = &game->snake1;
+    Position head = snake->body[0];
+    static const int dx[4] = {0, 1, 0, -1}, dy[4] = {-1, 0, 1, 0};
+    for (int d = 0; d < 4; d++) {
+        Position next = {head.x + dx[d], head.y + dy[d]};
+        if (is_deadly(game, next)) flags |= 1 << (BOTPIPE_DANGER_SHIFT + d);
+    }
+    if (reward > 32767) reward = 32767;
+    if (reward < -32768) reward = -32768;
+    put32(out, game->tick);
+    out[4] = (unsigned char)head.x;
+    out[5] = (unsigned char)head.y;
+    out[6] = (unsigned char)snake->direction;
+    out[7] = (unsigned char)flags;
+    out[8] = (unsigned char)game->foods[0].pos.x;
+    out[9] = (unsigned char)game->foods[0].pos.y;
+    put16(out + 10, (unsigned int)snake->length);
+    put16(out + 12, (unsigned int)(reward & 0xffff));
+    put16(out + 14, (unsigned int)(episode & 0xffff));
+}
+
+// Joue un message : batch ticks sur tous les environnements.
+void botpipe_step(BotPipe *bp, const unsigned char *actions, unsigned char *observations) {
+    int envs = bp->params.envs;
+    for (int k = 0; k < bp->params.batch; k++) {
+        vec_env_step(&bp->env, actions + (size_t)k * envs, NULL, bp->rewards, bp->dones);
+        for (int i = 0; i < envs; i++) {
+            botpipe_observe(&bp->env.games[i], (int)bp->rewards[i], bp->dones[i], bp->env.episodes[i],
+                            observations + ((size_t)k * envs + i) * BOTPIPE_OBS_SIZE);
+        }
+    }
+    bp->steps += (unsigned long)envs * bp->params.batch;
+    bp->messages++;
+}
+
+// Boucle du protocole : en-tête, puis un message d'actions -> un message
+// d'observations jusqu'à la fin de in_fd. Retourne 1 sur fin normale.
+int botpipe_run(BotPipe *bp, int in_fd, int out_fd) {
+    unsigned char header[BOTPIPE_HEADER_SIZE];
+    botpipe_header(bp, header);
+    if (!write_full(out_fd, header, sizeof(header))) return 0;
+    size_t steps = (size_t)bp->params.envs * bp->params.batch;
+    for (;;) {
+        int status = read_full(in_fd, bp->actions, steps);
+        if (status == 0) return 1;
+        if (status < 0) return 0;
+        botpipe_step(bp, bp->actions, bp->observations);
+        if (!write_full(out_fd, bp->observations, steps * BOTPIPE_OBS_SIZE)) return 0;
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef SNAKE_BOTPIPE_H
+#define SNAKE_BOTPIPE_H
+
+#include "snake_core.h"
+#include "snake_vec_env.h"
+
+// Protocole binaire stdin/stdout pour bots et scripts d'entraînement
+// (snake_headless --bot-pipe). Le noyau fait tourner `envs` parties
+// indépendantes sans affichage.
+//
+// Au démarrage, le jeu écrit un en-tête de 16 octets :
+//   u32 "SNKP", u16 version, u16 taille d'une observation, u16 envs,
+//   u16 batch, u8 largeur, u8 hauteur, u16 réservé
+// Ensuite, en boucle : le bot écrit un message de batch * envs actions
+// (un octet chacune, rangées tick par tick : actions[k * envs + env]),
+// le jeu joue les `batch` ticks et répond par autant d'observations, dans
+// le même ordre. Un appel read et un appel write par message : le coût des
+// appels système est partagé entre batch * envs pas. Fin de stdin : fin.
+//
+// Action : 0 haut, 1 droite, 2 bas, 3 gauche, 4 (ou plus) garder la direction.
+//
+// Observation (16 octets, petit-boutiste) :
+//   0  u32 tick dans l'épisode       8  u8 x de la nourriture
+//   4  u8 x de la tête               9  u8 y de la nourriture
+//   5  u8 y de la tête               10 u16 longueur
+//   6  u8 direction                  12 i16 récompense (points gagnés ce tick)
+//   7  u8 drapeaux                   14 u16 numéro d'épisode (16 bits de poids faible)
+// Drapeaux : bit 0 fin d'épisode, bit 1 épisode tronqué (max_steps), bits 4 à 7
+// danger en haut, à droite, en bas, à gauche (case suivante mortelle).
+// Une partie finie repart aussitôt : l'observation qui porte le drapeau de
+// fin décrit déjà le premier état de l'épisode suivant, avec la récompense
+// du dernier tick. L'épisode e de l'environnement i utilise la graine
+// seed + e * envs + i. Les parties sont celles d'un VecEnv (snake_vec_env.h),
+// seule l'observation change.
+
+// ===== CONSTANTES =====
+#define BOTPIPE_MAGIC 0x504B4E53u       // "SNKP"
+#define BOTPIPE_VERSION 1
+#define BOTPIPE_HEADER_SIZE 16
+#define BOTPIPE_OBS_SIZE 16
+#define BOTPIPE_KEEP 4
+#define BOTPIPE_MAX_STEPS 65536         // batch * envs par message
+
+#define BOTPIPE_FLAG_DONE VEC_ENV_DONE
+#define BOTPIPE_FLAG_TRUNCATED VEC_ENV_TRUNCATED
+#define BOTPIPE_DANGER_SHIFT 4
+
+// ===== STRUCTURES =====
+typedef struct {
+    int envs;
+    int batch;
+    GameMode mode;
+    Difficulty difficulty;
+    unsigned int seed;
+    unsigned long max_steps;            // 0 : épisodes sans limite de durée
+} BotPipeParams;
+
+typedef struct {
+    BotPipeParams params;
+    VecEnv env;
+    unsigned char *actions;             // tampon d'un message
+    unsigned char *observations;
+    float *rewards;                     // sorties d'un tick de env
+    unsigned char *dones;
+
+    // Statistiques
+    unsigned long steps;
+    unsigned long messages;
+} BotPipe;
+
+// ===== PROTOTYPES =====
+void botpipe_default_params(BotPipeParams *params);
+int botpipe_init(BotPipe *bp, const BotPipeParams *params);
+void botpipe_free(BotPipe *bp);
+void botpipe_header(const BotPipe *bp, unsigned char *out);
+void botpipe_observe(const Game *game, int reward, int flags, unsigned long episode, unsigned char *out);
+void botpipe_step(BotPipe *bp, const unsigned char *actions, unsigned char *observations);
+int botpipe_run(BotPipe *bp, int in_fd, int out_fd);
+
+#endif
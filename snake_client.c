@@ -0,0 +1,97 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <ncurses.h>
+#include "snake_net.h"
+
+// Client terminal du serveur UDP : affiche la copie locale de l'arène
+// (centrée sur son serpent) et envoie les flèches au serveur.
+//
+//   ./snake_client [hôte] [port]
+
+static void draw(WINDOW *win, const NetClient *client) {
+    const Arena *arena = &client->mirror;
+    int rows, cols;
+    getmaxyx(win, rows, cols);
+    rows--;  // ligne d'état
+    Position center = {arena->width / 2, arena->height / 2};
+    if (client->snake_id >= 0 && arena->snakes[client->snake_id].alive) {
+        center = arena_segment(&arena->snakes[client->snake_id], 0);
+    }
+    int left = center.x - cols / 2, top = center.y - rows / 2;
+
+    werase(win);
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            Position p = {left + x, top + y};
+            if (!arena_in_bounds(arena, p)) {
+                mvwaddch(win, y, x, ACS_CKBOARD);
+                continue;
+            }
+            int cell = arena->cells[arena_index(arena, p)];
+            if (ARENA_CELL_IS_FOOD(cell)) {
+                mvwaddch(win, y, x, '*' | COLOR_PAIR(3));
+            } else if (cell > 0) {
+                int mine = cell - 1 == client->snake_id;
+                mvwaddch(win, y, x, (mine ? '@' : 'o') | COLOR_PAIR(mine ? 1 : 2));
+            }
+        }
+    }
+    int score = client->snake_id >= 0 ? arena->snakes[client->snake_id].score : 0;
+    mvwprintw(win, rows, 0, "Tick %lu | Serpent %d | Score %d | %d en vie | q : quitter",
+              arena->tick, client->snake_id, score, arena->alive_count);
+    wrefresh(win);
+}
+
+int main(int argc, char *argv[]) {
+    const char *host = argc > 1 ? argv[1] : "127.0.0.1";
+    int port = argc > 2 ? atoi(argv[2]) : NET_DEFAULT_PORT;
+
+    NetClient client;
+    if (!net_client_init(&client, host, port)) {
+        fprintf(stderr, "Erreur : impossible de joindre %s:%d\n", host, port);
+        return 1;
+    }
+
+    initscr();
+    noecho();
+    curs_set(0);
+    keypad(stdscr, TRUE);
+    nodelay(stdscr, TRUE);
+    start_color();
+    init_pair(1, COLOR_GREEN, COLOR_BLACK);
+    init_pair(2, COLOR_BLUE, COLOR_BLACK);
+    init_pair(3, COLOR_RED, COLOR_BLACK);
+
+    Direction direction = RIGHT;
+    int running = 1, waited = 0;
+    net_client_hello(&client);
+    while (running && !client.refused) {
+        int ch;
+        int changed = 0;
+        while ((ch = getch()) != ERR) {
+            switch (ch) {
+                case KEY_UP: direction = UP; changed = 1; break;
+                case KEY_RIGHT: direction = RIGHT; changed = 1; break;
+                case KEY_DOWN: direction = DOWN; changed = 1; break;
+                case KEY_LEFT: direction = LEFT; changed = 1; break;
+                case 'q':
+                case 'Q': running = 0; break;
+            }
+        }
+        if (net_client_poll(&client) > 0 || changed) {
+            net_client_send_input(&client, direction);
+            if (client.ready) draw(stdscr, &client);
+        }
+        // Pas de réponse : on redemande une place toutes les secondes
+        if (!client.ready && ++waited % 200 == 0) net_client_hello(&client);
+        usleep(5000);
+    }
+    net_client_bye(&client);
+    endwin();
+    if (client.refused) fprintf(stderr, "Serveur complet.\n");
+    net_client_free(&client);
+    return 0;
+}
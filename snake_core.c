@@ -0,0 +1,725 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+#include "snake_core.h"
+#include "snake_mapgen.h"
+#include "snake_profile.h"
+#include "snake_bitboard.h"
+#include "snake_leaderboard.h"
+
+// ===== HORLOGE =====
+
+unsigned int snake_ticks_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned int)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+// ===== TUILES =====
+
+// Compteur global : deux cartes différentes n'ont jamais la même version.
+static unsigned int tilemap_generation = 0;
+
+int tilemap_init(TileMap *map, int width, int height) {
+    memset(map, 0, sizeof(*map));
+    map->tiles = calloc((size_t)width * height, sizeof(Tile));
+    if (!map->tiles) return 0;
+    map->width = width;
+    map->height = height;
+    map->version = ++tilemap_generation;
+    return 1;
+}
+
+void tilemap_free(TileMap *map) {
+    free(map->tiles);
+    free(map->portal_dest);
+    memset(map, 0, sizeof(*map));
+}
+
+void tilemap_clear(TileMap *map) {
+    memset(map->tiles, 0, (size_t)map->width * map->height * sizeof(Tile));
+    map->portal_count = 0;
+    map->wall_count = 0;
+    map->version = ++tilemap_generation;
+}
+
+int tilemap_set_wall(TileMap *map, Position pos) {
+    Tile *tile = &map->tiles[pos.y * map->width + pos.x];
+    if (*tile != TILE_EMPTY) return 0;
+    *tile = TILE_WALL;
+    map->wall_count++;
+    map->version = ++tilemap_generation;
+    return 1;
+}
+
+// Retourne l'identifiant du portail, ou -1 si la case est prise ou la table pleine.
+int tilemap_add_portal(TileMap *map, Position pos, Position dest) {
+    Tile *tile = &map->tiles[pos.y * map->width + pos.x];
+    if (*tile != TILE_EMPTY || map->portal_count >= 0xFFFF - TILE_PORTAL) return -1;
+    if (map->portal_count == map->portal_capacity) {
+        int capacity = map->portal_capacity ? map->portal_capacity * 2 : 16;
+        Position *dests = realloc(map->portal_dest, capacity * sizeof(Position));
+        if (!dests) return -1;
+        map->portal_dest = dests;
+        map->portal_capacity = capacity;
+    }
+    int id = map->portal_count++;
+    map->portal_dest[id] = dest;
+    *tile = (Tile)(TILE_PORTAL + id);
+    map->version = ++tilemap_generation;
+    return id;
+}
+
+// ===== JEU =====
+
+void init_snake(Snake *snake, int start_x, int start_y, int player_num) {
+    snake->length = 3;
+    snake->direction = RIGHT;
+    snake->turn_count = 0;
+    snake->lives = 3;
+    snake->score = 0;
+    snake->multiplier = 1;
+    snake->combo_count = 0;
+    snake->last_food_tick = 0;
+    snake->player = player_num;
+    
+    for (int i = 0; i < snake->length; i++) {
+        snake->body[i].x = start_x - i;
+        snake->body[i].y = start_y;
+    }
+}
+
+// init_game alloue la carte de tuiles : la structure doit être neuve ou
+// avoir été libérée avec free_game. La graine vient de rand() ; deux parties
+// lancées avec init_game_seeded et la même graine restent identiques tant
+// qu'elles reçoivent les mêmes virages aux mêmes ticks. Retourne 0 si la
+// carte ne peut pas être allouée (la partie n'est alors pas utilisable).
+int init_game(Game *game, GameMode mode, Difficulty diff, int multiplayer) {
+    return init_game_seeded(game, mode, diff, multiplayer, (unsigned int)rand());
+}
+
+int init_game_seeded(Game *game, GameMode mode, Difficulty diff, int multiplayer, unsigned int seed) {
+    game->mode = mode;
+    game->difficulty = diff;
+    game->multiplayer = multiplayer;
+    
+    switch (diff) {
+        case DIFF_EASY:
+            game->grid_width = 80;
+            game->grid_height = 30;
+            game->base_speed = 200;
+            break;
+        case DIFF_MEDIUM:
+            game->grid_width = GRID_WIDTH;
+            game->grid_height = GRID_HEIGHT;
+            game->base_speed = 150;
+            break;
+        case DIFF_HARD:
+            game->grid_width = 50;
+            game->grid_height = 18;
+            game->base_speed = 100;
+            break;
+        case DIFF_EXTREME:
+            game->grid_width = 40;
+            game->grid_height = 15;
+            game->base_speed = 50;
+            break;
+    }
+    
+    if (!tilemap_init(&game->map, game->grid_width, game->grid_height)) return 0;
+    game->kernel = grid_kernel_find(game->grid_width, game->grid_height);
+    game->profiler = NULL;
+    reset_game(game, seed);
+    
+    leaderboard_player_name(game->player_name, sizeof(game->player_name), NULL);
+    load_top_scores(game);
+    return 1;
+}
+
+// Nouvelle partie dans une structure déjà initialisée : mêmes mode,
+// difficulté et carte allouée, sans relire les meilleurs scores. C'est la
+// remise à zéro rapide des environnements d'entraînement (snake_botpipe.c).
+void reset_game(Game *game, unsigned int seed) {
+    int start_x = game->grid_width / 2;
+    int start_y = game->grid_height / 2;
+    init_snake(&game->snake1, start_x, start_y, 1);
+    
+    if (game->multiplayer) {
+        init_snake(&game->snake2, start_x - 10, start_y, 2);
+    }
+    
+    game->score = 0;
+    game->level = 1;
+    game->speed = game->base_speed;
+    game->game_over = 0;
+    game->paused = 0;
+    game->winner = 0;
+    game->food_count = 1;
+    game->obstacle_count = 0;
+    game->food_eaten = 0;
+    game->start_time = snake_ticks_ms();
+    
+    game->powerup.active = 0;
+    game->slow_timer = 0;
+    game->invincible_timer = 0;
+    game->multiplier_timer = 0;
+    game->magnetic_timer = 0;
+    game->rng = seed ? seed : 1;
+    game->tick = 0;
+    
+    if (game->mode == MODE_CHALLENGE) {
+        generate_obstacles(game);
+    } else if (game->map.wall_count > 0 || game->map.portal_count > 0) {
+        tilemap_clear(&game->map);
+    }
+    generate_food(game);
+}
+
+void free_game(Game *game) {
+    tilemap_free(&game->map);
+    game->obstacle_count = 0;
+}
+
+Position generate_random_position(Game *game) {
+    Position pos;
+    pos.x = snake_rand(&game->rng) % game->grid_width;
+    pos.y = snake_rand(&game->rng) % game->grid_height;
+    return pos;
+}
+
+int is_position_valid(Game *game, Position pos, int check_snake) {
+    if (pos.x < 0 || pos.x >= game->grid_width || pos.y < 0 || pos.y >= game->grid_height)
+        return 0;
+    
+    if (game->map.tiles && tilemap_get(&game->map, pos) != TILE_EMPTY)
+        return 0;
+    
+    for (int i = 0; i < game->food_count; i++) {
+        if (game->foods[i].pos.x == pos.x && game->foods[i].pos.y == pos.y)
+            return 0;
+    }
+    
+    if (check_snake) {
+        for (int i = 0; i < game->snake1.length; i++) {
+            if (game->snake1.body[i].x == pos.x && game->snake1.body[i].y == pos.y)
+                return 0;
+        }
+        if (game->multiplayer) {
+            for (int i = 0; i < game->snake2.length; i++) {
+                if (game->snake2.body[i].x == pos.x && game->snake2.body[i].y == pos.y)
+                    return 0;
+            }
+        }
+    }
+    
+    return 1;
+}
+
+// Case libre tirée au hasard (ni mur, ni portail, ni serpent, ni
+// nourriture). Quelques essais au hasard suffisent tant que la grille est
+// peu occupée ; ensuite, tirage exact parmi les cases libres d'un bitboard,
+// qui trouve une case tant qu'il en reste. Les grilles trop grandes pour un
+// bitboard gardent jusqu'à 100 essais. Retourne 0 si aucune case n'a été
+// trouvée.
+#define FREE_CELL_QUICK_ATTEMPTS 4
+
+static int random_free_cell(Game *game, Position *pos) {
+    int attempts = 0;
+    while (attempts < 100) {
+        *pos = generate_random_position(game);
+        attempts++;
+        if (is_position_valid(game, *pos, 1)) return 1;
+        if (attempts == FREE_CELL_QUICK_ATTEMPTS) {
+            Bitboard free_cells;
+            if (bitboard_game_free(game, &free_cells)) {
+                long count = bitboard_count(&free_cells);
+                return count > 0 && bitboard_nth(&free_cells, snake_rand(&game->rng) % count, pos);
+            }
+        }
+    }
+    return 0;
+}
+
+void generate_food(Game *game) {
+    // Les positions de la partie précédente (ou non initialisées) ne comptent pas
+    for (int i = 0; i < game->food_count; i++) game->foods[i].pos = (Position){-1, -1};
+    for (int i = 0; i < game->food_count; i++) {
+        Position pos;
+        if (random_free_cell(game, &pos)) {
+            game->foods[i].pos = pos;
+            int r = snake_rand(&game->rng) % 100;
+            if (r < 50) game->foods[i].type = FOOD_NORMAL;
+            else if (r < 70) game->foods[i].type = FOOD_GOLDEN;
+            else if (r < 85) game->foods[i].type = FOOD_POISON;
+            else if (r < 95) game->foods[i].type = FOOD_FAST;
+            else game->foods[i].type = FOOD_BONUS;
+            game->foods[i].timer = 0;
+            game->foods[i].pulse = 0;
+        }
+    }
+}
+
+void generate_powerup(Game *game) {
+    if (game->powerup.active) return;
+    if (snake_rand(&game->rng) % 100 < 15) {
+        Position pos;
+        if (random_free_cell(game, &pos)) {
+            game->powerup.pos = pos;
+            game->powerup.active = 1;
+            game->powerup.timer = 0;
+            int r = snake_rand(&game->rng) % 4;
+            switch (r) {
+                case 0: game->powerup.type = POWERUP_SLOW; break;
+                case 1: game->powerup.type = POWERUP_INVINCIBLE; break;
+                case 2: game->powerup.type = POWERUP_MULTIPLIER; break;
+                case 3: game->powerup.type = POWERUP_MAGNETIC; break;
+            }
+        }
+    }
+}
+
+// Obstacles du mode défi : 2 % des cases, dont un cinquième de portails,
+// posés sans jamais isoler une partie de la grille (voir snake_mapgen.c).
+// La ligne de départ des serpents et les cases devant eux restent libres.
+void generate_obstacles(Game *game) {
+    MapGenParams params;
+    mapgen_default_params(&params);
+    params.max_obstacles = MAX_OBSTACLES;
+    params.seed = snake_rand(&game->rng);
+    int start_x = game->grid_width / 2;
+    int start_y = game->grid_height / 2;
+    params.clear_x0 = start_x - 13;
+    params.clear_x1 = start_x + 4;
+    params.clear_y0 = start_y - 1;
+    params.clear_y1 = start_y + 1;
+    
+    game->obstacle_count = mapgen_generate(&game->map, &params);
+}
+
+// ===== VIRAGES =====
+
+// Ajoute un virage à la file. Il est comparé au dernier virage en attente
+// (ou à la direction exécutée si la file est vide) : demi-tour et répétition
+// sont refusés. Retourne 0 si le virage est refusé ou si la file est pleine.
+int queue_turn(Snake *snake, Direction direction, unsigned int stamp_ms) {
+    Direction last = snake->turn_count > 0 ? snake->turns[snake->turn_count - 1].direction
+                                           : snake->direction;
+    if (direction == last || direction == (last + 2) % 4) return 0;
+    if (snake->turn_count >= TURN_QUEUE_SIZE) return 0;
+    snake->turns[snake->turn_count].direction = direction;
+    snake->turns[snake->turn_count].stamp_ms = stamp_ms;
+    snake->turn_count++;
+    return 1;
+}
+
+// Retire un virage de la file et l'applique (un par tick), en le validant
+// contre la dernière direction exécutée. Retourne 1 si la direction a changé.
+int next_turn(Snake *snake, unsigned int *stamp_ms) {
+    while (snake->turn_count > 0) {
+        QueuedTurn turn = snake->turns[0];
+        snake->turn_count--;
+        memmove(snake->turns, snake->turns + 1, snake->turn_count * sizeof(QueuedTurn));
+        if (turn.direction == snake->direction || turn.direction == (snake->direction + 2) % 4) continue;
+        snake->direction = turn.direction;
+        if (stamp_ms) *stamp_ms = turn.stamp_ms;
+        return 1;
+    }
+    return 0;
+}
+
+// ===== NOYAUX PAR TAILLE DE GRILLE =====
+// Le corps du tick est écrit une fois, avec la largeur et la hauteur en
+// paramètres et inliné partout : chaque taille des quatre difficultés a sa
+// copie où ce sont des constantes (bornes, repli du mode libre, pas de ligne
+// de la couche de tuiles). Les autres tailles passent par la copie générique.
+
+#define KERNEL_INLINE static inline __attribute__((always_inline))
+
+// Perte d'une vie en arcade (serpent replacé au centre) ou fin de partie.
+// Retourne 1 si le serpent continue.
+KERNEL_INLINE int lose_life(Game *game, Snake *snake, int width, int height) {
+    if (game->mode == MODE_ARCADE && snake->lives > 0) {
+        snake->lives--;
+        int start_x = width / 2;
+        int start_y = height / 2;
+        snake->length = 3;
+        for (int j = 0; j < snake->length; j++) {
+            snake->body[j].x = start_x - j;
+            snake->body[j].y = start_y;
+        }
+        return 1;
+    }
+    if (game->multiplayer) {
+        game->winner = (snake == &game->snake1) ? 2 : 1;
+    }
+    game->game_over = 1;
+    return 0;
+}
+
+KERNEL_INLINE void obstacle_hit(Game *game, Snake *snake, Tile tile, int width, int height) {
+    if (tile_is_portal(tile)) {
+        snake->body[0] = game->map.portal_dest[tile_portal_id(tile)];
+    } else if (game->invincible_timer == 0) {
+        lose_life(game, snake, width, height);
+    }
+}
+
+KERNEL_INLINE void move_snake_sized(Game *game, Snake *snake, int width, int height) {
+    if (game->paused || game->game_over) return;
+    
+    unsigned int stamp;
+    if (next_turn(snake, &stamp) && stamp != 0 && game->profiler) {
+        profile_add(&game->profiler->input_latency, (double)(snake_ticks_ms() - stamp));
+    }
+    
+    Position head = snake->body[0];
+    
+    switch (snake->direction) {
+        case UP: head.y--; break;
+        case RIGHT: head.x++; break;
+        case DOWN: head.y++; break;
+        case LEFT: head.x--; break;
+    }
+    
+    if (game->mode == MODE_FREE) {
+        if (head.x < 0) head.x = width - 1;
+        if (head.x >= width) head.x = 0;
+        if (head.y < 0) head.y = height - 1;
+        if (head.y >= height) head.y = 0;
+    } else {
+        if (head.x < 0 || head.x >= width ||
+            head.y < 0 || head.y >= height) {
+            if (!lose_life(game, snake, width, height)) return;
+            head = snake->body[0];
+        }
+    }
+    
+    if (game->invincible_timer == 0) {
+        for (int i = 1; i < snake->length; i++) {
+            if (head.x == snake->body[i].x && head.y == snake->body[i].y) {
+                if (!lose_life(game, snake, width, height)) return;
+                head = snake->body[0];
+            }
+        }
+    }
+    
+    if (game->multiplayer) {
+        Snake *other = (snake == &game->snake1) ? &game->snake2 : &game->snake1;
+        for (int i = 0; i < other->length; i++) {
+            if (head.x == other->body[i].x && head.y == other->body[i].y) {
+                if (game->invincible_timer == 0) {
+                    if (!lose_life(game, snake, width, height)) return;
+                    head = snake->body[0];
+                }
+            }
+        }
+    }
+    
+    for (int i = snake->length; i > 0; i--) {
+        snake->body[i] = snake->body[i - 1];
+    }
+    snake->body[0] = head;
+    
+    Tile tile = game->map.tiles[head.y * width + head.x];
+    if (tile != TILE_EMPTY) obstacle_hit(game, snake, tile, width, height);
+    check_food_collision(game, snake);
+    
+    if (game->powerup.active) {
+        if (head.x == game->powerup.pos.x && head.y == game->powerup.pos.y) {
+            switch (game->powerup.type) {
+                case POWERUP_SLOW:
+                    game->slow_timer = POWERUP_DURATION;
+                    game->speed = game->base_speed * 2;
+                    break;
+                case POWERUP_INVINCIBLE:
+                    game->invincible_timer = POWERUP_DURATION;
+                    break;
+                case POWERUP_MULTIPLIER:
+                    game->multiplier_timer = POWERUP_DURATION;
+                    snake->multiplier = 2;
+                    break;
+                case POWERUP_MAGNETIC:
+                    game->magnetic_timer = POWERUP_DURATION;
+                    break;
+                default: break;
+            }
+            game->powerup.active = 0;
+        }
+    }
+}
+
+void check_food_collision(Game *game, Snake *snake) {
+    Position head = snake->body[0];
+    
+    for (int i = 0; i < game->food_count; i++) {
+        if (head.x == game->foods[i].pos.x && head.y == game->foods[i].pos.y) {
+            int points = 0;
+            int should_grow = 1;
+            
+            switch (game->foods[i].type) {
+                case FOOD_NORMAL: points = 10; break;
+                case FOOD_GOLDEN: points = 50; break;
+                case FOOD_POISON:
+                    if (snake->length > 3) {
+                        snake->length -= 2;
+                        should_grow = 0;
+                    }
+                    points = -5;
+                    break;
+                case FOOD_FAST:
+                    game->speed = game->base_speed / 2;
+                    points = 15;
+                    break;
+                case FOOD_BONUS: points = 100; break;
+            }
+            
+            // Fenêtre de combo en ticks à la vitesse de base de la difficulté :
+            // le résultat ne dépend pas de l'horloge de la machine.
+            unsigned long window = COMBO_WINDOW_MS / game->base_speed;
+            if (game->tick - snake->last_food_tick < window) {
+                snake->combo_count++;
+                points = (int)(points * (1.0 + snake->combo_count * 0.1));
+            } else {
+                snake->combo_count = 0;
+            }
+            snake->last_food_tick = game->tick;
+            
+            points *= snake->multiplier;
+            
+            if (should_grow) {
+                snake->length++;
+                if (snake->length >= MAX_LENGTH) snake->length = MAX_LENGTH - 1;
+            }
+            
+            snake->score += points;
+            game->score += points;
+            game->food_eaten++;
+            
+            int new_level = (game->score / 100) + 1;
+            if (new_level > game->level) {
+                game->level = new_level;
+                if (game->slow_timer == 0) {
+                    game->speed = game->base_speed - (game->level - 1) * 5;
+                    if (game->speed < 30) game->speed = 30;
+                }
+            }
+            
+            Position pos;
+            if (random_free_cell(game, &pos)) {
+                game->foods[i].pos = pos;
+                int r = snake_rand(&game->rng) % 100;
+                if (r < 50) game->foods[i].type = FOOD_NORMAL;
+                else if (r < 70) game->foods[i].type = FOOD_GOLDEN;
+                else if (r < 85) game->foods[i].type = FOOD_POISON;
+                else if (r < 95) game->foods[i].type = FOOD_FAST;
+                else game->foods[i].type = FOOD_BONUS;
+            }
+            
+            generate_powerup(game);
+            break;
+        }
+    }
+}
+
+void update_powerups(Game *game) {
+    if (game->slow_timer > 0) {
+        game->slow_timer--;
+        if (game->slow_timer == 0) {
+            game->speed = game->base_speed - (game->level - 1) * 5;
+            if (game->speed < 30) game->speed = 30;
+        }
+    }
+    
+    if (game->invincible_timer > 0) game->invincible_timer--;
+    
+    if (game->multiplier_timer > 0) {
+        game->multiplier_timer--;
+        if (game->multiplier_timer == 0) {
+            game->snake1.multiplier = 1;
+            if (game->multiplayer) game->snake2.multiplier = 1;
+        }
+    }
+    
+    if (game->magnetic_timer > 0) game->magnetic_timer--;
+    
+    for (int i = 0; i < game->food_count; i++) {
+        game->foods[i].timer++;
+        game->foods[i].pulse = (game->foods[i].pulse + 1) % 10;
+    }
+}
+
+KERNEL_INLINE void step_game_sized(Game *game, int width, int height) {
+    if (game->paused || game->game_over) return;
+    move_snake_sized(game, &game->snake1, width, height);
+    if (game->multiplayer) move_snake_sized(game, &game->snake2, width, height);
+    update_powerups(game);
+    game->tick++;
+}
+
+struct GridKernel {
+    int width;
+    int height;
+    void (*move)(Game *game, Snake *snake);
+    void (*step)(Game *game);
+};
+
+#define GRID_KERNEL(W, H) \
+    static void move_snake_##W##x##H(Game *game, Snake *snake) { move_snake_sized(game, snake, W, H); } \
+    static void step_game_##W##x##H(Game *game) { step_game_sized(game, W, H); }
+
+GRID_KERNEL(80, 30)
+GRID_KERNEL(60, 20)
+GRID_KERNEL(50, 18)
+GRID_KERNEL(40, 15)
+
+static const struct GridKernel grid_kernels[] = {
+    {80, 30, move_snake_80x30, step_game_80x30},
+    {60, 20, move_snake_60x20, step_game_60x20},
+    {50, 18, move_snake_50x18, step_game_50x18},
+    {40, 15, move_snake_40x15, step_game_40x15},
+};
+
+// Noyau spécialisé pour une taille de grille, NULL s'il n'y en a pas.
+const struct GridKernel *grid_kernel_find(int width, int height) {
+    for (size_t i = 0; i < sizeof(grid_kernels) / sizeof(grid_kernels[0]); i++) {
+        if (grid_kernels[i].width == width && grid_kernels[i].height == height) return &grid_kernels[i];
+    }
+    return NULL;
+}
+
+// Le noyau choisi à l'initialisation ne sert que si la grille n'a pas
+// changé de taille depuis.
+static const struct GridKernel *game_kernel(const Game *game) {
+    const struct GridKernel *kernel = game->kernel;
+    if (kernel && kernel->width == game->grid_width && kernel->height == game->grid_height) return kernel;
+    return NULL;
+}
+
+void move_snake(Game *game, Snake *snake) {
+    const struct GridKernel *kernel = game_kernel(game);
+    if (kernel) kernel->move(game, snake);
+    else move_snake_sized(game, snake, game->grid_width, game->grid_height);
+}
+
+void check_obstacle_collision(Game *game, Snake *snake) {
+    Tile tile = tilemap_get(&game->map, snake->body[0]);
+    if (tile != TILE_EMPTY) obstacle_hit(game, snake, tile, game->grid_width, game->grid_height);
+}
+
+// Un tick complet : déplacement des serpents, puis minuteries.
+void step_game(Game *game) {
+    const struct GridKernel *kernel = game_kernel(game);
+    if (kernel) kernel->step(game);
+    else step_game_sized(game, game->grid_width, game->grid_height);
+}
+
+static unsigned long hash_bytes(unsigned long h, const void *data, size_t size) {
+    const unsigned char *p = data;
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= 1099511628211UL;
+    }
+    return h;
+}
+
+static unsigned long hash_int(unsigned long h, long value) {
+    return hash_bytes(h, &value, sizeof(value));
+}
+
+static unsigned long hash_snake(unsigned long h, const Snake *snake) {
+    h = hash_int(h, snake->length);
+    h = hash_bytes(h, snake->body, snake->length * sizeof(Position));
+    h = hash_int(h, snake->direction);
+    h = hash_int(h, snake->lives);
+    h = hash_int(h, snake->score);
+    h = hash_int(h, snake->multiplier);
+    h = hash_int(h, snake->combo_count);
+    return hash_int(h, (long)snake->last_food_tick);
+}
+
+// Empreinte FNV-1a de l'état simulé (pas des statistiques ni de l'affichage).
+// Deux pairs en réseau la comparent tick par tick pour détecter une désynchro.
+unsigned long game_hash(const Game *game) {
+    unsigned long h = 14695981039346656037UL;
+    h = hash_snake(h, &game->snake1);
+    if (game->multiplayer) h = hash_snake(h, &game->snake2);
+    for (int i = 0; i < game->food_count; i++) {
+        h = hash_bytes(h, &game->foods[i].pos, sizeof(Position));
+        h = hash_int(h, game->foods[i].type);
+    }
+    h = hash_int(h, game->powerup.active);
+    if (game->powerup.active) {
+        h = hash_bytes(h, &game->powerup.pos, sizeof(Position));
+        h = hash_int(h, game->powerup.type);
+    }
+    h = hash_int(h, game->score);
+    h = hash_int(h, game->level);
+    h = hash_int(h, game->speed);
+    h = hash_int(h, game->game_over);
+    h = hash_int(h, game->winner);
+    h = hash_int(h, game->slow_timer);
+    h = hash_int(h, game->invincible_timer);
+    h = hash_int(h, game->multiplier_timer);
+    h = hash_int(h, game->magnetic_timer);
+    h = hash_int(h, game->rng);
+    return hash_int(h, (long)game->tick);
+}
+
+// Les segments au-delà de `length` ne sont jamais lus avant d'être réécrits
+// (move_snake décale le corps avant de l'allonger) : on ne copie que la partie
+// utile, quelques centaines d'octets au lieu de 16 Ko.
+static void copy_snake(Snake *dst, const Snake *src) {
+    memcpy(dst->body, src->body, src->length * sizeof(Position));
+    memcpy((char *)dst + offsetof(Snake, length), (const char *)src + offsetof(Snake, length),
+           sizeof(Snake) - offsetof(Snake, length));
+}
+
+// Copie l'état simulé d'une partie (instantané pour le rollback). La carte de
+// tuiles est partagée : elle ne change plus après init_game. Les meilleurs
+// scores et le profileur de dst sont conservés.
+void game_copy_state(Game *dst, const Game *src) {
+    copy_snake(&dst->snake1, &src->snake1);
+    copy_snake(&dst->snake2, &src->snake2);
+    memcpy((char *)dst + offsetof(Game, multiplayer), (const char *)src + offsetof(Game, multiplayer),
+           offsetof(Game, top_scores) - offsetof(Game, multiplayer));
+}
+
+// Les dix meilleurs scores du classement de la partie (mode, difficulté,
+// nombre de joueurs) ; seules les premières entrées du fichier sont lues.
+static void copy_top_scores(Game *game, const Leaderboard *board) {
+    LeaderEntry entry;
+    game->top_score_count = 0;
+    while (game->top_score_count < MAX_TOP_SCORES && leaderboard_entry(board, game->top_score_count + 1, &entry)) {
+        TopScore *top = &game->top_scores[game->top_score_count++];
+        top->score = entry.score;
+        top->level = entry.level;
+        memcpy(top->name, entry.name, sizeof(entry.name));
+        top->name[sizeof(entry.name)] = '\0';
+        top->date = (time_t)entry.date;
+    }
+}
+
+static void game_leaderboard_path(const Game *game, char *path, size_t size) {
+    leaderboard_path(path, size, LEADERBOARD_DIR, game->mode, game->difficulty, game->multiplayer ? 2 : 1);
+}
+
+void load_top_scores(Game *game) {
+    char path[256];
+    Leaderboard board;
+    game_leaderboard_path(game, path, sizeof(path));
+    game->top_score_count = 0;
+    if (leaderboard_open(&board, path, LEADERBOARD_CAPACITY)) copy_top_scores(game, &board);
+    leaderboard_close(&board);
+}
+
+// Plusieurs parties peuvent finir en même temps sur la même machine : le
+// score passe par le journal du classement (leaderboard_submit), puis les
+// dix meilleurs sont relus, scores des autres processus compris.
+void add_top_score(Game *game, int score) {
+    char path[256];
+    game_leaderboard_path(game, path, sizeof(path));
+    if (leaderboard_submit(path, LEADERBOARD_CAPACITY, score, game->level, game->player_name, time(NULL))) load_top_scores(game);
+}
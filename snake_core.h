@@ -0,0 +1,199 @@
+#ifndef SNAKE_CORE_H
+#define SNAKE_CORE_H
+
+#include <time.h>
+
+// Noyau du jeu, indépendant de SDL et de ncurses : types, simulation et scores.
+// Partagé par le front end SDL (snake.c) et les modules sans affichage.
+
+// ===== CONSTANTES =====
+#define GRID_WIDTH 60
+#define GRID_HEIGHT 20
+#define MAX_LENGTH 1000
+#define MAX_OBSTACLES 4096
+#define MAX_FOOD 5
+#define MAX_TOP_SCORES 10
+#define POWERUP_DURATION 100
+#define TURN_QUEUE_SIZE 3      // virages mémorisés entre deux ticks
+#define COMBO_WINDOW_MS 2000   // délai entre deux repas pour enchaîner un combo
+
+// ===== ENUMS =====
+typedef enum {
+    FOOD_NORMAL = 0, FOOD_GOLDEN, FOOD_POISON, FOOD_FAST, FOOD_BONUS
+} FoodType;
+
+typedef enum {
+    POWERUP_NONE = 0, POWERUP_SLOW, POWERUP_INVINCIBLE, POWERUP_MULTIPLIER, POWERUP_MAGNETIC
+} PowerUpType;
+
+typedef enum {
+    MODE_CLASSIC = 0, MODE_ARCADE, MODE_CHALLENGE, MODE_FREE
+} GameMode;
+
+typedef enum {
+    DIFF_EASY = 0, DIFF_MEDIUM, DIFF_HARD, DIFF_EXTREME
+} Difficulty;
+
+typedef enum { UP = 0, RIGHT, DOWN, LEFT } Direction;
+
+// ===== STRUCTURES =====
+typedef struct {
+    int x;
+    int y;
+} Position;
+
+typedef struct {
+    Position pos;
+    FoodType type;
+    int timer;
+    int pulse;
+} Food;
+
+typedef struct {
+    Position pos;
+    PowerUpType type;
+    int timer;
+    int active;
+} PowerUp;
+
+// Virage demandé, horodaté (snake_ticks_ms) pour mesurer la latence entrée -> tick.
+// stamp_ms = 0 : virage d'un bot ou de l'IA, hors mesure.
+typedef struct {
+    Direction direction;
+    unsigned int stamp_ms;
+} QueuedTurn;
+
+typedef struct {
+    Position body[MAX_LENGTH];
+    int length;
+    Direction direction;   // dernière direction exécutée
+    QueuedTurn turns[TURN_QUEUE_SIZE];
+    int turn_count;
+    int player;  // 1 ou 2, sert au choix des couleurs côté affichage
+    int lives;
+    int score;
+    int multiplier;
+    int combo_count;
+    unsigned long last_food_tick;
+} Snake;
+
+typedef struct {
+    int score;
+    int level;
+    char name[20];
+    time_t date;
+} TopScore;
+
+// Couche de tuiles statique : une case = vide, mur ou identifiant de portail.
+// Les destinations des portails sont dans une table à part, indexée par
+// l'identifiant. La collision est une seule lecture dans `tiles`.
+typedef unsigned short Tile;
+#define TILE_EMPTY 0
+#define TILE_WALL 1
+#define TILE_PORTAL 2  // TILE_PORTAL + identifiant du portail
+
+typedef struct {
+    int width;
+    int height;
+    Tile *tiles;
+    Position *portal_dest;
+    int portal_count;
+    int portal_capacity;
+    int wall_count;
+    unsigned int version;  // change à chaque modification (caches de rendu)
+} TileMap;
+
+typedef struct {
+    Snake snake1;
+    Snake snake2;
+    int multiplayer;
+    Food foods[MAX_FOOD];
+    int food_count;
+    PowerUp powerup;
+    TileMap map;
+    int obstacle_count;
+    int score;
+    int level;
+    int speed;
+    int base_speed;
+    int game_over;
+    int paused;
+    int winner;
+    GameMode mode;
+    Difficulty difficulty;
+    int grid_width;
+    int grid_height;
+    int food_eaten;
+    int time_played;
+    unsigned int start_time;
+    int slow_timer;
+    int invincible_timer;
+    int multiplier_timer;
+    int magnetic_timer;
+    // Simulation déterministe : tout l'aléatoire vient de `rng` et le temps
+    // de jeu se compte en ticks, jamais en millisecondes.
+    unsigned int rng;
+    unsigned long tick;
+    TopScore top_scores[MAX_TOP_SCORES];
+    int top_score_count;
+    char player_name[16];          // nom inscrit au classement ($USER par défaut)
+    const struct GridKernel *kernel;  // tick spécialisé pour la taille de grille, NULL : générique
+    struct TickProfiler *profiler;  // optionnel (snake_profile.h), NULL par défaut
+} Game;
+
+// ===== ALÉATOIRE =====
+// Générateur xorshift32 : un état par entité pour des simulations
+// reproductibles à partir d'une graine, sans dépendre de rand().
+static inline unsigned int snake_rand(unsigned int *state) {
+    unsigned int x = *state ? *state : 0x9E3779B9u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// ===== TUILES =====
+static inline Tile tilemap_get(const TileMap *map, Position pos) {
+    return map->tiles[pos.y * map->width + pos.x];
+}
+
+static inline int tile_is_portal(Tile tile) {
+    return tile >= TILE_PORTAL;
+}
+
+static inline int tile_portal_id(Tile tile) {
+    return tile - TILE_PORTAL;
+}
+
+// ===== PROTOTYPES =====
+unsigned int snake_ticks_ms();
+int tilemap_init(TileMap *map, int width, int height);
+void tilemap_free(TileMap *map);
+void tilemap_clear(TileMap *map);
+int tilemap_set_wall(TileMap *map, Position pos);
+int tilemap_add_portal(TileMap *map, Position pos, Position dest);
+void init_snake(Snake *snake, int start_x, int start_y, int player_num);
+int init_game(Game *game, GameMode mode, Difficulty diff, int multiplayer);
+int init_game_seeded(Game *game, GameMode mode, Difficulty diff, int multiplayer, unsigned int seed);
+void reset_game(Game *game, unsigned int seed);
+void free_game(Game *game);
+Position generate_random_position(Game *game);
+int is_position_valid(Game *game, Position pos, int check_snake);
+void generate_food(Game *game);
+void generate_powerup(Game *game);
+void generate_obstacles(Game *game);
+int queue_turn(Snake *snake, Direction direction, unsigned int stamp_ms);
+int next_turn(Snake *snake, unsigned int *stamp_ms);
+void move_snake(Game *game, Snake *snake);
+void update_powerups(Game *game);
+void step_game(Game *game);
+const struct GridKernel *grid_kernel_find(int width, int height);
+unsigned long game_hash(const Game *game);
+void game_copy_state(Game *dst, const Game *src);
+void check_food_collision(Game *game, Snake *snake);
+void check_obstacle_collision(Game *game, Snake *snake);
+void load_top_scores(Game *game);
+void add_top_score(Game *game, int score);
+
+#endif
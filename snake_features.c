@@ -0,0 +1,269 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "snake_features.h"
+
+#if !defined(SNAKE_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FEATURES_X86 1
+#include <immintrin.h>
+#endif
+
+// -1 : pas encore choisi (meilleur niveau disponible au premier appel)
+static int simd_level = -1;
+
+// ===== CHOIX DU JEU D'INSTRUCTIONS =====
+
+FeaturesSimd features_simd_available() {
+#ifdef FEATURES_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return FEATURES_AVX2;
+    if (__builtin_cpu_supports("sse2")) return FEATURES_SSE2;
+#endif
+    return FEATURES_SCALAR;
+}
+
+// Impose un niveau (tests, benchmarks), ramené au meilleur disponible.
+// Retourne le niveau retenu.
+FeaturesSimd features_set_simd(FeaturesSimd level) {
+    FeaturesSimd available = features_simd_available();
+    simd_level = level > available ? available : level;
+    return (FeaturesSimd)simd_level;
+}
+
+static FeaturesSimd current_level() {
+    if (simd_level < 0) simd_level = features_simd_available();
+    return (FeaturesSimd)simd_level;
+}
+
+size_t features_size(const Game *game) {
+    return (size_t)FEATURE_PLANES * game->grid_width * game->grid_height;
+}
+
+// ===== PLANS STATIQUES =====
+// Un passage sur la couche de tuiles : murs et portails écrits, les huit
+// plans dynamiques effacés dans la même boucle (memset en scalaire). Chaque
+// variante SIMD traite des blocs de cases et renvoie la première case non
+// traitée ; le reste passe par la version scalaire.
+
+static void fill_u8_scalar(const Tile *tiles, size_t cells, size_t from, unsigned char *out) {
+    for (int p = 0; p < FEATURE_WALL; p++) memset(out + p * cells + from, 0, cells - from);
+    for (size_t c = from; c < cells; c++) {
+        out[FEATURE_WALL * cells + c] = tiles[c] == TILE_WALL;
+        out[FEATURE_PORTAL * cells + c] = tiles[c] >= TILE_PORTAL;
+    }
+}
+
+static void fill_f32_scalar(const Tile *tiles, size_t cells, size_t from, float *out) {
+    for (int p = 0; p < FEATURE_WALL; p++) memset(out + p * cells + from, 0, (cells - from) * sizeof(float));
+    for (size_t c = from; c < cells; c++) {
+        out[FEATURE_WALL * cells + c] = tiles[c] == TILE_WALL ? 1.0f : 0.0f;
+        out[FEATURE_PORTAL * cells + c] = tiles[c] >= TILE_PORTAL ? 1.0f : 0.0f;
+    }
+}
+
+#ifdef FEATURES_X86
+// Portail : tuile >= 2, en comparaison non signée. SSE2 ne compare qu'en
+// signé ; max(t - 1, 0) saturé vaut 0 pour le vide et les murs, 1 ou plus
+// pour les portails, quel que soit l'identifiant.
+__attribute__((target("sse2")))
+static size_t fill_u8_sse2(const Tile *tiles, size_t cells, unsigned char *out) {
+    const __m128i one = _mm_set1_epi16(1), zero = _mm_setzero_si128();
+    size_t c = 0;
+    for (; c + 16 <= cells; c += 16) {
+        __m128i t0 = _mm_loadu_si128((const __m128i *)(tiles + c));
+        __m128i t1 = _mm_loadu_si128((const __m128i *)(tiles + c + 8));
+        __m128i wall = _mm_packs_epi16(_mm_and_si128(_mm_cmpeq_epi16(t0, one), one),
+                                       _mm_and_si128(_mm_cmpeq_epi16(t1, one), one));
+        __m128i portal = _mm_packs_epi16(_mm_andnot_si128(_mm_cmpeq_epi16(_mm_subs_epu16(t0, one), zero), one),
+                                         _mm_andnot_si128(_mm_cmpeq_epi16(_mm_subs_epu16(t1, one), zero), one));
+        for (int p = 0; p < FEATURE_WALL; p++) _mm_storeu_si128((__m128i *)(out + p * cells + c), zero);
+        _mm_storeu_si128((__m128i *)(out + FEATURE_WALL * cells + c), wall);
+        _mm_storeu_si128((__m128i *)(out + FEATURE_PORTAL * cells + c), portal);
+    }
+    return c;
+}
+
+__attribute__((target("sse2")))
+static size_t fill_f32_sse2(const Tile *tiles, size_t cells, float *out) {
+    const __m128i one = _mm_set1_epi16(1), none = _mm_setzero_si128();
+    const __m128i one_f = _mm_castps_si128(_mm_set1_ps(1.0f));
+    const __m128 zero = _mm_setzero_ps();
+    size_t c = 0;
+    for (; c + 8 <= cells; c += 8) {
+        __m128i t = _mm_loadu_si128((const __m128i *)(tiles + c));
+        __m128i wall = _mm_cmpeq_epi16(t, one);
+        __m128i portal = _mm_xor_si128(_mm_cmpeq_epi16(_mm_subs_epu16(t, one), none), _mm_set1_epi16(-1));
+        for (int p = 0; p < FEATURE_WALL; p++) {
+            _mm_storeu_ps(out + p * cells + c, zero);
+            _mm_storeu_ps(out + p * cells + c + 4, zero);
+        }
+        // Masque 16 bits -> masque 32 bits -> 1.0f ou 0.0f
+        float *w = out + FEATURE_WALL * cells + c, *o = out + FEATURE_PORTAL * cells + c;
+        _mm_storeu_si128((__m128i *)w, _mm_and_si128(_mm_unpacklo_epi16(wall, wall), one_f));
+        _mm_storeu_si128((__m128i *)(w + 4), _mm_and_si128(_mm_unpackhi_epi16(wall, wall), one_f));
+        _mm_storeu_si128((__m128i *)o, _mm_and_si128(_mm_unpacklo_epi16(portal, portal), one_f));
+        _mm_storeu_si128((__m128i *)(o + 4), _mm_and_si128(_mm_unpackhi_epi16(portal, portal), one_f));
+    }
+    return c;
+}
+
+__attribute__((target("avx2")))
+static size_t fill_u8_avx2(const Tile *tiles, size_t cells, unsigned char *out) {
+    const __m256i one = _mm256_set1_epi16(1), zero = _mm256_setzero_si256();
+    size_t c = 0;
+    for (; c + 32 <= cells; c += 32) {
+        __m256i t0 = _mm256_loadu_si256((const __m256i *)(tiles + c));
+        __m256i t1 = _mm256_loadu_si256((const __m256i *)(tiles + c + 16));
+        // packs travaille par moitiés de 128 bits : la permutation remet les
+        // cases dans l'ordre
+        __m256i wall = _mm256_packs_epi16(_mm256_and_si256(_mm256_cmpeq_epi16(t0, one), one),
+                                          _mm256_and_si256(_mm256_cmpeq_epi16(t1, one), one));
+        __m256i portal = _mm256_packs_epi16(_mm256_andnot_si256(_mm256_cmpeq_epi16(_mm256_subs_epu16(t0, one), zero), one),
+                                            _mm256_andnot_si256(_mm256_cmpeq_epi16(_mm256_subs_epu16(t1, one), zero), one));
+        wall = _mm256_permute4x64_epi64(wall, 0xD8);
+        portal = _mm256_permute4x64_epi64(portal, 0xD8);
+        for (int p = 0; p < FEATURE_WALL; p++) _mm256_storeu_si256((__m256i *)(out + p * cells + c), zero);
+        _mm256_storeu_si256((__m256i *)(out + FEATURE_WALL * cells + c), wall);
+        _mm256_storeu_si256((__m256i *)(out + FEATURE_PORTAL * cells + c), portal);
+    }
+    return c;
+}
+
+__attribute__((target("avx2")))
+static size_t fill_f32_avx2(const Tile *tiles, size_t cells, float *out) {
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i one_f = _mm256_castps_si256(_mm256_set1_ps(1.0f));
+    const __m256 zero = _mm256_setzero_ps();
+    size_t c = 0;
+    for (; c + 8 <= cells; c += 8) {
+        __m256i t = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(tiles + c)));
+        __m256i wall = _mm256_and_si256(_mm256_cmpeq_epi32(t, one), one_f);
+        __m256i portal = _mm256_and_si256(_mm256_cmpgt_epi32(t, one), one_f);
+        for (int p = 0; p < FEATURE_WALL; p++) _mm256_storeu_ps(out + p * cells + c, zero);
+        _mm256_storeu_si256((__m256i *)(out + FEATURE_WALL * cells + c), wall);
+        _mm256_storeu_si256((__m256i *)(out + FEATURE_PORTAL * cells + c), portal);
+    }
+    return c;
+}
+#endif
+
+// ===== CASES OCCUPÉES =====
+
+static int cell_index(const Game *game, Position pos) {
+    if (pos.x < 0 || pos.x >= game->grid_width || pos.y < 0 || pos.y >= game->grid_height) return -1;
+    return pos.y * game->grid_width + pos.x;
+}
+
+static void scatter_u8(const Game *game, size_t cells, unsigned char *out) {
+    const Snake *snake = &game->snake1;
+    for (int i = 1; i < snake->length; i++) {
+        int c = cell_index(game, snake->body[i]);
+        int age = snake->length - i;
+        if (c >= 0) out[FEATURE_BODY * cells + c] = (unsigned char)(age > 255 ? 255 : age);
+    }
+    int head = cell_index(game, snake->body[0]);
+    if (head >= 0) out[FEATURE_HEAD * cells + head] = 1;
+    for (int i = 0; i < game->food_count; i++) {
+        int c = cell_index(game, game->foods[i].pos);
+        if (c >= 0) out[(FEATURE_FOOD + game->foods[i].type) * cells + c] = 1;
+    }
+    if (game->powerup.active) {
+        int c = cell_index(game, game->powerup.pos);
+        if (c >= 0) out[FEATURE_POWERUP * cells + c] = 1;
+    }
+}
+
+static void scatter_f32(const Game *game, size_t cells, float *out) {
+    const Snake *snake = &game->snake1;
+    for (int i = 1; i < snake->length; i++) {
+        int c = cell_index(game, snake->body[i]);
+        if (c >= 0) out[FEATURE_BODY * cells + c] = (float)(snake->length - i);
+    }
+    int head = cell_index(game, snake->body[0]);
+    if (head >= 0) out[FEATURE_HEAD * cells + head] = 1.0f;
+    for (int i = 0; i < game->food_count; i++) {
+        int c = cell_index(game, game->foods[i].pos);
+        if (c >= 0) out[(FEATURE_FOOD + game->foods[i].type) * cells + c] = 1.0f;
+    }
+    if (game->powerup.active) {
+        int c = cell_index(game, game->powerup.pos);
+        if (c >= 0) out[FEATURE_POWERUP * cells + c] = 1.0f;
+    }
+}
+
+// ===== ENCODAGE =====
+
+void features_encode_u8(const Game *game, unsigned char *out) {
+    size_t cells = (size_t)game->grid_width * game->grid_height;
+    const Tile *tiles = game->map.tiles;
+    size_t done = 0;
+    switch (current_level()) {
+#ifdef FEATURES_X86
+        case FEATURES_AVX2: done = fill_u8_avx2(tiles, cells, out); break;
+        case FEATURES_SSE2: done = fill_u8_sse2(tiles, cells, out); break;
+#endif
+        default: break;
+    }
+    fill_u8_scalar(tiles, cells, done, out);
+    scatter_u8(game, cells, out);
+}
+
+void features_encode_f32(const Game *game, float *out) {
+    size_t cells = (size_t)game->grid_width * game->grid_height;
+    const Tile *tiles = game->map.tiles;
+    size_t done = 0;
+    switch (current_level()) {
+#ifdef FEATURES_X86
+        case FEATURES_AVX2: done = fill_f32_avx2(tiles, cells, out); break;
+        case FEATURES_SSE2: done = fill_f32_sse2(tiles, cells, out); break;
+#endif
+        default: break;
+    }
+    fill_f32_scalar(tiles, cells, done, out);
+    scatter_f32(game, cells, out);
+}
+
+void features_encode_batch_u8(const Game *games, int count, unsigned char *out) {
+    for (int i = 0; i < count; i++) {
+        features_encode_u8(&games[i], out);
+        out += features_size(&games[i]);
+    }
+}
+
+void features_encode_batch_f32(const Game *games, int count, float *out) {
+    for (int i = 0; i < count; i++) {
+        features_encode_f32(&games[i], out);
+        out += features_size(&games[i]);
+    }
+}
+
+// ===== RÉFÉRENCE NAÏVE =====
+
+void features_encode_naive_u8(const Game *game, unsigned char *out) {
+    int width = game->grid_width, height = game->grid_height;
+    size_t cells = (size_t)width * height;
+    for (size_t i = 0; i < FEATURE_PLANES * cells; i++) out[i] = 0;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            Tile tile = tilemap_get(&game->map, (Position){x, y});
+            if (tile == TILE_WALL) out[FEATURE_WALL * cells + y * width + x] = 1;
+            else if (tile_is_portal(tile)) out[FEATURE_PORTAL * cells + y * width + x] = 1;
+        }
+    }
+    scatter_u8(game, cells, out);
+}
+
+void features_encode_naive_f32(const Game *game, float *out) {
+    int width = game->grid_width, height = game->grid_height;
+    size_t cells = (size_t)width * height;
+    for (size_t i = 0; i < FEATURE_PLANES * cells; i++) out[i] = 0.0f;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            Tile tile = tilemap_get(&game->map, (Position){x, y});
+            if (tile == TILE_WALL) out[FEATURE_WALL * cells + y * width + x] = 1.0f;
+            else if (tile_is_portal(tile)) out[FEATURE_PORTAL * cells + y * width + x] = 1.0f;
+        }
+    }
+    scatter_f32(game, cells, out);
+}
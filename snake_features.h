@@ -0,0 +1,53 @@
+#ifndef SNAKE_FEATURES_H
+#define SNAKE_FEATURES_H
+
+#include "snake_core.h"
+
+// Plans de caractéristiques pour les bots à apprentissage : un tenseur
+// [FEATURE_PLANES][hauteur][largeur] par partie, en uint8 ou en float, rangé
+// plan par plan. Pour un lot (features_encode_batch_*), les tenseurs des
+// parties se suivent : [N][C][H][W] (VecEnv.games convient tel quel).
+//
+//   FEATURE_HEAD                 1 sur la tête du serpent 1
+//   FEATURE_BODY                 âge du segment : length - i pour body[i]
+//                                (1 pour la queue), plafonné à 255 en uint8
+//   FEATURE_FOOD + FoodType      1 sur chaque nourriture de ce type
+//   FEATURE_POWERUP              1 sur le power-up actif
+//   FEATURE_WALL, FEATURE_PORTAL 1 sur les murs et les entrées de portail
+//
+// Les plans statiques viennent de la couche de tuiles (une lecture par case,
+// comparée par blocs de 8 ou 16 cases en SSE2/AVX2), les autres plans sont
+// effacés par les mêmes écritures vectorielles puis seules les cases
+// occupées sont écrites. Repli scalaire hors x86 ou avec -DSNAKE_NO_SIMD.
+
+// ===== CONSTANTES =====
+enum {
+    FEATURE_HEAD = 0,
+    FEATURE_BODY,
+    FEATURE_FOOD,                       // 5 plans, un par FoodType
+    FEATURE_POWERUP = FEATURE_FOOD + 5,
+    FEATURE_WALL,
+    FEATURE_PORTAL,
+    FEATURE_PLANES
+};
+
+typedef enum {
+    FEATURES_SCALAR = 0, FEATURES_SSE2, FEATURES_AVX2
+} FeaturesSimd;
+
+// ===== PROTOTYPES =====
+FeaturesSimd features_simd_available();
+FeaturesSimd features_set_simd(FeaturesSimd level);
+size_t features_size(const Game *game);
+
+void features_encode_u8(const Game *game, unsigned char *out);
+void features_encode_f32(const Game *game, float *out);
+void features_encode_batch_u8(const Game *games, int count, unsigned char *out);
+void features_encode_batch_f32(const Game *games, int count, float *out);
+
+// Version naïve (effacement puis parcours case par case), référence des
+// tests et des benchmarks
+void features_encode_naive_u8(const Game *game, unsigned char *out);
+void features_encode_naive_f32(const Game *game, float *out);
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef SNAKE_FONT_H
+#define SNAKE_FONT_H
+
+#include <stdint.h>
+
+// Police bitmap intégrée (5x7, ASCII 32 à 126, sans dépendance) : un atlas
+// de glyphes en pixels 32 bits, rempli une fois, et une mise en page qui
+// donne un quad par caractère (position à l'écran, coin dans l'atlas). Les
+// caractères hors table s'affichent en '?'. Indépendant de SDL : les
+// rendus (texture SDL, tampon logiciel) se servent des mêmes quads.
+
+// ===== CONSTANTES =====
+#define FONT_GLYPH_W 5
+#define FONT_GLYPH_H 7
+#define FONT_CELL_W 6       // avance horizontale (un pixel d'espacement)
+#define FONT_CELL_H 8
+#define FONT_FIRST_CHAR 32
+#define FONT_GLYPH_COUNT 95
+#define FONT_ATLAS_COLS 16
+#define FONT_ATLAS_W (FONT_ATLAS_COLS * FONT_CELL_W)
+#define FONT_ATLAS_H (((FONT_GLYPH_COUNT + FONT_ATLAS_COLS - 1) / FONT_ATLAS_COLS) * FONT_CELL_H)
+
+// ===== STRUCTURES =====
+typedef struct {
+    short x, y, w, h;   // rectangle à l'écran
+    short u, v;         // coin haut gauche du glyphe dans l'atlas (FONT_GLYPH_W x FONT_GLYPH_H)
+} FontQuad;
+
+// ===== PROTOTYPES =====
+int font_glyph_pixel(unsigned char c, int x, int y);
+void font_build_atlas(uint32_t *pixels, int pitch, uint32_t ink, uint32_t paper);
+int font_text_width(const char *text, int scale);
+int font_layout(const char *text, int x, int y, int scale, FontQuad *quads, int max_quads);
+
+#endif
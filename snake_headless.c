@@ -0,0 +1,181 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "snake_botpipe.h"
+#include "snake_raster.h"
+
+// Jeu sans affichage piloté par un bot externe (protocole dans snake_botpipe.h).
+//
+//   ./snake_headless --bot-pipe [--envs N] [--batch K] [--seed S] [--max-steps M]
+//                    [--mode classic|arcade|challenge|free]
+//                    [--difficulty easy|medium|hard|extreme] [--stats]
+//                    [--session-log CHEMIN]
+//
+// Observations sur stdout, actions sur stdin. --stats affiche le débit sur
+// stderr à la fin. --session-log ajoute chaque épisode terminé au journal
+// des parties (snake_session.h), fdatasync tous les SESSION_SYNC_EVERY.
+//
+// Relecture d'un enregistrement (./snake --stream partie.bin) en images, par
+// le rendu logiciel (snake_raster.h), sans écran ni GPU :
+//
+//   ./snake_headless --replay partie.bin --frames DOSSIER [--png] [--cell PX]
+//                    [--every N] [--stats]
+//
+// Une image par tick (ou tous les N ticks) : DOSSIER/frame_000042.ppm.
+// --stats affiche le coût du rendu par image.
+
+static const char *mode_names[] = {"classic", "arcade", "challenge", "free"};
+static const char *difficulty_names[] = {"easy", "medium", "hard", "extreme"};
+
+static int parse_name(const char *value, const char *const *names, int count) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(value, names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Retourne le nombre d'images écrites, -1 en cas d'erreur.
+static long replay_to_images(const char *path, const char *dir, int png, int cell, int every, int stats) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    StreamReader reader;
+    if (!stream_reader_open_fd(&reader, fd)) {
+        close(fd);
+        return -1;
+    }
+    RasterImage image = {0, 0, NULL};
+    long written = 0, index = 0;
+    double render_ms = 0, write_ms = 0;
+    while (stream_reader_next(&reader) > 0) {
+        const StreamFrame *frame = reader.frame;
+        if (index++ % every != 0) continue;
+        int width, height;
+        raster_game_size(frame->width, frame->height, cell, &width, &height);
+        if (image.width != width || image.height != height) {
+            raster_free(&image);
+            if (!raster_init(&image, width, height)) break;
+        }
+        double start = now_seconds();
+        raster_draw_frame(&image, frame, cell);
+        double drawn = now_seconds();
+        char name[4096];
+        snprintf(name, sizeof(name), "%s/frame_%06lu.%s", dir, frame->tick, png ? "png" : "ppm");
+        if (!(png ? raster_write_png(&image, name) : raster_write_ppm(&image, name))) {
+            fprintf(stderr, "Erreur : écriture de %s impossible\n", name);
+            written = -1;
+            break;
+        }
+        render_ms += (drawn - start) * 1000;
+        write_ms += (now_seconds() - drawn) * 1000;
+        written++;
+    }
+    if (stats && written > 0) {
+        fprintf(stderr, "%ld images %dx%d : rendu %.1f µs/image, écriture %.1f µs/image\n", written,
+                image.width, image.height, render_ms * 1000 / written, write_ms * 1000 / written);
+    }
+    raster_free(&image);
+    stream_reader_close(&reader);
+    close(fd);  // descripteur fourni : le lecteur ne le ferme pas
+    return written;
+}
+
+int main(int argc, char *argv[]) {
+    BotPipeParams params;
+    botpipe_default_params(&params);
+    int bot_pipe = 0, stats = 0, ok = 1;
+    const char *replay = NULL, *frames_dir = NULL, *session_path = NULL;
+    int png = 0, cell = 20, every = 1;
+
+    for (int i = 1; i < argc && ok; i++) {
+        if (strcmp(argv[i], "--bot-pipe") == 0) {
+            bot_pipe = 1;
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            stats = 1;
+        } else if (strcmp(argv[i], "--session-log") == 0 && i + 1 < argc) {
+            session_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay = argv[++i];
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames_dir = argv[++i];
+        } else if (strcmp(argv[i], "--png") == 0) {
+            png = 1;
+        } else if (strcmp(argv[i], "--cell") == 0 && i + 1 < argc) {
+            cell = atoi(argv[++i]);
+            ok = cell > 0 && cell <= 64;
+        } else if (strcmp(argv[i], "--every") == 0 && i + 1 < argc) {
+            every = atoi(argv[++i]);
+            ok = every > 0;
+        } else if (strcmp(argv[i], "--envs") == 0 && i + 1 < argc) {
+            params.envs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            params.batch = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            params.seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--max-steps") == 0 && i + 1 < argc) {
+            params.max_steps = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc) {
+            int mode = parse_name(argv[++i], mode_names, 4);
+            ok = mode >= 0;
+            params.mode = (GameMode)mode;
+        } else if (strcmp(argv[i], "--difficulty") == 0 && i + 1 < argc) {
+            int difficulty = parse_name(argv[++i], difficulty_names, 4);
+            ok = difficulty >= 0;
+            params.difficulty = (Difficulty)difficulty;
+        } else {
+            ok = 0;
+        }
+    }
+    if (ok && replay && frames_dir && !bot_pipe) {
+        long written = replay_to_images(replay, frames_dir, png, cell, every, stats);
+        if (written < 0) fprintf(stderr, "Erreur : relecture de %s impossible\n", replay);
+        return written < 0 ? 1 : 0;
+    }
+    if (!ok || !bot_pipe) {
+        fprintf(stderr, "Usage : %s --bot-pipe [--envs N] [--batch K] [--seed S] [--max-steps M]\n"
+                        "       [--mode classic|arcade|challenge|free] "
+                        "[--difficulty easy|medium|hard|extreme] [--stats]\n"
+                        "       [--session-log CHEMIN]\n"
+                        "       %s --replay FICHIER --frames DOSSIER [--png] [--cell PX] [--every N] [--stats]\n",
+                argv[0], argv[0]);
+        return 2;
+    }
+
+    BotPipe bp;
+    if (!botpipe_init(&bp, &params)) {
+        fprintf(stderr, "Erreur : %d environnements x %d ticks par message (%d pas au plus)\n",
+                params.envs, params.batch, BOTPIPE_MAX_STEPS);
+        return 1;
+    }
+    SessionLog log;
+    if (session_path) {
+        if (!session_log_open(&log, session_path, SESSION_SYNC_EVERY)) {
+            fprintf(stderr, "Erreur : journal %s impossible à ouvrir\n", session_path);
+            botpipe_free(&bp);
+            return 1;
+        }
+        bp.env.log = &log;
+    }
+    double start = now_seconds();
+    int status = botpipe_run(&bp, STDIN_FILENO, STDOUT_FILENO);
+    double elapsed = now_seconds() - start;
+    if (session_path && !session_log_close(&log)) {
+        fprintf(stderr, "Erreur : écriture du journal %s\n", session_path);
+        status = 0;
+    }
+    if (stats) {
+        fprintf(stderr, "%lu pas, %lu épisodes, %lu messages en %.2f s (%.0f pas/s)\n", bp.steps,
+                bp.env.episodes_done, bp.messages, elapsed, elapsed > 0 ? bp.steps / elapsed : 0);
+    }
+    botpipe_free(&bp);
+    return status ? 0 : 1;
+}
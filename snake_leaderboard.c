@@ -0,0 +1,508 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "snake_leaderboard.h"
+
+typedef struct {
+    char magic[8];
+    uint32_t entry_size;
+    uint32_t count;
+} LeaderHeader;
+
+static const char leader_magic[8] = "SNKLB01";
+static const char *mode_names[] = {"classic", "arcade", "challenge", "free"};
+static const char *difficulty_names[] = {"easy", "medium", "hard", "extreme"};
+
+_Static_assert(sizeof(LeaderEntry) == 32, "LeaderEntry : 32 octets");
+
+// Même xorshift que snake_rand : le module ne dépend pas du noyau, pour
+// servir aussi au front end ncurses autonome.
+static unsigned int leaderboard_rand(unsigned int *state) {
+    unsigned int x = *state ? *state : 0x9E3779B9u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+void leaderboard_path(char *out, size_t size, const char *dir, int mode, int difficulty, int players) {
+    snprintf(out, size, "%s/%s-%s-%d.bin", dir, mode_names[mode % 4], difficulty_names[difficulty % 4], players);
+}
+
+void leaderboard_player_name(char *out, size_t size, const char *name) {
+    if (!name || !*name) name = getenv("USER");
+    if (!name || !*name) name = "Player";
+    snprintf(out, size, "%s", name);
+}
+
+// ===== FICHIER =====
+
+static void unmap_disk(Leaderboard *board) {
+    if (board->base) munmap((void *)board->base, board->size);
+    if (board->fd >= 0) close(board->fd);
+    board->fd = -1;
+    board->base = NULL;
+    board->size = 0;
+    board->disk = NULL;
+    board->disk_count = 0;
+}
+
+static void journal_path(char *out, size_t size, const char *path) {
+    snprintf(out, size, "%s.journal", path);
+}
+
+static int init_board(Leaderboard *board, const char *path, long capacity) {
+    memset(board, 0, sizeof(*board));
+    board->fd = -1;
+    board->root = -1;
+    board->rng = 0x1EADB0A4u;
+    board->capacity = capacity > 0 && capacity <= LEADERBOARD_CAPACITY ? capacity : LEADERBOARD_CAPACITY;
+    if (strlen(path) >= sizeof(board->path)) return 0;
+    strcpy(board->path, path);
+    return 1;
+}
+
+// Fichier absent : classement vide. Retourne 0 si le fichier existe mais
+// n'est pas un classement.
+static int map_disk(Leaderboard *board) {
+    int fd = open(board->path, O_RDONLY);
+    if (fd < 0) return errno == ENOENT;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(LeaderHeader)) {
+        close(fd);
+        return 0;
+    }
+    void *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return 0;
+    }
+    const LeaderHeader *header = base;
+    if (memcmp(header->magic, leader_magic, sizeof(header->magic)) != 0 || header->entry_size != sizeof(LeaderEntry) ||
+        sizeof(LeaderHeader) + (size_t)header->count * sizeof(LeaderEntry) > (size_t)st.st_size) {
+        munmap(base, (size_t)st.st_size);
+        close(fd);
+        return 0;
+    }
+    board->fd = fd;
+    board->base = base;
+    board->size = (size_t)st.st_size;
+    board->disk = (const LeaderEntry *)(board->base + sizeof(LeaderHeader));
+    board->disk_count = header->count < (uint32_t)board->capacity ? (long)header->count : board->capacity;
+    return 1;
+}
+
+static int ranks_before(const LeaderNode *a, const LeaderNode *b);
+
+static int compare_pending(const void *a, const void *b) {
+    return ranks_before(b, a) - ranks_before(a, b);
+}
+
+// Entrées du journal, numérotées à la suite du fichier puis triées. Une
+// entrée incomplète en fin de journal est ignorée.
+static int read_journal(Leaderboard *board, int fd) {
+    struct stat st;
+    if (fstat(fd, &st) != 0) return 0;
+    long count = (long)(st.st_size / (off_t)sizeof(LeaderEntry));
+    if (count == 0) return 1;
+    LeaderEntry *entries = malloc((size_t)count * sizeof(LeaderEntry));
+    LeaderNode *pending = malloc((size_t)count * sizeof(LeaderNode));
+    size_t total = (size_t)count * sizeof(LeaderEntry), done = 0;
+    while (entries && pending && done < total) {
+        ssize_t got = pread(fd, (char *)entries + done, total - done, (off_t)done);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) break;
+        done += (size_t)got;
+    }
+    if (done < total) {
+        free(entries);
+        free(pending);
+        return 0;
+    }
+    for (long i = 0; i < count; i++) {
+        memset(&pending[i], 0, sizeof(LeaderNode));
+        pending[i].entry = entries[i];
+        pending[i].seq = (uint32_t)(board->disk_count + i);
+    }
+    free(entries);
+    qsort(pending, (size_t)count, sizeof(LeaderNode), compare_pending);
+    board->pending = pending;
+    board->pending_count = count;
+    return 1;
+}
+
+int leaderboard_open(Leaderboard *board, const char *path, long capacity) {
+    if (!init_board(board, path, capacity)) return 0;
+    char journal[sizeof(board->path) + 8];
+    journal_path(journal, sizeof(journal), path);
+    int journal_fd = open(journal, O_RDONLY);
+    if (journal_fd >= 0 && flock(journal_fd, LOCK_SH) != 0) {
+        close(journal_fd);
+        return 0;
+    }
+    int ok = map_disk(board) && (journal_fd < 0 || read_journal(board, journal_fd));
+    if (journal_fd >= 0) close(journal_fd);   // libère le verrou
+    return ok;
+}
+
+void leaderboard_close(Leaderboard *board) {
+    unmap_disk(board);
+    free(board->pending);
+    board->pending = NULL;
+    board->pending_count = 0;
+    free(board->nodes);
+    board->nodes = NULL;
+    board->loaded = 0;
+    board->count = 0;
+    board->root = -1;
+}
+
+static int write_entries(const Leaderboard *board, int node, FILE *file) {
+    if (node < 0) return 1;
+    const LeaderNode *n = &board->nodes[node];
+    return write_entries(board, n->left, file) && fwrite(&n->entry, sizeof(LeaderEntry), 1, file) == 1 &&
+           write_entries(board, n->right, file);
+}
+
+static int make_parent_dir(const char *path) {
+    char dir[256];
+    if (strlen(path) >= sizeof(dir)) return 0;
+    strcpy(dir, path);
+    char *slash = strrchr(dir, '/');
+    if (!slash || slash == dir) return 1;
+    *slash = '\0';
+    return mkdir(dir, 0755) == 0 || errno == EEXIST;
+}
+
+// Réécrit le classement dans un fichier temporaire synchronisé puis renommé :
+// un lecteur voit l'ancienne ou la nouvelle version, jamais un mélange, et la
+// nouvelle est sur disque avant que le journal fusionné soit vidé. Le
+// dossier est créé au besoin.
+int leaderboard_save(Leaderboard *board) {
+    if (!board->loaded || !board->dirty) return 1;
+    if (!make_parent_dir(board->path)) return 0;
+    char temp[sizeof(board->path) + 8];
+    snprintf(temp, sizeof(temp), "%s.XXXXXX", board->path);
+    int fd = mkstemp(temp);
+    if (fd < 0) return 0;
+    FILE *file = fdopen(fd, "wb");
+    if (!file) {
+        close(fd);
+        unlink(temp);
+        return 0;
+    }
+    LeaderHeader header = {{0}, sizeof(LeaderEntry), (uint32_t)board->count};
+    memcpy(header.magic, leader_magic, sizeof(header.magic));
+    int ok = fchmod(fd, 0644) == 0 && fwrite(&header, sizeof(header), 1, file) == 1 &&
+             write_entries(board, board->root, file) && fflush(file) == 0 && fsync(fd) == 0;
+    ok = fclose(file) == 0 && ok;
+    if (ok && rename(temp, board->path) == 0) {
+        board->dirty = 0;
+        return 1;
+    }
+    unlink(temp);
+    return 0;
+}
+
+// ===== ARBRE D'ORDRE STATISTIQUE =====
+
+static int node_size(const Leaderboard *board, int node) {
+    return node >= 0 ? board->nodes[node].size : 0;
+}
+
+// Ordre du classement : meilleur score d'abord, puis ordre d'arrivée
+static int ranks_before(const LeaderNode *a, const LeaderNode *b) {
+    return a->entry.score > b->entry.score || (a->entry.score == b->entry.score && a->seq < b->seq);
+}
+
+static int reserve_nodes(Leaderboard *board, long count) {
+    if (count <= board->node_capacity) return 1;
+    long capacity = board->node_capacity ? board->node_capacity : 64;
+    while (capacity < count) capacity *= 2;
+    if (capacity > board->capacity) capacity = board->capacity;
+    LeaderNode *nodes = realloc(board->nodes, (size_t)capacity * sizeof(LeaderNode));
+    if (!nodes) return 0;
+    board->nodes = nodes;
+    board->node_capacity = capacity;
+    return 1;
+}
+
+// Arbre équilibré depuis le tableau trié, en O(n). Les priorités imitent
+// celles d'un treap aléatoire de n nœuds : à la profondeur d, une valeur
+// tirée dans la tranche [2^d, 2^(d+1)) depuis le haut de l'intervalle, donc
+// toujours inférieure à celle du parent.
+static int build(Leaderboard *board, long lo, long hi, int depth, uint64_t gap) {
+    if (lo >= hi) return -1;
+    long mid = lo + (hi - lo) / 2;
+    LeaderNode *node = &board->nodes[mid];
+    node->entry = board->disk[mid];
+    node->seq = (uint32_t)mid;
+    uint64_t span = 1ull << depth;
+    node->priority = (uint32_t)(UINT32_MAX - gap * (span + leaderboard_rand(&board->rng) % span));
+    node->left = build(board, lo, mid, depth + 1, gap);
+    node->right = build(board, mid + 1, hi, depth + 1, gap);
+    node->size = (int)(hi - lo);
+    return (int)mid;
+}
+
+static long insert_entry(Leaderboard *board, const LeaderEntry *entry, uint32_t seq);
+
+// Le journal lu à l'ouverture rejoint l'arbre avec ses numéros d'arrivée.
+// En cas d'échec (mémoire), l'arbre est abandonné et le classement reste
+// lisible depuis le fichier projeté.
+static int load(Leaderboard *board) {
+    if (board->loaded) return 1;
+    long count = board->disk_count;
+    if (count > 0 && !reserve_nodes(board, count)) return 0;
+    board->root = build(board, 0, count, 0, UINT32_MAX / (2 * (uint64_t)count + 2));
+    board->count = count;
+    board->next_seq = (uint32_t)(count + board->pending_count);
+    board->loaded = 1;
+    for (long i = 0; i < board->pending_count; i++) {
+        if (insert_entry(board, &board->pending[i].entry, board->pending[i].seq) == 0 &&
+            board->count < board->capacity) {
+            free(board->nodes);
+            board->nodes = NULL;
+            board->node_capacity = 0;
+            board->count = 0;
+            board->root = -1;
+            board->loaded = 0;
+            return 0;
+        }
+    }
+    unmap_disk(board);
+    free(board->pending);
+    board->pending = NULL;
+    board->pending_count = 0;
+    return 1;
+}
+
+static int rotate_right(Leaderboard *board, int root) {
+    LeaderNode *nodes = board->nodes;
+    int left = nodes[root].left;
+    nodes[root].left = nodes[left].right;
+    nodes[left].right = root;
+    nodes[left].size = nodes[root].size;
+    nodes[root].size = node_size(board, nodes[root].left) + node_size(board, nodes[root].right) + 1;
+    return left;
+}
+
+static int rotate_left(Leaderboard *board, int root) {
+    LeaderNode *nodes = board->nodes;
+    int right = nodes[root].right;
+    nodes[root].right = nodes[right].left;
+    nodes[right].left = root;
+    nodes[right].size = nodes[root].size;
+    nodes[root].size = node_size(board, nodes[root].left) + node_size(board, nodes[root].right) + 1;
+    return right;
+}
+
+static int treap_insert(Leaderboard *board, int root, int node) {
+    if (root < 0) return node;
+    LeaderNode *nodes = board->nodes;
+    nodes[root].size++;
+    if (ranks_before(&nodes[node], &nodes[root])) {
+        nodes[root].left = treap_insert(board, nodes[root].left, node);
+        if (nodes[nodes[root].left].priority > nodes[root].priority) root = rotate_right(board, root);
+    } else {
+        nodes[root].right = treap_insert(board, nodes[root].right, node);
+        if (nodes[nodes[root].right].priority > nodes[root].priority) root = rotate_left(board, root);
+    }
+    return root;
+}
+
+// Retire la dernière entrée (nœud le plus à droite) et rend son emplacement
+static int remove_last(Leaderboard *board) {
+    LeaderNode *nodes = board->nodes;
+    int parent = -1, node = board->root;
+    while (nodes[node].right >= 0) {
+        nodes[node].size--;
+        parent = node;
+        node = nodes[node].right;
+    }
+    if (parent < 0) board->root = nodes[node].left;
+    else nodes[parent].right = nodes[node].left;
+    board->count--;
+    return node;
+}
+
+// ===== REQUÊTES =====
+
+long leaderboard_count(const Leaderboard *board) {
+    if (board->loaded) return board->count;
+    long count = board->disk_count + board->pending_count;
+    return count < board->capacity ? count : board->capacity;
+}
+
+// Entrées du fichier, puis du journal, dont le score est >= score
+static long disk_at_least(const Leaderboard *board, int score) {
+    long lo = 0, hi = board->disk_count;
+    while (lo < hi) {
+        long mid = lo + (hi - lo) / 2;
+        if (board->disk[mid].score >= score) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static long pending_at_least(const Leaderboard *board, int score) {
+    long lo = 0, hi = board->pending_count;
+    while (lo < hi) {
+        long mid = lo + (hi - lo) / 2;
+        if (board->pending[mid].entry.score >= score) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+long leaderboard_rank(const Leaderboard *board, int score) {
+    long better = 0;
+    if (!board->loaded) {
+        // Les entrées du journal au-delà de la capacité ne comptent pas
+        better = disk_at_least(board, score) + pending_at_least(board, score);
+        return (better < board->capacity ? better : board->capacity) + 1;
+    }
+    int node = board->root;
+    while (node >= 0) {
+        const LeaderNode *n = &board->nodes[node];
+        if (n->entry.score >= score) {
+            better += node_size(board, n->left) + 1;
+            node = n->right;
+        } else {
+            node = n->left;
+        }
+    }
+    return better + 1;
+}
+
+// k-ième entrée (à partir de 0) de la fusion du fichier et du journal, par
+// dichotomie sur le nombre i d'entrées prises dans le fichier. À score égal,
+// le fichier (plus ancien) passe devant.
+static const LeaderEntry *merged_entry(const Leaderboard *board, long k) {
+    long lo = k > board->pending_count ? k - board->pending_count : 0;
+    long hi = k < board->disk_count ? k : board->disk_count;
+    while (lo < hi) {
+        long i = lo + (hi - lo) / 2;
+        if (board->disk[i].score >= board->pending[k - i - 1].entry.score) lo = i + 1;
+        else hi = i;
+    }
+    long j = k - lo;
+    if (lo < board->disk_count && (j >= board->pending_count || board->disk[lo].score >= board->pending[j].entry.score))
+        return &board->disk[lo];
+    return &board->pending[j].entry;
+}
+
+int leaderboard_entry(const Leaderboard *board, long rank, LeaderEntry *out) {
+    if (rank < 1 || rank > leaderboard_count(board)) return 0;
+    if (!board->loaded) {
+        *out = *merged_entry(board, rank - 1);
+        return 1;
+    }
+    long k = rank - 1;
+    int node = board->root;
+    while (node >= 0) {
+        const LeaderNode *n = &board->nodes[node];
+        long left = node_size(board, n->left);
+        if (k < left) {
+            node = n->left;
+        } else if (k == left) {
+            *out = n->entry;
+            return 1;
+        } else {
+            k -= left + 1;
+            node = n->right;
+        }
+    }
+    return 0;
+}
+
+static long insert_entry(Leaderboard *board, const LeaderEntry *entry, uint32_t seq) {
+    long rank = leaderboard_rank(board, entry->score);
+    if (rank > board->capacity) return 0;
+    int slot;
+    if (board->count >= board->capacity) {
+        slot = remove_last(board);
+    } else {
+        if (!reserve_nodes(board, board->count + 1)) return 0;
+        slot = (int)board->count;
+    }
+    LeaderNode *node = &board->nodes[slot];
+    memset(node, 0, sizeof(*node));
+    node->entry = *entry;
+    node->seq = seq;
+    node->priority = leaderboard_rand(&board->rng);
+    node->left = node->right = -1;
+    node->size = 1;
+    board->root = treap_insert(board, board->root, slot);
+    board->count++;
+    board->dirty = 1;
+    return rank;
+}
+
+static void fill_entry(LeaderEntry *entry, int score, int level, const char *name, time_t date) {
+    memset(entry, 0, sizeof(*entry));
+    entry->score = score;
+    entry->level = level;
+    entry->date = (int64_t)date;
+    strncpy(entry->name, name, sizeof(entry->name) - 1);
+}
+
+long leaderboard_insert(Leaderboard *board, int score, int level, const char *name, time_t date) {
+    if (!load(board)) return 0;
+    LeaderEntry entry;
+    fill_entry(&entry, score, level, name, date);
+    return insert_entry(board, &entry, board->next_seq++);
+}
+
+// ===== PLUSIEURS PROCESSUS =====
+
+// Verrou exclusif du journal déjà pris : aucun ajout en cours
+static int compact_locked(const char *path, long capacity, int journal_fd) {
+    Leaderboard board;
+    int ok = init_board(&board, path, capacity) && map_disk(&board) && read_journal(&board, journal_fd);
+    if (ok && board.pending_count > 0) ok = load(&board) && leaderboard_save(&board);
+    if (ok) ok = ftruncate(journal_fd, 0) == 0;
+    leaderboard_close(&board);
+    return ok;
+}
+
+int leaderboard_compact(const char *path, long capacity) {
+    char journal[256 + 8];
+    if (strlen(path) >= 256) return 0;
+    journal_path(journal, sizeof(journal), path);
+    int fd = open(journal, O_RDWR);
+    if (fd < 0) return errno == ENOENT;
+    int ok = flock(fd, LOCK_EX) == 0 && compact_locked(path, capacity, fd);
+    close(fd);
+    return ok;
+}
+
+int leaderboard_submit(const char *path, long capacity, int score, int level, const char *name, time_t date) {
+    char journal[256 + 8];
+    if (strlen(path) >= 256 || !make_parent_dir(path)) return 0;
+    journal_path(journal, sizeof(journal), path);
+    int fd = open(journal, O_RDWR | O_APPEND | O_CREAT, 0644);
+    if (fd < 0) return 0;
+    LeaderEntry entry;
+    fill_entry(&entry, score, level, name, date);
+    struct stat st;
+    int ok = flock(fd, LOCK_SH) == 0 && write(fd, &entry, sizeof(entry)) == (ssize_t)sizeof(entry) &&
+             fstat(fd, &st) == 0;
+    // Le soumetteur qui remplit le journal le fusionne. flock ne convertit
+    // pas le verrou partagé en exclusif d'un coup : il le relâche puis attend
+    // l'exclusif, et d'autres ajouts ou une autre fusion peuvent passer entre
+    // les deux. La taille relue sous verrou exclusif décide donc de la fusion.
+    const off_t limit = (off_t)LEADERBOARD_COMPACT_EVERY * (off_t)sizeof(LeaderEntry);
+    if (ok && st.st_size >= limit && flock(fd, LOCK_EX) == 0 && fstat(fd, &st) == 0 && st.st_size >= limit)
+        compact_locked(path, capacity, fd);
+    close(fd);
+    return ok;
+}
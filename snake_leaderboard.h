@@ -0,0 +1,112 @@
+#ifndef SNAKE_LEADERBOARD_H
+#define SNAKE_LEADERBOARD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+// Classements par (mode, difficulté, nombre de joueurs) : un fichier par
+// classement dans LEADERBOARD_DIR, trié du meilleur au moins bon score
+// (en-tête de 16 octets puis LeaderEntry de 32 octets par rang).
+//
+// Chargement paresseux : leaderboard_open ne fait que projeter le fichier
+// (mmap). Rang d'un score et entrée d'un rang se lisent alors directement
+// dans le tableau trié (recherche dichotomique). Le premier ajout construit
+// en O(n) un arbre d'ordre statistique (treap dont chaque nœud connaît la
+// taille de son sous-arbre) : ajout, rang et entrée d'un rang en O(log n).
+//
+// À score égal, l'entrée la plus ancienne reste devant. Un classement plein
+// (capacité atteinte) refuse un score qui n'y entrerait qu'en dernier et
+// perd sa dernière entrée quand un meilleur score arrive.
+//
+// Plusieurs processus (tournois, bornes partageant un dossier) : les parties
+// soumettent leurs scores par leaderboard_submit, qui ajoute une entrée au
+// journal CHEMIN.journal par un write() de 32 octets en O_APPEND, sous verrou
+// flock partagé. Dès LEADERBOARD_COMPACT_EVERY entrées, le soumetteur
+// relâche ce verrou et attend le verrou exclusif (flock ne convertit pas
+// l'un en l'autre d'un coup) : d'autres ajouts, voire une autre fusion,
+// peuvent passer entre les deux, aussi relit-il la taille du journal sous
+// verrou exclusif avant de le fusionner dans le classement (fichier
+// temporaire synchronisé puis renommé) et de le vider. Tant qu'il tient le
+// verrou exclusif, aucun ajout ne peut se glisser entre la lecture et la
+// remise à zéro. leaderboard_open lit
+// le fichier et le journal sous verrou partagé, donc toujours une paire
+// cohérente, et compte les entrées du journal dans les rangs. Une panne
+// entre le renommage et la remise à zéro ne perd rien : les entrées du
+// journal seraient seulement comptées deux fois.
+//
+// leaderboard_insert et leaderboard_save réécrivent le fichier sans tenir
+// compte des autres processus : réservés à un propriétaire unique (outils,
+// bancs d'essai).
+
+// ===== CONSTANTES =====
+#define LEADERBOARD_DIR ".snake_leaderboards"
+#define LEADERBOARD_CAPACITY 100000
+#define LEADERBOARD_COMPACT_EVERY 256   // entrées du journal avant fusion
+
+// ===== STRUCTURES =====
+typedef struct {
+    int32_t score;
+    int32_t level;
+    int64_t date;
+    char name[16];
+} LeaderEntry;
+
+typedef struct {
+    LeaderEntry entry;
+    uint32_t seq;           // ordre d'arrivée, départage les scores égaux
+    uint32_t priority;      // tas du treap : un parent a une priorité plus grande
+    int left;               // -1 : aucun
+    int right;
+    int size;               // nœuds du sous-arbre
+} LeaderNode;
+
+typedef struct {
+    char path[256];
+    long capacity;
+
+    // Fichier projeté, tant que l'arbre n'est pas construit
+    int fd;
+    const unsigned char *base;
+    size_t size;
+    const LeaderEntry *disk;
+    long disk_count;
+
+    // Journal lu à l'ouverture, trié comme le classement (seq après le fichier)
+    LeaderNode *pending;
+    long pending_count;
+
+    // Arbre (loaded = 1)
+    int loaded;
+    LeaderNode *nodes;
+    long node_capacity;
+    long count;
+    int root;
+    uint32_t next_seq;
+    unsigned int rng;
+    int dirty;
+} Leaderboard;
+
+// ===== PROTOTYPES =====
+// mode et difficulty : valeurs de GameMode et Difficulty
+void leaderboard_path(char *out, size_t size, const char *dir, int mode, int difficulty, int players);
+int leaderboard_open(Leaderboard *board, const char *path, long capacity);
+void leaderboard_close(Leaderboard *board);
+int leaderboard_save(Leaderboard *board);
+
+long leaderboard_count(const Leaderboard *board);
+// Rang (1 = meilleur) qu'obtiendrait `score` s'il était ajouté maintenant
+long leaderboard_rank(const Leaderboard *board, int score);
+int leaderboard_entry(const Leaderboard *board, long rank, LeaderEntry *out);
+// Nom inscrit au classement : `name` s'il est donné, sinon $USER, sinon
+// "Player" ; tronqué à size - 1 caractères
+void leaderboard_player_name(char *out, size_t size, const char *name);
+// Retourne le rang obtenu, 0 si le score est refusé (classement plein)
+long leaderboard_insert(Leaderboard *board, int score, int level, const char *name, time_t date);
+
+// Ajout sûr entre processus (journal puis fusion périodique)
+int leaderboard_submit(const char *path, long capacity, int score, int level, const char *name, time_t date);
+// Fusionne tout de suite le journal dans le classement
+int leaderboard_compact(const char *path, long capacity);
+
+#endif
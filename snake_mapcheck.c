@@ -0,0 +1,183 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "snake_core.h"
+#include "snake_mapgen.h"
+
+// Outil de validation des cartes du mode défi.
+//
+//   ./snake_mapcheck [--seeds A-B] [--difficulty easy|medium|hard|extreme|all] [--legacy]
+//   ./snake_mapcheck --size WxH [--density D] [--pattern scatter|segments|blocks] [--seeds A-B]
+//
+// Pour chaque graine, rejoue la génération du jeu (srand(graine) puis init_game)
+// et vérifie que toutes les cases vides sont connectées et que chaque portail
+// mène à une case vide. --legacy rejoue l'ancien générateur pour comparaison.
+// Code de retour 1 si au moins une carte est invalide.
+
+static const char *difficulty_names[] = {"easy", "medium", "hard", "extreme"};
+
+// Ancien generate_obstacles : murs et portails aléatoires, sans contrainte.
+static void legacy_generate(Game *game) {
+    int count = (game->grid_width * game->grid_height) / 50;
+    if (count > 50) count = 50;
+    tilemap_clear(&game->map);
+    game->obstacle_count = 0;
+    for (int i = 0; i < count; i++) {
+        Position pos;
+        int attempts = 0;
+        do {
+            pos = generate_random_position(game);
+            attempts++;
+        } while (!is_position_valid(game, pos, 0) && attempts < 100);
+        if (attempts >= 100) continue;
+        if (rand() % 10 < 2) {
+            Position dest;
+            int dest_attempts = 0;
+            do {
+                dest = generate_random_position(game);
+                dest_attempts++;
+            } while ((dest.x == pos.x && dest.y == pos.y) && dest_attempts < 50);
+            if (tilemap_add_portal(&game->map, pos, dest) < 0) continue;
+        } else {
+            tilemap_set_wall(&game->map, pos);
+        }
+        game->obstacle_count++;
+    }
+}
+
+typedef struct {
+    int maps;
+    int disconnected;
+    int portal_errors;
+    long sealed_cells;
+    double seconds;
+} CheckTotals;
+
+static void account(CheckTotals *totals, const TileMap *map) {
+    MapReport report;
+    mapgen_check(map, &report);
+    totals->maps++;
+    if (report.components > 1) {
+        totals->disconnected++;
+        totals->sealed_cells += report.free_cells - report.largest;
+    }
+    if (report.portals_blocked > 0) totals->portal_errors++;
+}
+
+static void print_totals(const char *label, const CheckTotals *totals) {
+    printf("%-28s %7d %14d %14d %14ld %10.2f\n", label, totals->maps, totals->disconnected,
+           totals->portal_errors, totals->sealed_cells,
+           totals->maps ? totals->seconds * 1000.0 / totals->maps : 0);
+}
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int first = 1, last = 1000;
+    int difficulty = -1;
+    int legacy = 0;
+    int width = 0, height = 0;
+    MapGenParams params;
+    mapgen_default_params(&params);
+    params.density = 0.2;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seeds") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%u-%u", &first, &last) == 1) last = first;
+        } else if (strcmp(argv[i], "--difficulty") == 0 && i + 1 < argc) {
+            i++;
+            difficulty = -1;
+            for (int d = 0; d < 4; d++) {
+                if (strcmp(argv[i], difficulty_names[d]) == 0) difficulty = d;
+            }
+            if (difficulty < 0 && strcmp(argv[i], "all") != 0) {
+                fprintf(stderr, "Difficulté inconnue : %s\n", argv[i]);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--legacy") == 0) {
+            legacy = 1;
+        } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0) {
+                fprintf(stderr, "Taille invalide : %s\n", argv[i]);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--density") == 0 && i + 1 < argc) {
+            params.density = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--pattern") == 0 && i + 1 < argc) {
+            i++;
+            int found = 0;
+            for (int p = 0; p < MAPGEN_PATTERN_COUNT; p++) {
+                if (strcmp(argv[i], mapgen_pattern_name((MapPattern)p)) == 0) {
+                    params.pattern = (MapPattern)p;
+                    found = 1;
+                }
+            }
+            if (!found) {
+                fprintf(stderr, "Motif inconnu : %s\n", argv[i]);
+                return 2;
+            }
+        } else {
+            fprintf(stderr, "Usage : %s [--seeds A-B] [--difficulty D|all] [--legacy]\n"
+                            "        %s --size WxH [--density D] [--pattern P] [--seeds A-B]\n",
+                    argv[0], argv[0]);
+            return 2;
+        }
+    }
+    if (last < first) last = first;
+
+    printf("%-28s %7s %14s %14s %14s %10s\n", "carte", "graines", "non connexes",
+           "portail bloqué", "cases isolées", "ms/carte");
+    int failures = 0;
+
+    if (width > 0) {
+        TileMap map;
+        if (!tilemap_init(&map, width, height)) {
+            fprintf(stderr, "Erreur : allocation de la carte\n");
+            return 2;
+        }
+        CheckTotals totals = {0};
+        for (unsigned int seed = first; seed <= last; seed++) {
+            params.seed = seed;
+            double start = now_seconds();
+            mapgen_generate(&map, &params);
+            totals.seconds += now_seconds() - start;
+            account(&totals, &map);
+        }
+        char label[64];
+        snprintf(label, sizeof(label), "%dx%d %s %.2f", width, height,
+                 mapgen_pattern_name(params.pattern), params.density);
+        print_totals(label, &totals);
+        failures += totals.disconnected + totals.portal_errors;
+        tilemap_free(&map);
+        return failures ? 1 : 0;
+    }
+
+    for (int d = 0; d < 4; d++) {
+        if (difficulty >= 0 && d != difficulty) continue;
+        CheckTotals totals = {0};
+        for (unsigned int seed = first; seed <= last; seed++) {
+            Game game;
+            srand(seed);
+            double start = now_seconds();
+            if (!init_game(&game, MODE_CHALLENGE, (Difficulty)d, 0)) {
+                fprintf(stderr, "Erreur : mémoire insuffisante pour la carte\n");
+                return 1;
+            }
+            if (legacy) legacy_generate(&game);
+            totals.seconds += now_seconds() - start;
+            account(&totals, &game.map);
+            free_game(&game);
+        }
+        char label[64];
+        snprintf(label, sizeof(label), "défi %s%s", difficulty_names[d], legacy ? " (ancien)" : "");
+        print_totals(label, &totals);
+        failures += totals.disconnected + totals.portal_errors;
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,268 @@
+#define _DEFAULT_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include "snake_mapgen.h"
+
+// ===== PARAMÈTRES =====
+
+void mapgen_default_params(MapGenParams *params) {
+    memset(params, 0, sizeof(*params));
+    params->pattern = MAPGEN_SCATTER;
+    params->density = 0.02;
+    params->portal_ratio = 0.2;
+    params->seed = 1;
+    params->clear_x0 = 1;  // x0 > x1 : pas de zone réservée
+    params->clear_x1 = 0;
+}
+
+const char *mapgen_pattern_name(MapPattern pattern) {
+    switch (pattern) {
+        case MAPGEN_SCATTER: return "scatter";
+        case MAPGEN_SEGMENTS: return "segments";
+        case MAPGEN_BLOCKS: return "blocks";
+        default: return "?";
+    }
+}
+
+// ===== RÈGLE LOCALE =====
+
+static int is_free(const TileMap *map, int x, int y) {
+    return x >= 0 && x < map->width && y >= 0 && y < map->height &&
+           map->tiles[y * map->width + x] == TILE_EMPTY;
+}
+
+// Vrai si bloquer (x, y) garde ses voisines libres connectées entre elles.
+// L'anneau est parcouru dans l'ordre N, NE, E, SE, S, SO, O, NO : deux cases
+// consécutives sont voisines, donc chaque suite de cases libres est connexe.
+// Il suffit qu'une seule de ces suites contienne des voisines directes.
+static int can_block(const TileMap *map, int x, int y) {
+    static const int dx[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+    static const int dy[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+    int ring[8];
+    int start = -1;
+    for (int i = 0; i < 8; i++) {
+        ring[i] = is_free(map, x + dx[i], y + dy[i]);
+        if (!ring[i] && start < 0) start = i;
+    }
+    if (start < 0) return 1;
+
+    int runs = 0, in_run = 0, has_neighbor = 0;
+    for (int k = 1; k <= 8; k++) {
+        int i = (start + k) % 8;
+        if (ring[i]) {
+            in_run = 1;
+            if (i % 2 == 0) has_neighbor = 1;
+        } else {
+            if (in_run && has_neighbor) runs++;
+            in_run = 0;
+            has_neighbor = 0;
+        }
+    }
+    return runs <= 1;
+}
+
+static int in_clear_zone(const MapGenParams *params, int x, int y) {
+    return x >= params->clear_x0 && x <= params->clear_x1 &&
+           y >= params->clear_y0 && y <= params->clear_y1;
+}
+
+static int is_reserved(const unsigned char *reserved, long idx) {
+    return reserved && (reserved[idx >> 3] & (1 << (idx & 7)));
+}
+
+static int can_place(const TileMap *map, const MapGenParams *params,
+                     const unsigned char *reserved, int x, int y) {
+    if (!is_free(map, x, y) || in_clear_zone(params, x, y)) return 0;
+    if (is_reserved(reserved, (long)y * map->width + x)) return 0;
+    return can_block(map, x, y);
+}
+
+// ===== GÉNÉRATION =====
+
+static long place_walls(TileMap *map, const MapGenParams *params, long target, unsigned int *rng) {
+    long placed = 0;
+    long attempts = 0;
+    long max_attempts = target * 8 + 64;
+    int w = map->width, h = map->height;
+
+    while (placed < target && attempts < max_attempts) {
+        int x = snake_rand(rng) % w;
+        int y = snake_rand(rng) % h;
+        int cw = 1, ch = 1;
+        switch (params->pattern) {
+            case MAPGEN_SEGMENTS:
+                if (snake_rand(rng) & 1) cw = 3 + snake_rand(rng) % 10;
+                else ch = 3 + snake_rand(rng) % 10;
+                break;
+            case MAPGEN_BLOCKS:
+                cw = 2 + snake_rand(rng) % 3;
+                ch = 2 + snake_rand(rng) % 3;
+                break;
+            default:
+                break;
+        }
+        for (int by = y; by < y + ch && by < h && placed < target; by++) {
+            for (int bx = x; bx < x + cw && bx < w && placed < target; bx++) {
+                attempts++;
+                if (can_place(map, params, NULL, bx, by) && tilemap_set_wall(map, (Position){bx, by})) {
+                    placed++;
+                }
+            }
+        }
+    }
+    return placed;
+}
+
+// Les destinations sont des cases vides réservées : aucun portail posé plus
+// tard ne peut les recouvrir. Un portail bloque sa propre case comme un mur
+// (il ne fait qu'ajouter un raccourci), la règle locale s'applique donc aussi.
+static long place_portals(TileMap *map, const MapGenParams *params, long target, unsigned int *rng) {
+    if (target <= 0) return 0;
+    long cells = (long)map->width * map->height;
+    unsigned char *reserved = calloc(cells / 8 + 1, 1);
+    if (!reserved) return 0;
+
+    long placed = 0;
+    long attempts = 0;
+    long max_attempts = target * 8 + 64;
+    while (placed < target && attempts < max_attempts) {
+        attempts++;
+        Position pos = {snake_rand(rng) % map->width, snake_rand(rng) % map->height};
+        if (!can_place(map, params, reserved, pos.x, pos.y)) continue;
+
+        Position dest;
+        int found = 0;
+        for (int i = 0; i < 32 && !found; i++) {
+            dest.x = snake_rand(rng) % map->width;
+            dest.y = snake_rand(rng) % map->height;
+            found = is_free(map, dest.x, dest.y) && (dest.x != pos.x || dest.y != pos.y);
+        }
+        if (!found) continue;
+        if (tilemap_add_portal(map, pos, dest) < 0) break;
+        long idx = (long)dest.y * map->width + dest.x;
+        reserved[idx >> 3] |= 1 << (idx & 7);
+        placed++;
+    }
+    free(reserved);
+    return placed;
+}
+
+// Retourne le nombre d'obstacles posés (murs + portails).
+int mapgen_generate(TileMap *map, const MapGenParams *params) {
+    tilemap_clear(map);
+    long cells = (long)map->width * map->height;
+    long target = (long)(params->density * cells);
+    if (params->max_obstacles > 0 && target > params->max_obstacles) target = params->max_obstacles;
+    long portal_target = (long)(target * params->portal_ratio);
+
+    unsigned int rng = params->seed ? params->seed : 1;
+    long walls = place_walls(map, params, target - portal_target, &rng);
+    long portals = place_portals(map, params, portal_target, &rng);
+    return (int)(walls + portals);
+}
+
+// ===== VÉRIFICATION =====
+
+typedef struct {
+    int start;
+    int end;  // exclu
+    int label;
+} Run;
+
+static int find_root(int *parent, int a) {
+    while (parent[a] != a) {
+        parent[a] = parent[parent[a]];
+        a = parent[a];
+    }
+    return a;
+}
+
+static void join(int *parent, long *size, int a, int b) {
+    a = find_root(parent, a);
+    b = find_root(parent, b);
+    if (a == b) return;
+    if (size[a] < size[b]) {
+        int tmp = a;
+        a = b;
+        b = tmp;
+    }
+    parent[b] = a;
+    size[a] += size[b];
+}
+
+// Union-find sur les segments de cases vides de chaque ligne : un segment
+// est uni à ceux de la ligne précédente qui le chevauchent (4-connexité).
+// Retourne 1 si la carte est valide (au plus une composante, portails vers
+// des cases vides), 0 sinon.
+int mapgen_check(const TileMap *map, MapReport *report) {
+    memset(report, 0, sizeof(*report));
+    int w = map->width;
+    Run *prev = malloc(((w + 1) / 2 + 1) * sizeof(Run));
+    Run *cur = malloc(((w + 1) / 2 + 1) * sizeof(Run));
+    int *parent = NULL;
+    long *size = NULL;
+    int label_count = 0, label_capacity = 0;
+    int prev_count = 0;
+    int ok = prev && cur;
+
+    for (int y = 0; y < map->height && ok; y++) {
+        const Tile *row = map->tiles + (long)y * w;
+        int cur_count = 0;
+        int j = 0;
+        int x = 0;
+        while (x < w) {
+            if (row[x] != TILE_EMPTY) {
+                x++;
+                continue;
+            }
+            int start = x;
+            while (x < w && row[x] == TILE_EMPTY) x++;
+
+            if (label_count == label_capacity) {
+                label_capacity = label_capacity ? label_capacity * 2 : 1024;
+                int *p = realloc(parent, label_capacity * sizeof(int));
+                if (p) parent = p;
+                long *s = realloc(size, label_capacity * sizeof(long));
+                if (s) size = s;
+                if (!p || !s) {
+                    ok = 0;
+                    break;
+                }
+            }
+            int label = label_count++;
+            parent[label] = label;
+            size[label] = x - start;
+            report->free_cells += x - start;
+
+            while (j < prev_count && prev[j].end <= start) j++;
+            for (int k = j; k < prev_count && prev[k].start < x; k++) {
+                join(parent, size, label, prev[k].label);
+            }
+            cur[cur_count++] = (Run){start, x, label};
+        }
+        Run *tmp = prev;
+        prev = cur;
+        cur = tmp;
+        prev_count = cur_count;
+    }
+
+    if (ok) {
+        for (int i = 0; i < label_count; i++) {
+            if (parent[i] != i) continue;
+            report->components++;
+            if (size[i] > report->largest) report->largest = size[i];
+        }
+        for (int i = 0; i < map->portal_count; i++) {
+            Position dest = map->portal_dest[i];
+            if (!is_free(map, dest.x, dest.y)) report->portals_blocked++;
+        }
+    } else {
+        report->components = -1;
+    }
+
+    free(prev);
+    free(cur);
+    free(parent);
+    free(size);
+    return ok && report->components <= 1 && report->portals_blocked == 0;
+}
@@ -0,0 +1,47 @@
+#ifndef SNAKE_MAPGEN_H
+#define SNAKE_MAPGEN_H
+
+#include "snake_core.h"
+
+// Génération procédurale d'obstacles sous contrainte de connexité.
+//
+// Une case n'est bloquée (mur ou portail) que si ses voisines libres restent
+// reliées entre elles par l'anneau des 8 cases qui l'entourent : tout chemin
+// qui passait par elle peut la contourner, donc les cases libres restent
+// toutes connectées, sans poche fermée. La vérification globale se fait par
+// union-find sur les segments libres de chaque ligne.
+// Les identifiants de portail tiennent sur une tuile : au plus 65533 portails.
+
+// ===== ENUMS =====
+typedef enum {
+    MAPGEN_SCATTER = 0,   // cases isolées
+    MAPGEN_SEGMENTS,      // segments horizontaux / verticaux
+    MAPGEN_BLOCKS,        // blocs rectangulaires
+    MAPGEN_PATTERN_COUNT
+} MapPattern;
+
+// ===== STRUCTURES =====
+typedef struct {
+    MapPattern pattern;
+    double density;         // part des cases à bloquer (0..0.6 environ)
+    double portal_ratio;    // part des obstacles qui sont des portails
+    int max_obstacles;      // 0 : pas de limite
+    unsigned int seed;
+    // Zone laissée libre (apparition des serpents), bornes incluses ; x0 > x1 : aucune
+    int clear_x0, clear_y0, clear_x1, clear_y1;
+} MapGenParams;
+
+typedef struct {
+    int components;         // composantes 4-connexes de cases vides
+    long free_cells;
+    long largest;           // taille de la plus grande composante
+    int portals_blocked;    // destinations de portail qui ne sont pas des cases vides
+} MapReport;
+
+// ===== PROTOTYPES =====
+void mapgen_default_params(MapGenParams *params);
+int mapgen_generate(TileMap *map, const MapGenParams *params);
+int mapgen_check(const TileMap *map, MapReport *report);
+const char *mapgen_pattern_name(MapPattern pattern);
+
+#endif
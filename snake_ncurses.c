@@ -5,6 +5,8 @@
 #include <time.h>
 #include <unistd.h>
 #include <ncurses.h>
+#include "snake_stream.h"
+#include "snake_leaderboard.h"
 
 // ===== CONSTANTES =====
 #define WIDTH 60
@@ -14,6 +16,7 @@
 #define MAX_FOOD 5
 #define MAX_TOP_SCORES 10
 #define POWERUP_DURATION 100  // nombre de mouvements
+#define TURN_QUEUE_SIZE 3      // virages mémorisés entre deux mouvements
 
 // ===== ENUMS =====
 typedef enum {
@@ -91,6 +94,8 @@ typedef struct {
     Position body[MAX_LENGTH];
     int length;
     Direction direction;
+    Direction turns[TURN_QUEUE_SIZE];  // virages en attente, un appliqué par mouvement
+    int turn_count;
     char head_char;
     char body_char;
     int color_head;
@@ -177,6 +182,13 @@ typedef struct {
 #define COLOR_TEXT 13
 #define COLOR_PORTAL 14
 
+// Nom inscrit au classement (--name, sinon $USER, sinon "Player")
+static char player_name[16] = "Player";
+
+// Flux spectateur (--stream) : NULL si désactivé
+static StreamWriter *spectator_stream = NULL;
+static StreamFrame *spectator_frame = NULL;
+
 // ===== PROTOTYPES =====
 void init_colors();
 void init_theme_colors(Theme theme);
@@ -202,10 +214,11 @@ void show_top_scores(Game *game);
 int show_game_over(Game *game);
 void game_loop(Game *game);
 void load_top_scores(Game *game);
-void save_top_scores(Game *game);
 void add_top_score(Game *game, int score);
-char* get_food_char(FoodType type);
-char* get_powerup_char(PowerUpType type);
+void publish_stream(Game *game, unsigned long tick);
+void draw_stream_frame(WINDOW *win, const StreamFrame *frame);
+void view_stream(const char *target);
+int bench_draw(int frames);
 
 // ===== IMPLÉMENTATION =====
 void init_colors() {
@@ -328,6 +341,7 @@ int is_position_valid(Game *game, Position pos, int check_snake) {
 void init_snake(Snake *snake, int start_x, int start_y, int player_num) {
     snake->length = 3;
     snake->direction = RIGHT;
+    snake->turn_count = 0;
     snake->lives = (player_num == 1) ? 3 : 3;
     snake->score = 0;
     snake->multiplier = 1;
@@ -517,9 +531,34 @@ void generate_obstacles(Game *game) {
     }
 }
 
+// ===== VIRAGES =====
+// Même file que queue_turn / next_turn du noyau : les touches lues entre deux
+// mouvements sont gardées dans l'ordre au lieu d'écraser la direction, et un
+// virage est comparé au dernier virage en attente, donc Haut puis Bas dans le
+// même tick ne retourne pas le serpent sur lui-même.
+
+static void queue_turn(Snake *snake, Direction direction) {
+    Direction last = snake->turn_count > 0 ? snake->turns[snake->turn_count - 1] : snake->direction;
+    if (direction == last || direction == (last + 2) % 4) return;
+    if (snake->turn_count >= TURN_QUEUE_SIZE) return;
+    snake->turns[snake->turn_count++] = direction;
+}
+
+static void next_turn(Snake *snake) {
+    while (snake->turn_count > 0) {
+        Direction direction = snake->turns[0];
+        snake->turn_count--;
+        memmove(snake->turns, snake->turns + 1, snake->turn_count * sizeof(Direction));
+        if (direction == snake->direction || direction == (snake->direction + 2) % 4) continue;
+        snake->direction = direction;
+        return;
+    }
+}
+
 void move_snake(Game *game, Snake *snake) {
     if (game->paused || game->game_over) return;
     
+    next_turn(snake);
     Position head = snake->body[0];
     
     switch (snake->direction) {
@@ -808,26 +847,22 @@ void handle_input(Game *game) {
         case KEY_UP:
         case 'w':
         case 'W':
-            if (game->snake1.direction != DOWN)
-                game->snake1.direction = UP;
+            queue_turn(&game->snake1, UP);
             break;
         case KEY_RIGHT:
         case 'd':
         case 'D':
-            if (game->snake1.direction != LEFT)
-                game->snake1.direction = RIGHT;
+            queue_turn(&game->snake1, RIGHT);
             break;
         case KEY_DOWN:
         case 's':
         case 'S':
-            if (game->snake1.direction != UP)
-                game->snake1.direction = DOWN;
+            queue_turn(&game->snake1, DOWN);
             break;
         case KEY_LEFT:
         case 'a':
         case 'A':
-            if (game->snake1.direction != RIGHT)
-                game->snake1.direction = LEFT;
+            queue_turn(&game->snake1, LEFT);
             break;
         case 'p':
         case 'P':
@@ -848,43 +883,35 @@ void handle_input_multiplayer(Game *game) {
     switch (ch) {
         case 'w':
         case 'W':
-            if (game->snake1.direction != DOWN)
-                game->snake1.direction = UP;
+            queue_turn(&game->snake1, UP);
             break;
         case 'd':
         case 'D':
-            if (game->snake1.direction != LEFT)
-                game->snake1.direction = RIGHT;
+            queue_turn(&game->snake1, RIGHT);
             break;
         case 's':
         case 'S':
-            if (game->snake1.direction != UP)
-                game->snake1.direction = DOWN;
+            queue_turn(&game->snake1, DOWN);
             break;
         case 'a':
         case 'A':
-            if (game->snake1.direction != RIGHT)
-                game->snake1.direction = LEFT;
+            queue_turn(&game->snake1, LEFT);
             break;
     }
     
     // Joueur 2 (Flèches)
     switch (ch) {
         case KEY_UP:
-            if (game->snake2.direction != DOWN)
-                game->snake2.direction = UP;
+            queue_turn(&game->snake2, UP);
             break;
         case KEY_RIGHT:
-            if (game->snake2.direction != LEFT)
-                game->snake2.direction = RIGHT;
+            queue_turn(&game->snake2, RIGHT);
             break;
         case KEY_DOWN:
-            if (game->snake2.direction != UP)
-                game->snake2.direction = DOWN;
+            queue_turn(&game->snake2, DOWN);
             break;
         case KEY_LEFT:
-            if (game->snake2.direction != RIGHT)
-                game->snake2.direction = LEFT;
+            queue_turn(&game->snake2, LEFT);
             break;
     }
     
@@ -897,103 +924,97 @@ void handle_input_multiplayer(Game *game) {
     }
 }
 
-char* get_food_char(FoodType type) {
-    switch (type) {
-        case FOOD_NORMAL: return "*";
-        case FOOD_GOLDEN: return "$";
-        case FOOD_POISON: return "X";
-        case FOOD_FAST: return "!";
-        case FOOD_BONUS: return "?";
-        default: return "*";
+// ===== RENDU PAR LIGNES =====
+
+// La grille est composée dans un tampon de chtype (caractère | paire de
+// couleurs | attributs) puis envoyée ligne par ligne avec mvwaddchnstr : ni
+// wattron/wattroff ni formatage printf par élément affiché.
+#define MAX_GRID_WIDTH 80
+#define MAX_GRID_HEIGHT 30
+
+static chtype grid_cells[MAX_GRID_HEIGHT][MAX_GRID_WIDTH];
+
+// Glyphes précalculés, indexés par FoodType et PowerUpType
+static const chtype food_glyphs[FOOD_BONUS + 1] = {
+    '*' | COLOR_PAIR(COLOR_FOOD_NORMAL),
+    '$' | COLOR_PAIR(COLOR_FOOD_GOLDEN),
+    'X' | COLOR_PAIR(COLOR_FOOD_POISON),
+    '!' | COLOR_PAIR(COLOR_FOOD_FAST),
+    '?' | COLOR_PAIR(COLOR_FOOD_BONUS)
+};
+
+static const chtype powerup_glyphs[POWERUP_MAGNETIC + 1] = {
+    'P' | COLOR_PAIR(COLOR_POWERUP) | A_BOLD,
+    'S' | COLOR_PAIR(COLOR_POWERUP) | A_BOLD,
+    'I' | COLOR_PAIR(COLOR_POWERUP) | A_BOLD,
+    'M' | COLOR_PAIR(COLOR_POWERUP) | A_BOLD,
+    'G' | COLOR_PAIR(COLOR_POWERUP) | A_BOLD
+};
+
+static const chtype obstacle_glyphs[2] = {
+    '#' | COLOR_PAIR(COLOR_OBSTACLE),
+    'O' | COLOR_PAIR(COLOR_PORTAL)
+};
+
+// Dimensions composées : la grille, bornée au tampon et à la fenêtre
+static void grid_begin(WINDOW *win, int grid_width, int grid_height, int *width, int *height) {
+    *width = grid_width < MAX_GRID_WIDTH ? grid_width : MAX_GRID_WIDTH;
+    *height = grid_height < MAX_GRID_HEIGHT ? grid_height : MAX_GRID_HEIGHT;
+    if (*width > getmaxx(win) - 2) *width = getmaxx(win) - 2;
+    if (*height > getmaxy(win) - 2) *height = getmaxy(win) - 2;
+    for (int y = 0; y < *height; y++) {
+        for (int x = 0; x < *width; x++) grid_cells[y][x] = ' ';
     }
 }
 
-char* get_powerup_char(PowerUpType type) {
-    switch (type) {
-        case POWERUP_SLOW: return "S";
-        case POWERUP_INVINCIBLE: return "I";
-        case POWERUP_MULTIPLIER: return "M";
-        case POWERUP_MAGNETIC: return "G";
-        default: return "P";
-    }
+static inline void grid_put(int width, int height, int x, int y, chtype ch) {
+    if (x >= 0 && x < width && y >= 0 && y < height) grid_cells[y][x] = ch;
+}
+
+// Bordure puis lignes de la grille ; chaque ligne est réécrite en entier,
+// donc sans werase préalable.
+static void grid_flush(WINDOW *win, int width, int height) {
+    wattron(win, COLOR_PAIR(COLOR_BORDER));
+    box(win, 0, 0);
+    wattroff(win, COLOR_PAIR(COLOR_BORDER));
+    for (int y = 0; y < height; y++) mvwaddchnstr(win, y + 1, 1, grid_cells[y], width);
 }
 
 void draw_game(Game *game) {
-    werase(game->win);
-    box(game->win, 0, 0);
-    
-    wattron(game->win, COLOR_PAIR(COLOR_BORDER));
-    box(game->win, 0, 0);
-    wattroff(game->win, COLOR_PAIR(COLOR_BORDER));
+    int width, height;
+    grid_begin(game->win, game->grid_width, game->grid_height, &width, &height);
     
-    // Dessiner obstacles
+    // Obstacles
     for (int i = 0; i < game->obstacle_count; i++) {
-        int color = (game->obstacles[i].type == 2) ? COLOR_PORTAL : COLOR_OBSTACLE;
-        wattron(game->win, COLOR_PAIR(color));
-        char ch = (game->obstacles[i].type == 2) ? 'O' : '#';
-        mvwaddch(game->win, game->obstacles[i].pos.y + 1,
-                 game->obstacles[i].pos.x + 1, ch);
-        wattroff(game->win, COLOR_PAIR(color));
+        grid_put(width, height, game->obstacles[i].pos.x, game->obstacles[i].pos.y,
+                 obstacle_glyphs[game->obstacles[i].type == 2]);
     }
     
-    // Dessiner nourriture
+    // Nourriture (en gras au début de son animation)
     for (int i = 0; i < game->food_count; i++) {
-        int color_pair;
-        switch (game->foods[i].type) {
-            case FOOD_NORMAL: color_pair = COLOR_FOOD_NORMAL; break;
-            case FOOD_GOLDEN: color_pair = COLOR_FOOD_GOLDEN; break;
-            case FOOD_POISON: color_pair = COLOR_FOOD_POISON; break;
-            case FOOD_FAST: color_pair = COLOR_FOOD_FAST; break;
-            case FOOD_BONUS: color_pair = COLOR_FOOD_BONUS; break;
-            default: color_pair = COLOR_FOOD_NORMAL; break;
-        }
-        
-        wattron(game->win, COLOR_PAIR(color_pair));
-        if (game->foods[i].pulse < 5) {
-            wattron(game->win, A_BOLD);
-        }
-        mvwprintw(game->win, game->foods[i].pos.y + 1,
-                  game->foods[i].pos.x + 1, "%s", get_food_char(game->foods[i].type));
-        wattroff(game->win, A_BOLD);
-        wattroff(game->win, COLOR_PAIR(color_pair));
+        chtype glyph = food_glyphs[game->foods[i].type <= FOOD_BONUS ? game->foods[i].type : FOOD_NORMAL];
+        grid_put(width, height, game->foods[i].pos.x, game->foods[i].pos.y,
+                 glyph | (game->foods[i].pulse < 5 ? A_BOLD : 0));
     }
     
-    // Dessiner power-up
+    // Power-up
     if (game->powerup.active) {
-        wattron(game->win, COLOR_PAIR(COLOR_POWERUP) | A_BOLD);
-        mvwprintw(game->win, game->powerup.pos.y + 1,
-                  game->powerup.pos.x + 1, "%s", get_powerup_char(game->powerup.type));
-        wattroff(game->win, A_BOLD);
-        wattroff(game->win, COLOR_PAIR(COLOR_POWERUP));
-    }
-    
-    // Dessiner serpent 1
-    for (int i = 0; i < game->snake1.length; i++) {
-        int color = (i == 0) ? game->snake1.color_head : game->snake1.color_body;
-        wattron(game->win, COLOR_PAIR(color));
-        if (i == 0 && game->invincible_timer > 0) {
-            wattron(game->win, A_BOLD | A_BLINK);
-        }
-        char ch = (i == 0) ? game->snake1.head_char : game->snake1.body_char;
-        mvwaddch(game->win, game->snake1.body[i].y + 1,
-                 game->snake1.body[i].x + 1, ch);
-        if (i == 0 && game->invincible_timer > 0) {
-            wattroff(game->win, A_BOLD | A_BLINK);
-        }
-        wattroff(game->win, COLOR_PAIR(color));
+        grid_put(width, height, game->powerup.pos.x, game->powerup.pos.y,
+                 powerup_glyphs[game->powerup.type <= POWERUP_MAGNETIC ? game->powerup.type : POWERUP_NONE]);
     }
     
-    // Dessiner serpent 2 (multijoueur)
-    if (game->multiplayer) {
-        for (int i = 0; i < game->snake2.length; i++) {
-            int color = (i == 0) ? game->snake2.color_head : game->snake2.color_body;
-            wattron(game->win, COLOR_PAIR(color));
-            char ch = (i == 0) ? game->snake2.head_char : game->snake2.body_char;
-            mvwaddch(game->win, game->snake2.body[i].y + 1,
-                     game->snake2.body[i].x + 1, ch);
-            wattroff(game->win, COLOR_PAIR(color));
+    // Serpents (la tête clignote pendant l'invincibilité)
+    Snake *snakes[2] = {&game->snake1, &game->snake2};
+    for (int s = 0; s < (game->multiplayer ? 2 : 1); s++) {
+        const Snake *snake = snakes[s];
+        chtype head = snake->head_char | COLOR_PAIR(snake->color_head);
+        if (s == 0 && game->invincible_timer > 0) head |= A_BOLD | A_BLINK;
+        chtype body = snake->body_char | COLOR_PAIR(snake->color_body);
+        for (int i = 0; i < snake->length; i++) {
+            grid_put(width, height, snake->body[i].x, snake->body[i].y, i == 0 ? head : body);
         }
     }
+    grid_flush(game->win, width, height);
     
     // Informations
     wattron(game->win, COLOR_PAIR(COLOR_TEXT));
@@ -1006,7 +1027,7 @@ void draw_game(Game *game) {
                  game->score, game->level, game->snake1.length,
                  (game->mode == MODE_ARCADE) ? game->snake1.lives : 0);
     }
-    mvwprintw(game->win, 0, 2, "%s", info);
+    mvwaddstr(game->win, 0, 2, info);
     
     // Power-ups actifs
     if (game->slow_timer > 0 || game->invincible_timer > 0 ||
@@ -1016,71 +1037,52 @@ void draw_game(Game *game) {
         if (game->invincible_timer > 0) strcat(powerups, "INV ");
         if (game->multiplier_timer > 0) strcat(powerups, "x2 ");
         if (game->magnetic_timer > 0) strcat(powerups, "MAG ");
-        mvwprintw(game->win, game->grid_height + 1, 2, "%s", powerups);
+        mvwaddstr(game->win, game->grid_height + 1, 2, powerups);
     }
     
     if (game->paused) {
         const char *pause_msg = "PAUSE - Appuyez sur P pour continuer";
         int x = (game->grid_width - (int)strlen(pause_msg)) / 2;
-        mvwprintw(game->win, game->grid_height / 2, x, "%s", pause_msg);
+        mvwaddstr(game->win, game->grid_height / 2, x, pause_msg);
     }
     
     wattroff(game->win, COLOR_PAIR(COLOR_TEXT));
     wrefresh(game->win);
 }
 
+// Classements partagés avec le front end SDL (snake_leaderboard.h), un par
+// mode, difficulté et nombre de joueurs. Les scores passent par le journal
+// du classement : plusieurs parties qui finissent en même temps n'en perdent
+// aucun.
+static void game_leaderboard_path(const Game *game, char *path, size_t size) {
+    leaderboard_path(path, size, LEADERBOARD_DIR, game->mode, game->difficulty, game->multiplayer ? 2 : 1);
+}
+
 void load_top_scores(Game *game) {
-    FILE *file = fopen(".snake_top_scores", "r");
+    char path[256];
+    Leaderboard board;
+    LeaderEntry entry;
+    game_leaderboard_path(game, path, sizeof(path));
     game->top_score_count = 0;
-    
-    if (file) {
+    if (leaderboard_open(&board, path, LEADERBOARD_CAPACITY)) {
         while (game->top_score_count < MAX_TOP_SCORES &&
-               fscanf(file, "%d %19s %ld\n", &game->top_scores[game->top_score_count].score,
-                      game->top_scores[game->top_score_count].name,
-                      &game->top_scores[game->top_score_count].date) == 3) {
-            game->top_score_count++;
+               leaderboard_entry(&board, game->top_score_count + 1, &entry)) {
+            TopScore *top = &game->top_scores[game->top_score_count++];
+            top->score = entry.score;
+            top->level = entry.level;
+            memcpy(top->name, entry.name, sizeof(entry.name));
+            top->name[sizeof(entry.name)] = '\0';
+            top->date = (time_t)entry.date;
         }
-        fclose(file);
-    }
-}
-
-void save_top_scores(Game *game) {
-    FILE *file = fopen(".snake_top_scores", "w");
-    if (file) {
-        for (int i = 0; i < game->top_score_count; i++) {
-            fprintf(file, "%d %s %ld\n", game->top_scores[i].score,
-                    game->top_scores[i].name, game->top_scores[i].date);
-        }
-        fclose(file);
     }
+    leaderboard_close(&board);
 }
 
 void add_top_score(Game *game, int score) {
-    if (game->top_score_count < MAX_TOP_SCORES ||
-        score > game->top_scores[MAX_TOP_SCORES - 1].score) {
-        
-        int pos = game->top_score_count;
-        for (int i = 0; i < game->top_score_count; i++) {
-            if (score > game->top_scores[i].score) {
-                pos = i;
-                break;
-            }
-        }
-        
-        if (game->top_score_count < MAX_TOP_SCORES) {
-            game->top_score_count++;
-        }
-        
-        for (int i = game->top_score_count - 1; i > pos; i--) {
-            game->top_scores[i] = game->top_scores[i - 1];
-        }
-        
-        game->top_scores[pos].score = score;
-        strncpy(game->top_scores[pos].name, "Player", 19);
-        game->top_scores[pos].name[19] = '\0';
-        game->top_scores[pos].date = time(NULL);
-        
-        save_top_scores(game);
+    char path[256];
+    game_leaderboard_path(game, path, sizeof(path));
+    if (leaderboard_submit(path, LEADERBOARD_CAPACITY, score, game->level, player_name, time(NULL))) {
+        load_top_scores(game);
     }
 }
 
@@ -1380,6 +1382,9 @@ int show_game_over(Game *game) {
 
 void game_loop(Game *game) {
     clock_t last_move = clock();
+    unsigned long tick = 0;
+    int was_paused = 0;
+    publish_stream(game, tick);
     
     while (!game->game_over) {
         if (game->multiplayer) {
@@ -1398,20 +1403,270 @@ void game_loop(Game *game) {
             }
             update_powerups(game);
             last_move = current;
+            publish_stream(game, ++tick);
+        } else if (game->paused != was_paused) {
+            publish_stream(game, ++tick);
         }
+        was_paused = game->paused;
         
         draw_game(game);
         usleep(10000);
     }
+    publish_stream(game, ++tick);
+}
+
+// ===== FLUX SPECTATEUR =====
+
+static StreamItem stream_item(Position pos, int type) {
+    StreamItem item = {{(short)pos.x, (short)pos.y}, (unsigned char)type};
+    return item;
 }
 
-int main() {
+// Copie l'état affiché de la partie dans un StreamFrame et le publie.
+void publish_stream(Game *game, unsigned long tick) {
+    if (!spectator_stream) return;
+    StreamFrame *frame = spectator_frame;
+    frame->tick = tick;
+    frame->width = game->grid_width;
+    frame->height = game->grid_height;
+    frame->snake_count = game->multiplayer ? 2 : 1;
+    Snake *snakes[2] = {&game->snake1, &game->snake2};
+    for (int s = 0; s < frame->snake_count; s++) {
+        StreamSnake *out = &frame->snakes[s];
+        out->length = snakes[s]->length < STREAM_MAX_LENGTH ? snakes[s]->length : STREAM_MAX_LENGTH;
+        for (int i = 0; i < out->length; i++) {
+            out->body[i].x = (short)snakes[s]->body[i].x;
+            out->body[i].y = (short)snakes[s]->body[i].y;
+        }
+        out->score = snakes[s]->score;
+        out->lives = snakes[s]->lives;
+    }
+    frame->food_count = game->food_count < STREAM_MAX_FOOD ? game->food_count : STREAM_MAX_FOOD;
+    for (int i = 0; i < frame->food_count; i++) {
+        frame->foods[i] = stream_item(game->foods[i].pos, game->foods[i].type);
+    }
+    frame->powerup_active = game->powerup.active;
+    frame->powerup = stream_item(game->powerup.pos, game->powerup.type);
+    frame->obstacle_count = game->obstacle_count;
+    for (int i = 0; i < game->obstacle_count; i++) {
+        frame->obstacles[i] = stream_item(game->obstacles[i].pos, game->obstacles[i].type == 2);
+    }
+    frame->score = game->score;
+    frame->level = game->level;
+    frame->game_over = game->game_over;
+    frame->paused = game->paused;
+    stream_publish(spectator_stream, frame);
+}
+
+void draw_stream_frame(WINDOW *win, const StreamFrame *frame) {
+    static const chtype snake_glyphs[2][2] = {
+        {'@' | COLOR_PAIR(COLOR_SNAKE1_HEAD), 'o' | COLOR_PAIR(COLOR_SNAKE1_BODY)},
+        {'@' | COLOR_PAIR(COLOR_SNAKE2_HEAD), 'o' | COLOR_PAIR(COLOR_SNAKE2_BODY)}
+    };
+    int width, height;
+    grid_begin(win, frame->width, frame->height, &width, &height);
+    for (int i = 0; i < frame->obstacle_count; i++) {
+        grid_put(width, height, frame->obstacles[i].pos.x, frame->obstacles[i].pos.y,
+                 obstacle_glyphs[frame->obstacles[i].type != 0]);
+    }
+    for (int i = 0; i < frame->food_count; i++) {
+        int type = frame->foods[i].type <= FOOD_BONUS ? frame->foods[i].type : FOOD_NORMAL;
+        grid_put(width, height, frame->foods[i].pos.x, frame->foods[i].pos.y, food_glyphs[type]);
+    }
+    if (frame->powerup_active) {
+        int type = frame->powerup.type <= POWERUP_MAGNETIC ? frame->powerup.type : POWERUP_NONE;
+        grid_put(width, height, frame->powerup.pos.x, frame->powerup.pos.y, powerup_glyphs[type]);
+    }
+    for (int s = 0; s < frame->snake_count; s++) {
+        const StreamSnake *snake = &frame->snakes[s];
+        for (int i = 0; i < snake->length; i++) {
+            grid_put(width, height, snake->body[i].x, snake->body[i].y, snake_glyphs[s][i == 0 ? 0 : 1]);
+        }
+    }
+    grid_flush(win, width, height);
+    
+    wattron(win, COLOR_PAIR(COLOR_TEXT));
+    if (frame->snake_count > 1) {
+        mvwprintw(win, 0, 2, "SPECTATEUR | P1: %d | P2: %d | Niveau: %d",
+                  frame->snakes[0].score, frame->snakes[1].score, frame->level);
+    } else {
+        mvwprintw(win, 0, 2, "SPECTATEUR | Score: %d | Niveau: %d | Longueur: %d",
+                  frame->score, frame->level, frame->snakes[0].length);
+    }
+    if (frame->paused || frame->game_over) {
+        mvwaddstr(win, frame->height / 2, 2, frame->game_over ? "PARTIE TERMINÉE" : "PAUSE");
+    }
+    wattroff(win, COLOR_PAIR(COLOR_TEXT));
+    wrefresh(win);
+}
+
+// Mode spectateur : affiche la partie publiée sur `target` sans la simuler.
+// Si la source disparaît (socket fermé), on retente la connexion chaque seconde.
+// La fenêtre suit la taille de la grille diffusée (80x30 en facile, 40x15
+// en extrême...) : redimensionnée à la première image et à chaque
+// changement de taille, pour ne rien couper.
+void view_stream(const char *target) {
+    int grid_width = WIDTH, grid_height = HEIGHT;
+    WINDOW *win = newwin(grid_height + 2, grid_width + 2, 0, 0);
+    nodelay(win, TRUE);
+    StreamReader reader;
+    int connected = stream_reader_open(&reader, target);
+    int wait = 0;
+    
+    for (;;) {
+        int ch = wgetch(win);
+        if (ch == 'q' || ch == 'Q') break;
+        if (connected && stream_reader_poll(&reader) < 0) {
+            stream_reader_close(&reader);
+            connected = 0;
+        }
+        if (!connected && ++wait % 100 == 0) connected = stream_reader_open(&reader, target);
+        if (connected && reader.synced) {
+            if (reader.frame->width != grid_width || reader.frame->height != grid_height) {
+                grid_width = reader.frame->width;
+                grid_height = reader.frame->height;
+                werase(win);
+                wnoutrefresh(win);
+                wresize(win, grid_height + 2, grid_width + 2);
+                clear();
+                refresh();
+            }
+            draw_stream_frame(win, reader.frame);
+        } else {
+            werase(win);
+            box(win, 0, 0);
+            mvwprintw(win, grid_height / 2, 2, "En attente du flux %s... (q : quitter)", target);
+            wrefresh(win);
+        }
+        usleep(10000);
+    }
+    if (connected) stream_reader_close(&reader);
+    delwin(win);
+}
+
+// ===== MESURE DU RENDU (--bench-draw) =====
+
+// Octets et appels système d'écriture du processus (/proc/self/io)
+static int read_write_counters(unsigned long *bytes, unsigned long *calls) {
+    FILE *f = fopen("/proc/self/io", "r");
+    if (!f) return 0;
+    char line[64];
+    int found = 0;
+    while (fgets(line, sizeof(line), f)) {
+        found += sscanf(line, "wchar: %lu", bytes) == 1;
+        found += sscanf(line, "syscw: %lu", calls) == 1;
+    }
+    fclose(f);
+    return found == 2;
+}
+
+// Serpent en zigzag sur toute la grille, avancé de `offset` cases : la tête
+// progresse d'une case par image, comme en jeu.
+static void lay_bench_snake(Game *game, int length, int offset) {
+    int cells = game->grid_width * game->grid_height;
+    game->snake1.length = length;
+    for (int i = 0; i < length; i++) {
+        int p = (offset + length - 1 - i) % cells;
+        int y = p / game->grid_width, x = p % game->grid_width;
+        game->snake1.body[i] = (Position){y % 2 ? game->grid_width - 1 - x : x, y};
+    }
+}
+
+// Temps CPU, octets et appels write() par image de draw_game sur la grille
+// 80x30 (mode défi : 48 obstacles, 5 repas, un power-up, serpent de 600
+// cases). Le terminal est simulé (newterm vers /dev/null) : la mesure couvre
+// la composition et le calcul des différences par ncurses, pas l'affichage
+// par l'émulateur. Même scénario que `snake_tty --bench-draw`.
+int bench_draw(int frames) {
+    FILE *out = fopen("/dev/null", "w");
+    if (!out) return 0;
+    setenv("LINES", "40", 1);
+    setenv("COLUMNS", "100", 1);
+    SCREEN *screen = newterm(getenv("TERM") ? NULL : "xterm", out, stdin);
+    if (!screen) {
+        fclose(out);
+        return 0;
+    }
+    init_colors();
+    init_theme_colors(THEME_CLASSIC);
+    srand(1);
+    Game game;
+    init_game(&game, MODE_CHALLENGE, DIFF_EASY, 0);
+    game.food_count = MAX_FOOD;
+    generate_food(&game);
+    game.powerup = (PowerUp){{game.grid_width - 3, 2}, POWERUP_MAGNETIC, 0, 1};
+    game.magnetic_timer = 1;
+    
+    unsigned long bytes0 = 0, calls0 = 0, bytes1 = 0, calls1 = 0;
+    int counted = read_write_counters(&bytes0, &calls0);
+    clock_t start = clock();
+    for (int f = 0; f < frames; f++) {
+        lay_bench_snake(&game, 600, f);
+        game.score = f;
+        draw_game(&game);
+    }
+    double cpu = (double)(clock() - start) / CLOCKS_PER_SEC;
+    counted = counted && read_write_counters(&bytes1, &calls1);
+    delwin(game.win);
+    endwin();
+    delscreen(screen);
+    fclose(out);
+    printf("draw_game %dx%d : %d images, %.1f µs CPU par image\n", game.grid_width, game.grid_height, frames,
+           cpu / frames * 1e6);
+    if (counted) {
+        printf("  /proc/self/io : %.1f octets par image, %.2f write() par image\n",
+               (double)(bytes1 - bytes0) / frames, (double)(calls1 - calls0) / frames);
+    }
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    const char *stream_target = NULL;
+    const char *view_target = NULL;
+    const char *name = NULL;
+    int bench_frames = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--stream") == 0 && i + 1 < argc) {
+            stream_target = argv[++i];
+        } else if (strcmp(argv[i], "--view") == 0 && i + 1 < argc) {
+            view_target = argv[++i];
+        } else if (strcmp(argv[i], "--bench-draw") == 0 && i + 1 < argc) {
+            bench_frames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else {
+            fprintf(stderr, "Usage : %s [--stream CIBLE | --view CIBLE | --bench-draw IMAGES] [--name JOUEUR]\n"
+                            "  CIBLE : fichier, FIFO ou unix:chemin\n"
+                            "  JOUEUR : nom inscrit au classement ($USER par défaut, 15 caractères)\n", argv[0]);
+            return 1;
+        }
+    }
+    if (bench_frames > 0) return bench_draw(bench_frames) ? 0 : 1;
+    leaderboard_player_name(player_name, sizeof(player_name), name);
+    
+    StreamWriter writer;
+    if (stream_target) {
+        spectator_frame = calloc(1, sizeof(StreamFrame));
+        if (!spectator_frame || !stream_writer_open(&writer, stream_target)) {
+            fprintf(stderr, "Erreur : impossible d'ouvrir le flux %s\n", stream_target);
+            free(spectator_frame);
+            return 1;
+        }
+        spectator_stream = &writer;
+    }
+    
     initscr();
     noecho();
     curs_set(0);
     init_colors();
     init_theme_colors(THEME_CLASSIC);
     
+    if (view_target) {
+        view_stream(view_target);
+        endwin();
+        return 0;
+    }
+    
     srand(time(NULL));
     
     int running = 1;
@@ -1442,9 +1697,17 @@ int main() {
             } else {  // Quitter
                 running = 0;
             }
-        } else if (menu_choice == 2) {  // Meilleurs scores
+        } else if (menu_choice == 2) {  // Meilleurs scores (un classement par mode et difficulté)
+            int mode_choice = show_game_mode_menu();
+            if (mode_choice < 0) continue;
+            
+            int diff_choice = show_difficulty_menu();
+            if (diff_choice < 0) continue;
+            
             Game game;
-            load_top_scores(&game);
+            game.mode = mode_choice;
+            game.difficulty = diff_choice;
+            game.multiplayer = 0;
             show_top_scores(&game);
         } else {  // Quitter
             running = 0;
@@ -1452,5 +1715,9 @@ int main() {
     }
     
     endwin();
+    if (spectator_stream) {
+        stream_writer_close(spectator_stream);
+        free(spectator_frame);
+    }
     return 0;
 }
@@ -0,0 +1,616 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include "snake_net.h"
+
+// Événements d'un tick : un octet de type puis l'identifiant sur 16 bits.
+//   0..3  tête avancée dans la direction (la queue avance aussi)
+//   4..7  idem, le serpent a grandi (la queue reste en place)
+#define EV_GROW_FLAG 4
+#define EV_DIE 8
+#define EV_SPAWN 9      // x, y, direction
+#define EV_SCORE 10     // score sur 32 bits
+#define EV_FOOD 11      // x, y (0xFFFF : pas de nourriture)
+#define NET_NO_COORD 0xFFFF
+
+// ===== ENCODAGE =====
+
+typedef struct {
+    unsigned char *data;
+    int size;
+    int capacity;
+} Writer;
+
+typedef struct {
+    const unsigned char *data;
+    int size;
+    int pos;
+    int error;
+} Reader;
+
+static void put8(Writer *w, unsigned int v) {
+    if (w->size + 1 > w->capacity) {
+        w->capacity = -1;
+        return;
+    }
+    w->data[w->size++] = (unsigned char)v;
+}
+
+static void put16(Writer *w, unsigned int v) {
+    put8(w, v & 0xff);
+    put8(w, (v >> 8) & 0xff);
+}
+
+static void put32(Writer *w, unsigned long v) {
+    put16(w, v & 0xffff);
+    put16(w, (v >> 16) & 0xffff);
+}
+
+static unsigned int get8(Reader *r) {
+    if (r->pos >= r->size) {
+        r->error = 1;
+        return 0;
+    }
+    return r->data[r->pos++];
+}
+
+static unsigned int get16(Reader *r) {
+    unsigned int lo = get8(r);
+    return lo | (get8(r) << 8);
+}
+
+static unsigned long get32(Reader *r) {
+    unsigned long lo = get16(r);
+    return lo | ((unsigned long)get16(r) << 16);
+}
+
+static Position step_position(Position pos, Direction dir) {
+    switch (dir) {
+        case UP: pos.y--; break;
+        case RIGHT: pos.x++; break;
+        case DOWN: pos.y++; break;
+        case LEFT: pos.x--; break;
+    }
+    return pos;
+}
+
+static Direction direction_between(Position from, Position to) {
+    if (to.x > from.x) return RIGHT;
+    if (to.x < from.x) return LEFT;
+    if (to.y > from.y) return DOWN;
+    return UP;
+}
+
+static int set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// ===== INSTANTANÉ COMPLET =====
+
+// Taille maximale d'un paquet NET_FULL : en-tête, puis par serpent l'état,
+// la tête et les directions des segments suivants sur 2 bits.
+int net_full_size_bound(const Arena *arena) {
+    int capacity = arena->snakes[0].capacity;
+    long size = 17 + (long)arena->snake_count * (11 + (capacity + 2) / 4) + 4L * arena->food_count;
+    return size > NET_MAX_PACKET ? -1 : (int)size;
+}
+
+static void encode_full(Writer *w, const Arena *arena, int snake_id) {
+    put8(w, NET_FULL);
+    put32(w, arena->tick);
+    put16(w, snake_id < 0 ? NET_NO_COORD : (unsigned int)snake_id);
+    put16(w, arena->width);
+    put16(w, arena->height);
+    put16(w, arena->snake_count);
+    put16(w, arena->snakes[0].capacity);
+    put16(w, arena->food_count);
+    for (int id = 0; id < arena->snake_count; id++) {
+        const ArenaSnake *snake = &arena->snakes[id];
+        put8(w, (snake->alive ? 1 : 0) | (snake->direction << 1));
+        put32(w, (unsigned long)snake->score);
+        put16(w, snake->length);
+        if (!snake->alive) continue;
+        Position prev = arena_segment(snake, 0);
+        put16(w, prev.x);
+        put16(w, prev.y);
+        unsigned int bits = 0;
+        int used = 0;
+        for (int i = 1; i < snake->length; i++) {
+            Position p = arena_segment(snake, i);
+            bits |= direction_between(prev, p) << (2 * used);
+            prev = p;
+            if (++used == 4) {
+                put8(w, bits);
+                bits = 0;
+                used = 0;
+            }
+        }
+        if (used > 0) put8(w, bits);
+    }
+    for (int i = 0; i < arena->food_count; i++) {
+        Position food = arena->foods[i];
+        put16(w, food.x < 0 ? NET_NO_COORD : (unsigned int)food.x);
+        put16(w, food.x < 0 ? NET_NO_COORD : (unsigned int)food.y);
+    }
+}
+
+// ===== SERVEUR =====
+
+int net_server_init(NetServer *server, int port, int width, int height, int max_clients,
+                    int bots, int max_length, int food_count, unsigned int seed) {
+    memset(server, 0, sizeof(*server));
+    server->fd = -1;
+    if (max_clients < 0 || max_clients > NET_MAX_CLIENTS || bots < 0 ||
+        width > 0xFFFE || height > 0xFFFE || max_clients + bots > 0xFFFE)
+        return 0;
+    if (!arena_init(&server->arena, width, height, max_clients + bots, max_length, food_count, seed)) {
+        return 0;
+    }
+    server->max_clients = max_clients;
+
+    Arena *arena = &server->arena;
+    int record_capacity = arena->snake_count * 10 + arena->food_count * 7;
+    int ok = net_full_size_bound(arena) > 0;
+    for (int i = 0; i < NET_HISTORY && ok; i++) {
+        server->history[i].data = malloc(record_capacity);
+        ok = server->history[i].data != NULL;
+    }
+    server->scratch = malloc(NET_MAX_PACKET);
+    server->prev_alive = malloc(arena->snake_count * sizeof(int));
+    server->prev_length = malloc(arena->snake_count * sizeof(int));
+    server->prev_score = malloc(arena->snake_count * sizeof(int));
+    server->prev_food = malloc(arena->food_count * sizeof(Position));
+    if (!ok || !server->scratch || !server->prev_alive || !server->prev_length ||
+        !server->prev_score || !server->prev_food) {
+        net_server_free(server);
+        return 0;
+    }
+    for (int id = 0; id < arena->snake_count; id++) {
+        server->prev_alive[id] = arena->snakes[id].alive;
+        server->prev_length[id] = arena->snakes[id].length;
+        server->prev_score[id] = arena->snakes[id].score;
+    }
+    memcpy(server->prev_food, arena->foods, arena->food_count * sizeof(Position));
+
+    server->fd = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    socklen_t len = sizeof(addr);
+    if (server->fd < 0 || !set_nonblocking(server->fd) ||
+        bind(server->fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        getsockname(server->fd, (struct sockaddr *)&addr, &len) != 0) {
+        net_server_free(server);
+        return 0;
+    }
+    server->port = ntohs(addr.sin_port);
+    return 1;
+}
+
+void net_server_free(NetServer *server) {
+    if (server->fd >= 0) close(server->fd);
+    for (int i = 0; i < NET_HISTORY; i++) free(server->history[i].data);
+    free(server->scratch);
+    free(server->prev_alive);
+    free(server->prev_length);
+    free(server->prev_score);
+    free(server->prev_food);
+    arena_free(&server->arena);
+    memset(server, 0, sizeof(*server));
+    server->fd = -1;
+}
+
+static void send_packet(NetServer *server, NetClientSlot *slot, const unsigned char *data, int size) {
+    if (sendto(server->fd, data, size, 0, (struct sockaddr *)&slot->addr, sizeof(slot->addr)) == size) {
+        slot->bytes_sent += size;
+        slot->packets_sent++;
+    }
+}
+
+static void release_slot(NetServer *server, NetClientSlot *slot) {
+    server->arena.snakes[slot->snake_id].controlled = 0;
+    slot->active = 0;
+    server->client_count--;
+}
+
+static NetClientSlot *find_slot(NetServer *server, const struct sockaddr_in *addr) {
+    for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+        NetClientSlot *slot = &server->clients[i];
+        if (slot->active && slot->addr.sin_port == addr->sin_port &&
+            slot->addr.sin_addr.s_addr == addr->sin_addr.s_addr)
+            return slot;
+    }
+    return NULL;
+}
+
+static NetClientSlot *open_slot(NetServer *server, const struct sockaddr_in *addr) {
+    if (server->client_count >= server->max_clients) return NULL;
+    NetClientSlot *slot = NULL;
+    for (int i = 0; i < NET_MAX_CLIENTS && !slot; i++) {
+        if (!server->clients[i].active) slot = &server->clients[i];
+    }
+    for (int id = 0; id < server->max_clients; id++) {
+        if (server->arena.snakes[id].controlled) continue;
+        memset(slot, 0, sizeof(*slot));
+        slot->active = 1;
+        slot->addr = *addr;
+        slot->snake_id = id;
+        slot->acked = -1;
+        slot->last_heard = server->arena.tick;
+        server->arena.snakes[id].controlled = 1;
+        server->client_count++;
+        return slot;
+    }
+    return NULL;
+}
+
+// Lit tous les paquets en attente sans bloquer.
+void net_server_poll(NetServer *server) {
+    unsigned char buffer[64];
+    for (;;) {
+        struct sockaddr_in addr;
+        socklen_t len = sizeof(addr);
+        ssize_t n = recvfrom(server->fd, buffer, sizeof(buffer), 0, (struct sockaddr *)&addr, &len);
+        if (n <= 0) break;
+        server->bytes_received += n;
+        Reader r = {buffer, (int)n, 0, 0};
+        unsigned int type = get8(&r);
+        NetClientSlot *slot = find_slot(server, &addr);
+
+        if (type == NET_HELLO) {
+            if (!slot) slot = open_slot(server, &addr);
+            if (!slot) {
+                unsigned char refused = NET_REFUSED;
+                sendto(server->fd, &refused, 1, 0, (struct sockaddr *)&addr, sizeof(addr));
+                continue;
+            }
+            slot->acked = -1;
+        } else if (!slot) {
+            continue;
+        } else if (type == NET_INPUT) {
+            long ack = (long)get32(&r);
+            unsigned int dir = get8(&r);
+            if (r.error) continue;
+            if (ack > slot->acked && ack <= (long)server->arena.tick) slot->acked = ack;
+            if (dir < 4) server->arena.snakes[slot->snake_id].requested = (Direction)dir;
+        } else if (type == NET_BYE) {
+            release_slot(server, slot);
+            continue;
+        }
+        slot->last_heard = server->arena.tick;
+    }
+}
+
+// Avance la simulation d'un tick et enregistre le delta correspondant.
+// Ordre des événements : morts, déplacements, scores, nourriture, apparitions
+// (le même ordre que la résolution de l'arène, pour que la copie du client
+// aboutisse exactement à la même grille).
+int net_server_step(NetServer *server) {
+    Arena *arena = &server->arena;
+    arena_tick(arena);
+
+    NetRecord *record = &server->history[arena->tick % NET_HISTORY];
+    Writer w = {record->data, 0, arena->snake_count * 10 + arena->food_count * 7};
+    for (int id = 0; id < arena->snake_count; id++) {
+        if (server->prev_alive[id] && !arena->snakes[id].alive) {
+            put8(&w, EV_DIE);
+            put16(&w, id);
+        }
+    }
+    for (int id = 0; id < arena->snake_count; id++) {
+        const ArenaSnake *snake = &arena->snakes[id];
+        if (!server->prev_alive[id] || !snake->alive) continue;
+        put8(&w, snake->direction | (snake->length > server->prev_length[id] ? EV_GROW_FLAG : 0));
+        put16(&w, id);
+    }
+    for (int id = 0; id < arena->snake_count; id++) {
+        if (arena->snakes[id].score == server->prev_score[id]) continue;
+        put8(&w, EV_SCORE);
+        put16(&w, id);
+        put32(&w, (unsigned long)arena->snakes[id].score);
+    }
+    for (int i = 0; i < arena->food_count; i++) {
+        Position food = arena->foods[i];
+        if (food.x == server->prev_food[i].x && food.y == server->prev_food[i].y) continue;
+        put8(&w, EV_FOOD);
+        put16(&w, i);
+        put16(&w, food.x < 0 ? NET_NO_COORD : (unsigned int)food.x);
+        put16(&w, food.x < 0 ? NET_NO_COORD : (unsigned int)food.y);
+    }
+    for (int id = 0; id < arena->snake_count; id++) {
+        const ArenaSnake *snake = &arena->snakes[id];
+        if (server->prev_alive[id] || !snake->alive) continue;
+        Position head = arena_segment(snake, 0);
+        put8(&w, EV_SPAWN);
+        put16(&w, id);
+        put16(&w, head.x);
+        put16(&w, head.y);
+        put8(&w, snake->direction);
+    }
+    record->size = w.size;
+
+    for (int id = 0; id < arena->snake_count; id++) {
+        server->prev_alive[id] = arena->snakes[id].alive;
+        server->prev_length[id] = arena->snakes[id].length;
+        server->prev_score[id] = arena->snakes[id].score;
+    }
+    memcpy(server->prev_food, arena->foods, arena->food_count * sizeof(Position));
+    return w.capacity >= 0;
+}
+
+// Envoie à chaque client les ticks qu'il n'a pas encore acquittés, ou un
+// instantané complet s'il n'a rien acquitté ou si l'historique ne suffit plus.
+void net_server_flush(NetServer *server) {
+    Arena *arena = &server->arena;
+    long tick = (long)arena->tick;
+    for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+        NetClientSlot *slot = &server->clients[i];
+        if (!slot->active) continue;
+        if (arena->tick - slot->last_heard > NET_TIMEOUT_TICKS) {
+            release_slot(server, slot);
+            continue;
+        }
+        if (slot->acked == tick) continue;
+
+        Writer w = {server->scratch, 0, NET_MAX_PACKET};
+        if (slot->acked >= 0 && tick - slot->acked <= NET_HISTORY) {
+            put8(&w, NET_DELTA);
+            put32(&w, (unsigned long)slot->acked);
+            put32(&w, (unsigned long)tick);
+            for (long t = slot->acked + 1; t <= tick && w.capacity >= 0; t++) {
+                const NetRecord *record = &server->history[t % NET_HISTORY];
+                put16(&w, record->size);
+                if (w.size + record->size > w.capacity) {
+                    w.capacity = -1;
+                    break;
+                }
+                memcpy(w.data + w.size, record->data, record->size);
+                w.size += record->size;
+            }
+        } else {
+            w.capacity = -1;
+        }
+        if (w.capacity < 0) {
+            w = (Writer){server->scratch, 0, NET_MAX_PACKET};
+            encode_full(&w, arena, slot->snake_id);
+            slot->full_sent++;
+        }
+        send_packet(server, slot, w.data, w.size);
+    }
+}
+
+// ===== CLIENT =====
+
+int net_client_init(NetClient *client, const char *host, int port) {
+    memset(client, 0, sizeof(*client));
+    client->snake_id = -1;
+    client->buffer = malloc(NET_MAX_PACKET);
+    char service[16];
+    snprintf(service, sizeof(service), "%d", port);
+    struct addrinfo hints, *res = NULL;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    client->fd = -1;
+    if (!client->buffer || getaddrinfo(host, service, &hints, &res) != 0) {
+        net_client_free(client);
+        return 0;
+    }
+    client->fd = socket(AF_INET, SOCK_DGRAM, 0);
+    int ok = client->fd >= 0 && set_nonblocking(client->fd) &&
+             connect(client->fd, res->ai_addr, res->ai_addrlen) == 0;
+    freeaddrinfo(res);
+    if (!ok) {
+        net_client_free(client);
+        return 0;
+    }
+    return 1;
+}
+
+void net_client_free(NetClient *client) {
+    if (client->fd >= 0) close(client->fd);
+    if (client->ready) arena_free(&client->mirror);
+    free(client->buffer);
+    memset(client, 0, sizeof(*client));
+    client->fd = -1;
+}
+
+int net_client_hello(NetClient *client) {
+    unsigned char hello = NET_HELLO;
+    return send(client->fd, &hello, 1, 0) == 1;
+}
+
+// Acquitte le dernier tick reçu et transmet la direction voulue.
+int net_client_send_input(NetClient *client, Direction direction) {
+    unsigned char buffer[6];
+    Writer w = {buffer, 0, sizeof(buffer)};
+    put8(&w, NET_INPUT);
+    put32(&w, client->ready ? client->mirror.tick : 0xFFFFFFFFul);
+    put8(&w, direction);
+    return send(client->fd, buffer, w.size, 0) == w.size;
+}
+
+void net_client_bye(NetClient *client) {
+    unsigned char bye = NET_BYE;
+    send(client->fd, &bye, 1, 0);
+}
+
+static int load_full(NetClient *client, Reader *r) {
+    unsigned long tick = get32(r);
+    unsigned int snake_id = get16(r);
+    int width = get16(r), height = get16(r);
+    int snake_count = get16(r), capacity = get16(r), food_count = get16(r);
+    if (r->error) return 0;
+
+    Arena *mirror = &client->mirror;
+    if (!client->ready || mirror->width != width || mirror->height != height ||
+        mirror->snake_count != snake_count || mirror->snakes[0].capacity != capacity ||
+        mirror->food_count != food_count) {
+        if (client->ready) arena_free(mirror);
+        client->ready = 0;
+        if (!arena_init(mirror, width, height, snake_count, capacity, food_count, 1)) return 0;
+    }
+    client->ready = 1;
+    client->snake_id = snake_id == NET_NO_COORD ? -1 : (int)snake_id;
+    memset(mirror->cells, 0, (size_t)width * height * sizeof(int));
+    mirror->alive_count = 0;
+    for (int id = 0; id < snake_count; id++) {
+        ArenaSnake *snake = &mirror->snakes[id];
+        unsigned int flags = get8(r);
+        snake->alive = flags & 1;
+        snake->direction = (Direction)((flags >> 1) & 3);
+        snake->score = (int)get32(r);
+        snake->length = get16(r);
+        snake->head = 0;
+        if (!snake->alive) continue;
+        if (snake->length < 1 || snake->length > capacity) return 0;
+        Position p = {get16(r), get16(r)};
+        unsigned int bits = 0;
+        for (int i = 0; i < snake->length; i++) {
+            if (i > 0) {
+                if ((i - 1) % 4 == 0) bits = get8(r);
+                p = step_position(p, (Direction)(bits & 3));
+                bits >>= 2;
+            }
+            if (!arena_in_bounds(mirror, p)) return 0;
+            snake->body[i] = p;
+            mirror->cells[arena_index(mirror, p)] = id + 1;
+        }
+        mirror->alive_count++;
+    }
+    for (int i = 0; i < food_count; i++) {
+        unsigned int x = get16(r), y = get16(r);
+        mirror->foods[i].x = x == NET_NO_COORD ? -1 : (int)x;
+        mirror->foods[i].y = y == NET_NO_COORD ? -1 : (int)y;
+        if (x != NET_NO_COORD && arena_in_bounds(mirror, mirror->foods[i])) {
+            mirror->cells[arena_index(mirror, mirror->foods[i])] = -(i + 1);
+        }
+    }
+    mirror->tick = tick;
+    return !r->error;
+}
+
+static int apply_full(NetClient *client, Reader *r) {
+    if (load_full(client, r)) return 1;
+    if (client->ready) arena_free(&client->mirror);
+    client->ready = 0;
+    return 0;
+}
+
+static void clear_cell(Arena *mirror, Position p, int value) {
+    if (!arena_in_bounds(mirror, p)) return;
+    int idx = arena_index(mirror, p);
+    if (mirror->cells[idx] == value) mirror->cells[idx] = ARENA_CELL_EMPTY;
+}
+
+// Rejoue les événements d'un tick sur la copie locale.
+static int apply_record(Arena *mirror, Reader *r, int end) {
+    while (r->pos < end && !r->error) {
+        unsigned int kind = get8(r);
+        int id = get16(r);
+        if (id >= (kind == EV_FOOD ? mirror->food_count : mirror->snake_count)) return 0;
+        ArenaSnake *snake = kind == EV_FOOD ? NULL : &mirror->snakes[id];
+
+        if (kind < EV_DIE) {
+            if (!snake->alive) return 0;
+            Position head = step_position(arena_segment(snake, 0), (Direction)(kind & 3));
+            if (!arena_in_bounds(mirror, head)) return 0;
+            if (!(kind & EV_GROW_FLAG)) {
+                clear_cell(mirror, arena_segment(snake, snake->length - 1), id + 1);
+            } else if (snake->length < snake->capacity) {
+                snake->length++;
+            }
+            snake->head = (snake->head + snake->capacity - 1) % snake->capacity;
+            snake->body[snake->head] = head;
+            snake->direction = (Direction)(kind & 3);
+            mirror->cells[arena_index(mirror, head)] = id + 1;
+        } else if (kind == EV_DIE) {
+            for (int i = 0; i < snake->length; i++) {
+                clear_cell(mirror, arena_segment(snake, i), id + 1);
+            }
+            snake->alive = 0;
+            mirror->alive_count--;
+        } else if (kind == EV_SPAWN) {
+            Position p = {get16(r), get16(r)};
+            snake->direction = (Direction)(get8(r) & 3);
+            if (!arena_in_bounds(mirror, p)) return 0;
+            snake->head = 0;
+            snake->body[0] = p;
+            snake->length = 1;
+            snake->alive = 1;
+            mirror->cells[arena_index(mirror, p)] = id + 1;
+            mirror->alive_count++;
+        } else if (kind == EV_SCORE) {
+            snake->score = (int)get32(r);
+        } else if (kind == EV_FOOD) {
+            unsigned int x = get16(r), y = get16(r);
+            Position old = mirror->foods[id];
+            if (old.x >= 0) clear_cell(mirror, old, -(id + 1));
+            mirror->foods[id].x = x == NET_NO_COORD ? -1 : (int)x;
+            mirror->foods[id].y = y == NET_NO_COORD ? -1 : (int)y;
+            if (x != NET_NO_COORD) {
+                if (!arena_in_bounds(mirror, mirror->foods[id])) return 0;
+                mirror->cells[arena_index(mirror, mirror->foods[id])] = -(id + 1);
+            }
+        } else {
+            return 0;
+        }
+    }
+    return !r->error && r->pos == end;
+}
+
+static int apply_delta(NetClient *client, Reader *r) {
+    unsigned long base = get32(r);
+    unsigned long tick = get32(r);
+    Arena *mirror = &client->mirror;
+    if (r->error || !client->ready || base > mirror->tick || tick <= mirror->tick) return 0;
+    for (unsigned long t = base + 1; t <= tick; t++) {
+        int size = get16(r);
+        int end = r->pos + size;
+        if (r->error || end > r->size) return 0;
+        if (t <= mirror->tick) {
+            r->pos = end;  // déjà appliqué
+            continue;
+        }
+        if (!apply_record(mirror, r, end)) {
+            client->ready = 0;  // copie incohérente : on attend un instantané complet
+            arena_free(mirror);
+            return 0;
+        }
+        mirror->tick = t;
+    }
+    return 1;
+}
+
+// Lit les paquets en attente ; retourne le nombre de paquets appliqués.
+int net_client_poll(NetClient *client) {
+    int applied = 0;
+    for (;;) {
+        ssize_t n = recv(client->fd, client->buffer, NET_MAX_PACKET, 0);
+        if (n <= 0) break;
+        client->bytes_received += n;
+        client->packets_received++;
+        if (client->drop_every > 0 && client->packets_received % client->drop_every == 0) {
+            client->packets_ignored++;
+            continue;
+        }
+        Reader r = {client->buffer, (int)n, 0, 0};
+        unsigned int type = get8(&r);
+        int ok = 0;
+        if (type == NET_FULL) ok = apply_full(client, &r);
+        else if (type == NET_DELTA) ok = apply_delta(client, &r);
+        else if (type == NET_REFUSED) client->refused = 1;
+        if (ok) applied++;
+        else client->packets_ignored++;
+    }
+    return applied;
+}
@@ -0,0 +1,101 @@
+#ifndef SNAKE_NET_H
+#define SNAKE_NET_H
+
+#include <netinet/in.h>
+#include "snake_arena.h"
+
+// Serveur de jeu faisant autorité, sur UDP.
+//
+// Le serveur possède la simulation (une arène) ; chaque client pilote un
+// serpent et reçoit après chaque tick un delta calculé depuis le dernier
+// tick qu'il a acquitté : nouvelle tête (une direction sur 2 bits), queue qui
+// avance ou non, morts, apparitions, scores et nourriture. Un client trop en
+// retard (ou qui vient d'arriver) reçoit un instantané complet.
+// Le client rejoue les deltas sur une copie de l'arène : son empreinte
+// (arena_hash) est identique à celle du serveur au même tick.
+
+// ===== CONSTANTES =====
+#define NET_DEFAULT_PORT 7777
+#define NET_MAX_CLIENTS 64
+#define NET_HISTORY 32              // ticks conservés pour les deltas
+#define NET_MAX_PACKET 65000
+#define NET_TIMEOUT_TICKS 200       // client silencieux : sa place revient à l'IA
+
+// Types de paquets (premier octet)
+enum {
+    NET_HELLO = 1,   // client -> serveur : demande une place
+    NET_INPUT,       // client -> serveur : acquittement + direction
+    NET_BYE,         // client -> serveur : départ
+    NET_FULL,        // serveur -> client : instantané complet
+    NET_DELTA,       // serveur -> client : ticks (acquitté, courant]
+    NET_REFUSED      // serveur -> client : plus de place
+};
+
+// ===== STRUCTURES =====
+typedef struct {
+    int active;
+    struct sockaddr_in addr;
+    int snake_id;
+    long acked;                 // dernier tick reçu par le client (-1 : aucun)
+    unsigned long last_heard;   // tick de la dernière réception
+    unsigned long bytes_sent;
+    unsigned long packets_sent;
+    unsigned long full_sent;
+} NetClientSlot;
+
+typedef struct {
+    unsigned char *data;
+    int size;
+} NetRecord;
+
+typedef struct {
+    int fd;
+    int port;
+    Arena arena;
+    int max_clients;            // serpents 0..max_clients-1 pilotables
+    NetClientSlot clients[NET_MAX_CLIENTS];
+    int client_count;
+
+    // Deltas des derniers ticks, indexés par tick % NET_HISTORY
+    NetRecord history[NET_HISTORY];
+    unsigned char *scratch;     // tampon d'encodage des paquets
+
+    // État au tick précédent, pour calculer le delta
+    int *prev_alive;
+    int *prev_length;
+    int *prev_score;
+    Position *prev_food;
+
+    unsigned long bytes_received;
+} NetServer;
+
+typedef struct {
+    int fd;
+    Arena mirror;               // copie locale reconstruite à partir des paquets
+    int ready;                  // instantané complet reçu
+    int snake_id;
+    int refused;
+    unsigned long bytes_received;
+    unsigned long packets_received;
+    unsigned long packets_ignored;
+    int drop_every;             // tests : ignore un paquet reçu sur N (perte simulée)
+    unsigned char *buffer;
+} NetClient;
+
+// ===== PROTOTYPES =====
+int net_server_init(NetServer *server, int port, int width, int height, int max_clients,
+                    int bots, int max_length, int food_count, unsigned int seed);
+void net_server_free(NetServer *server);
+void net_server_poll(NetServer *server);
+int net_server_step(NetServer *server);
+void net_server_flush(NetServer *server);
+int net_full_size_bound(const Arena *arena);
+
+int net_client_init(NetClient *client, const char *host, int port);
+void net_client_free(NetClient *client);
+int net_client_hello(NetClient *client);
+int net_client_send_input(NetClient *client, Direction direction);
+void net_client_bye(NetClient *client);
+int net_client_poll(NetClient *client);
+
+#endif
@@ -0,0 +1,231 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <ncurses.h>
+#include "snake_rollback.h"
+#include "snake_policy.h"
+
+// Partie à deux en pair à pair (UDP, boucle locale ou réseau local), en
+// lockstep avec rollback (voir snake_rollback.h). Les deux joueurs lancent le
+// programme avec la même graine, chacun indiquant l'adresse de l'autre :
+//
+//   ./snake_netplay --player 1 --port 7801 --peer 127.0.0.1:7802
+//   ./snake_netplay --player 2 --port 7802 --peer 127.0.0.1:7801
+//
+// Options : [--seed S] [--delay TICKS] [--tick-ms MS]
+//           [--bot] [--ticks N]   joueur automatique sans affichage, arrêt
+//                                 après N ticks confirmés et bilan
+// Code de retour 1 si les empreintes des deux pairs ont divergé.
+
+static volatile sig_atomic_t running = 1;
+
+static void on_signal(int sig) {
+    (void)sig;
+    running = 0;
+}
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int open_socket(int port, const char *peer) {
+    char host[256];
+    const char *colon = strrchr(peer, ':');
+    if (!colon || colon == peer || (size_t)(colon - peer) >= sizeof(host)) return -1;
+    memcpy(host, peer, colon - peer);
+    host[colon - peer] = '\0';
+
+    struct addrinfo hints, *res = NULL;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    if (getaddrinfo(host, colon + 1, &hints, &res) != 0) return -1;
+
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((unsigned short)port);
+    int flags = fd >= 0 ? fcntl(fd, F_GETFL, 0) : -1;
+    int ok = flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0 &&
+             bind(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0 &&
+             connect(fd, res->ai_addr, res->ai_addrlen) == 0;
+    freeaddrinfo(res);
+    if (!ok) {
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void draw(const Rollback *rb) {
+    const Game *game = &rb->game;
+    werase(stdscr);
+    for (int x = 0; x < game->grid_width + 2; x++) {
+        mvaddch(0, x, ACS_CKBOARD);
+        mvaddch(game->grid_height + 1, x, ACS_CKBOARD);
+    }
+    for (int y = 0; y < game->grid_height + 2; y++) {
+        mvaddch(y, 0, ACS_CKBOARD);
+        mvaddch(y, game->grid_width + 1, ACS_CKBOARD);
+    }
+    for (int i = 0; i < game->food_count; i++) {
+        mvaddch(game->foods[i].pos.y + 1, game->foods[i].pos.x + 1, '*' | COLOR_PAIR(3));
+    }
+    if (game->powerup.active) mvaddch(game->powerup.pos.y + 1, game->powerup.pos.x + 1, '+' | COLOR_PAIR(3));
+    const Snake *snakes[2] = {&game->snake1, &game->snake2};
+    for (int s = 0; s < 2; s++) {
+        for (int i = snakes[s]->length - 1; i >= 0; i--) {
+            int ch = i == 0 ? '@' : 'o';
+            mvaddch(snakes[s]->body[i].y + 1, snakes[s]->body[i].x + 1, ch | COLOR_PAIR(s + 1));
+        }
+    }
+    mvprintw(game->grid_height + 2, 0, "J1 %d (%d vies) | J2 %d (%d vies) | tick %lu | rollbacks %lu (max %lu)",
+             game->snake1.score, game->snake1.lives, game->snake2.score, game->snake2.lives,
+             rb->tick, rb->rollbacks, rb->max_depth);
+    if (game->game_over) {
+        mvprintw(game->grid_height + 3, 0, "Fin de partie : joueur %d gagne. q : quitter", game->winner);
+    } else if (rb->desync_tick) {
+        mvprintw(game->grid_height + 3, 0, "DÉSYNCHRONISATION au tick %lu", rb->desync_tick - 1);
+    }
+    refresh();
+}
+
+int main(int argc, char *argv[]) {
+    int player = 1, port = 0, delay = ROLLBACK_DEFAULT_DELAY, tick_ms = 100, bot = 0;
+    unsigned long max_ticks = 0;
+    unsigned int seed = 1;
+    const char *peer = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--player") == 0 && i + 1 < argc) {
+            player = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+            port = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--peer") == 0 && i + 1 < argc) {
+            peer = argv[++i];
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--delay") == 0 && i + 1 < argc) {
+            delay = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--tick-ms") == 0 && i + 1 < argc) {
+            tick_ms = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--bot") == 0) {
+            bot = 1;
+        } else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            max_ticks = strtoul(argv[++i], NULL, 10);
+        } else {
+            peer = NULL;
+            break;
+        }
+    }
+    if (!peer || (player != 1 && player != 2) || port <= 0) {
+        fprintf(stderr, "Usage : %s --player 1|2 --port P --peer HÔTE:PORT [--seed S] [--delay TICKS] "
+                        "[--tick-ms MS] [--bot] [--ticks N]\n", argv[0]);
+        return 2;
+    }
+    if (tick_ms <= 0) tick_ms = 100;
+
+    int fd = open_socket(port, peer);
+    if (fd < 0) {
+        fprintf(stderr, "Erreur : impossible d'ouvrir le port %d vers %s\n", port, peer);
+        return 1;
+    }
+    Rollback *rb = malloc(sizeof(Rollback));
+    if (!rb || !rollback_init(rb, player - 1, MODE_ARCADE, DIFF_MEDIUM, seed, delay)) {
+        fprintf(stderr, "Erreur : mémoire insuffisante\n");
+        close(fd);
+        return 1;
+    }
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    if (!bot) {
+        initscr();
+        noecho();
+        curs_set(0);
+        keypad(stdscr, TRUE);
+        nodelay(stdscr, TRUE);
+        start_color();
+        init_pair(1, COLOR_GREEN, COLOR_BLACK);
+        init_pair(2, COLOR_BLUE, COLOR_BLACK);
+        init_pair(3, COLOR_RED, COLOR_BLACK);
+    }
+
+    unsigned char packet[ROLLBACK_MAX_PACKET];
+    unsigned int rng = seed * 2654435761u + player;
+    double next_tick = now_seconds(), done_at = 0;
+    while (running) {
+        ssize_t size;
+        while ((size = recv(fd, packet, sizeof(packet), 0)) > 0) rollback_decode(rb, packet, (int)size);
+
+        if (!bot) {
+            int ch;
+            while ((ch = getch()) != ERR) {
+                switch (ch) {
+                    case KEY_UP: rollback_local_input(rb, UP); break;
+                    case KEY_RIGHT: rollback_local_input(rb, RIGHT); break;
+                    case KEY_DOWN: rollback_local_input(rb, DOWN); break;
+                    case KEY_LEFT: rollback_local_input(rb, LEFT); break;
+                    case 'q':
+                    case 'Q': running = 0; break;
+                }
+            }
+        }
+
+        double now = now_seconds();
+        if (now >= next_tick) {
+            if (bot) rollback_local_input(rb, policy_direction(POLICY_FLOOD, &rb->game, player - 1, &rng));
+            if (max_ticks == 0 || rb->tick < max_ticks) {
+                if (rollback_advance(rb)) {
+                    next_tick += tick_ms / 1000.0;
+                    if (next_tick < now) next_tick = now;
+                } else {
+                    next_tick = now + 0.005;  // en attente du pair : on réessaie bientôt
+                }
+            } else {
+                next_tick = now + tick_ms / 1000.0;
+            }
+            int length = rollback_encode(rb, packet, sizeof(packet));
+            if (length > 0) send(fd, packet, length, 0);
+            if (!bot) draw(rb);
+        }
+
+        // Mode --ticks : on continue d'envoyer un moment pour que le pair confirme aussi
+        if (max_ticks > 0 && rollback_confirmed(rb) >= max_ticks) {
+            if (done_at == 0) done_at = now;
+            else if (now - done_at > 0.5) break;
+        }
+        struct timespec ts = {0, 1000000L};
+        nanosleep(&ts, NULL);
+    }
+
+    if (!bot) endwin();
+    unsigned long hash = 0;
+    unsigned long last = rollback_confirmed(rb);
+    if (last > 0) rollback_hash(rb, last - 1, &hash);
+    printf("Joueur %d : %lu ticks (%lu confirmés), %lu rollbacks, %lu ticks re-simulés (max %lu), "
+           "%lu attentes, %lu empreintes comparées, empreinte %016lx\n",
+           player, rb->tick, last, rb->rollbacks, rb->resimulated, rb->max_depth, rb->stalls,
+           rb->hash_checks, hash);
+    int status = 0;
+    if (rb->desync_tick) {
+        printf("DÉSYNCHRONISATION au tick %lu\n", rb->desync_tick - 1);
+        status = 1;
+    }
+    rollback_free(rb);
+    free(rb);
+    close(fd);
+    return status;
+}
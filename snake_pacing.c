@@ -0,0 +1,43 @@
+#define _DEFAULT_SOURCE
+#include <string.h>
+#include "snake_pacing.h"
+
+void pacer_init(FramePacer *pacer, int fps) {
+    memset(pacer, 0, sizeof(*pacer));
+    pacer->interval_ms = fps > 0 ? 1000.0 / fps : 0;
+    pacer->dirty = 1;
+}
+
+void pacer_invalidate(FramePacer *pacer) {
+    pacer->dirty = 1;
+}
+
+// Retourne 1 s'il faut dessiner maintenant. Une image en attente (clé
+// changée mais plafond atteint) est reportée, pas abandonnée : elle part
+// dès que pacer_wait_ms laisse la boucle revenir.
+int pacer_should_render(FramePacer *pacer, unsigned long key, double now_ms) {
+    if ((key == pacer->key && !pacer->dirty) || now_ms < pacer->next_ms) {
+        pacer->skipped++;
+        return 0;
+    }
+    return 1;
+}
+
+void pacer_rendered(FramePacer *pacer, unsigned long key, double now_ms) {
+    pacer->key = key;
+    pacer->dirty = 0;
+    pacer->presented++;
+    pacer->next_ms = now_ms + pacer->interval_ms;
+}
+
+// Attente avant le prochain passage de boucle : jusqu'à l'échéance donnée
+// (tick ou animation), ou jusqu'au rendu permis si une image est en
+// attente, bornée à [0, PACER_MAX_WAIT_MS]. Les événements réveillent la
+// boucle plus tôt.
+double pacer_wait_ms(const FramePacer *pacer, unsigned long key, double now_ms, double deadline_ms) {
+    double wait = deadline_ms - now_ms;
+    if ((key != pacer->key || pacer->dirty) && pacer->next_ms - now_ms < wait) wait = pacer->next_ms - now_ms;
+    if (wait < 0) wait = 0;
+    if (wait > PACER_MAX_WAIT_MS) wait = PACER_MAX_WAIT_MS;
+    return wait;
+}
@@ -0,0 +1,32 @@
+#ifndef SNAKE_PACING_H
+#define SNAKE_PACING_H
+
+// Cadence d'affichage découplée de la simulation : une image n'est dessinée
+// que si l'état affiché a changé (clé d'affichage : tick, pause, phase
+// d'animation) ou si l'affichage a été invalidé (fenêtre exposée, textures
+// perdues), et jamais plus souvent que le plafond d'images par seconde.
+// Entre deux images, la boucle attend le prochain événement, tick ou
+// échéance d'animation au lieu de tourner à vide.
+
+// ===== CONSTANTES =====
+#define PACER_DEFAULT_FPS 60
+#define PACER_MAX_WAIT_MS 100
+
+// ===== STRUCTURES =====
+typedef struct {
+    double interval_ms;       // 1000 / plafond, 0 : pas de plafond
+    double next_ms;           // instant du prochain rendu permis
+    unsigned long key;        // clé d'affichage de la dernière image
+    int dirty;                // image à refaire même à clé égale
+    unsigned long presented;  // images dessinées
+    unsigned long skipped;    // passages de boucle sans image
+} FramePacer;
+
+// ===== PROTOTYPES =====
+void pacer_init(FramePacer *pacer, int fps);
+void pacer_invalidate(FramePacer *pacer);
+int pacer_should_render(FramePacer *pacer, unsigned long key, double now_ms);
+void pacer_rendered(FramePacer *pacer, unsigned long key, double now_ms);
+double pacer_wait_ms(const FramePacer *pacer, unsigned long key, double now_ms, double deadline_ms);
+
+#endif
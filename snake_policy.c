@@ -0,0 +1,88 @@
+#define _DEFAULT_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include "snake_policy.h"
+#include "snake_bitboard.h"
+
+static const char *policy_names[POLICY_COUNT] = {"straight", "random", "flood", "greedy"};
+
+int policy_parse(const char *name) {
+    for (int i = 0; i < POLICY_COUNT; i++) {
+        if (strcmp(name, policy_names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+const char *policy_name(PolicyKind kind) {
+    return kind >= 0 && kind < POLICY_COUNT ? policy_names[kind] : "?";
+}
+
+// Case atteinte en un pas ; en mode libre les bords se traversent.
+static Position policy_next(const Game *game, Position pos, Direction d) {
+    switch (d) {
+        case UP: pos.y--; break;
+        case RIGHT: pos.x++; break;
+        case DOWN: pos.y++; break;
+        case LEFT: pos.x--; break;
+    }
+    if (game->mode == MODE_FREE) {
+        pos.x = (pos.x + game->grid_width) % game->grid_width;
+        pos.y = (pos.y + game->grid_height) % game->grid_height;
+    }
+    return pos;
+}
+
+// Repas le plus proche de la tête (distance de Manhattan), poison exclu.
+// Retourne 0 s'il n'y en a aucun.
+static int nearest_food(const Game *game, Position head, Position *target) {
+    int best = -1;
+    for (int i = 0; i < game->food_count; i++) {
+        if (game->foods[i].type == FOOD_POISON) continue;
+        int distance = abs(game->foods[i].pos.x - head.x) + abs(game->foods[i].pos.y - head.y);
+        if (best < 0 || distance < best) {
+            best = distance;
+            *target = game->foods[i].pos;
+        }
+    }
+    return best >= 0;
+}
+
+// Garde sa direction (avec parfois un virage au hasard) et préfère une case
+// d'où il reste au moins sa longueur en cases atteignables (remplissage par
+// bitboards), sinon celle qui ouvre la plus grande région. En mode GREEDY,
+// parmi les cases sûres, celle qui rapproche le plus du repas visé ; sans
+// repas à viser (poison seul), il erre comme FLOOD.
+Direction policy_direction(PolicyKind kind, const Game *game, int player, unsigned int *rng) {
+    const Snake *snake = player ? &game->snake2 : &game->snake1;
+    Direction choice = snake->direction;
+    if (kind == POLICY_STRAIGHT) return choice;
+    Position target;
+    int hungry = kind == POLICY_GREEDY && nearest_food(game, snake->body[0], &target);
+    if (!hungry && snake_rand(rng) % 8 == 0) choice = (Direction)((choice + (snake_rand(rng) % 2 ? 1 : 3)) % 4);
+    if (kind == POLICY_RANDOM) return choice;
+
+    Bitboard passable;
+    if (!bitboard_game_passable(game, &passable)) return choice;
+    Direction best = choice, safest = choice;
+    long best_area = -1;
+    int best_distance = -1;
+    for (int k = 0; k < 4; k++) {
+        Direction d = (Direction)((choice + k) % 4);
+        if (d == (snake->direction + 2) % 4) continue;
+        Position next = policy_next(game, snake->body[0], d);
+        long area = bitboard_game_area(game, &passable, next);
+        if (area >= snake->length) {
+            if (!hungry) return d;
+            int distance = abs(target.x - next.x) + abs(target.y - next.y);
+            if (best_distance < 0 || distance < best_distance) {
+                best = d;
+                best_distance = distance;
+            }
+        }
+        if (area > best_area) {
+            safest = d;
+            best_area = area;
+        }
+    }
+    return best_distance >= 0 ? best : safest;
+}
@@ -0,0 +1,25 @@
+#ifndef SNAKE_POLICY_H
+#define SNAKE_POLICY_H
+
+#include "snake_core.h"
+
+// Joueurs automatiques : choisissent la prochaine direction d'un serpent à
+// partir de l'état de la partie. Le hasard vient de `rng` (snake_rand) :
+// même état et même générateur donnent la même direction, ce qui permet de
+// les utiliser en rollback et pour des passes de régression reproductibles.
+
+// ===== CONSTANTES =====
+typedef enum {
+    POLICY_STRAIGHT = 0,  // garde sa direction
+    POLICY_RANDOM,        // virage au hasard une fois sur huit, sans regarder
+    POLICY_FLOOD,         // évite les régions plus petites que le serpent
+    POLICY_GREEDY,        // comme FLOOD, en allant vers le repas le plus proche
+    POLICY_COUNT
+} PolicyKind;
+
+// ===== PROTOTYPES =====
+int policy_parse(const char *name);   // -1 si le nom est inconnu
+const char *policy_name(PolicyKind kind);
+Direction policy_direction(PolicyKind kind, const Game *game, int player, unsigned int *rng);
+
+#endif
@@ -0,0 +1,70 @@
+#define _DEFAULT_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "snake_profile.h"
+
+void profiler_init(TickProfiler *profiler) {
+    memset(profiler, 0, sizeof(*profiler));
+}
+
+double profiler_now_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+void profile_add(ProfileSeries *series, double ms) {
+    series->samples[series->next] = (float)ms;
+    series->next = (series->next + 1) % PROFILE_SAMPLES;
+    if (series->count < PROFILE_SAMPLES) series->count++;
+    series->total++;
+    series->sum += ms;
+    if (ms > series->max) series->max = ms;
+}
+
+// Un rendu qui dure plus d'une période d'affichage a manqué une
+// synchronisation verticale par période entière écoulée.
+void profile_render(TickProfiler *profiler, double ms) {
+    profile_add(&profiler->render, ms);
+    if (profiler->refresh_ms > 0) profiler->missed_vsyncs += (unsigned long)(ms / profiler->refresh_ms);
+}
+
+static int compare_floats(const void *a, const void *b) {
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+// Percentile (0..100) des derniers échantillons.
+double profile_percentile(const ProfileSeries *series, double p) {
+    if (series->count == 0) return 0;
+    float sorted[PROFILE_SAMPLES];
+    memcpy(sorted, series->samples, series->count * sizeof(float));
+    qsort(sorted, series->count, sizeof(float), compare_floats);
+    int index = (int)(p / 100.0 * (series->count - 1) + 0.5);
+    return sorted[index];
+}
+
+static void report_series(FILE *out, const char *name, const ProfileSeries *series) {
+    if (series->total == 0) {
+        fprintf(out, "%-20s %8s\n", name, "-");
+        return;
+    }
+    fprintf(out, "%-20s %8lu %9.3f %9.3f %9.3f %9.3f %9.3f\n", name, series->total,
+            series->sum / series->total, profile_percentile(series, 50),
+            profile_percentile(series, 95), profile_percentile(series, 99), series->max);
+}
+
+void profiler_report(const TickProfiler *profiler, FILE *out) {
+    fprintf(out, "%-20s %8s %9s %9s %9s %9s %9s\n", "série (ms)", "nombre", "moyenne", "p50", "p95", "p99",
+            "max");
+    report_series(out, "mise à jour", &profiler->update);
+    report_series(out, "frame", &profiler->frame);
+    report_series(out, "rendu", &profiler->render);
+    report_series(out, "latence entrée", &profiler->input_latency);
+    fprintf(out, "virages refusés : %lu\n", profiler->turns_rejected);
+    fprintf(out, "frames sans rendu : %lu, vsync manquées : %lu", profiler->frames_skipped,
+            profiler->missed_vsyncs);
+    if (profiler->refresh_ms > 0) fprintf(out, " (période %.2f ms)", profiler->refresh_ms);
+    fprintf(out, "\n");
+}
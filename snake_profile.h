@@ -0,0 +1,43 @@
+#ifndef SNAKE_PROFILE_H
+#define SNAKE_PROFILE_H
+
+#include <stdio.h>
+
+// Profileur de ticks : durée de mise à jour, durée de frame, durée de rendu
+// et latence entre une touche et le tick qui l'applique. Chaque série garde
+// ses derniers échantillons (pour les percentiles) et des totaux sur toute
+// la partie.
+
+// ===== CONSTANTES =====
+#define PROFILE_SAMPLES 4096
+
+// ===== STRUCTURES =====
+typedef struct {
+    float samples[PROFILE_SAMPLES];   // anneau des derniers échantillons (ms)
+    int count;
+    int next;
+    unsigned long total;
+    double sum;
+    double max;
+} ProfileSeries;
+
+typedef struct TickProfiler {
+    ProfileSeries update;          // move_snake + update_powerups
+    ProfileSeries frame;           // une itération complète de la boucle
+    ProfileSeries render;          // dessin + présentation, images dessinées seulement
+    ProfileSeries input_latency;   // touche -> tick qui applique le virage
+    unsigned long turns_rejected;  // demi-tours, répétitions, file pleine
+    unsigned long frames_skipped;  // itérations sans image (rien n'a changé)
+    unsigned long missed_vsyncs;   // rafraîchissements manqués par les rendus trop longs
+    double refresh_ms;             // période d'affichage (0 : inconnue)
+} TickProfiler;
+
+// ===== PROTOTYPES =====
+void profiler_init(TickProfiler *profiler);
+double profiler_now_ms();
+void profile_add(ProfileSeries *series, double ms);
+void profile_render(TickProfiler *profiler, double ms);
+double profile_percentile(const ProfileSeries *series, double p);
+void profiler_report(const TickProfiler *profiler, FILE *out);
+
+#endif
@@ -0,0 +1,444 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "snake_raster.h"
+#include "snake_font.h"
+
+#if !defined(SNAKE_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RASTER_X86 1
+#include <immintrin.h>
+#endif
+
+// Couleurs du front end SDL, en 0xAARRGGBB
+#define RGB(r, g, b) (0xFF000000u | (uint32_t)(r) << 16 | (uint32_t)(g) << 8 | (uint32_t)(b))
+static const uint32_t color_background = RGB(0, 0, 0);
+static const uint32_t color_border = RGB(0, 255, 255);
+static const uint32_t color_wall = RGB(255, 255, 255);
+static const uint32_t color_portal = RGB(255, 0, 255);
+static const uint32_t color_powerup = RGB(0, 255, 0);
+static const uint32_t color_pause = RGB(128, 128, 128);
+static const uint32_t color_hud[RASTER_HUD_LINES] = {RGB(255, 255, 255), RGB(0, 255, 0)};
+static const uint32_t snake_colors[2][2] = {
+    {RGB(0, 255, 0), RGB(255, 255, 0)},     // Joueur 1 : vert / jaune
+    {RGB(0, 255, 255), RGB(0, 0, 255)}      // Joueur 2 : cyan / bleu
+};
+
+static uint32_t food_color(int type) {
+    switch (type) {
+        case FOOD_GOLDEN: return RGB(255, 215, 0);
+        case FOOD_POISON: return RGB(255, 0, 255);
+        case FOOD_FAST: return RGB(0, 255, 255);
+        case FOOD_BONUS: return RGB(255, 255, 255);
+        default: return RGB(255, 0, 0);
+    }
+}
+
+// ===== REMPLISSAGE DE SEGMENTS =====
+
+static void fill_span_scalar(uint32_t *dst, int n, uint32_t color) {
+    for (int i = 0; i < n; i++) dst[i] = color;
+}
+
+#ifdef RASTER_X86
+__attribute__((target("sse2")))
+static void fill_span_sse2(uint32_t *dst, int n, uint32_t color) {
+    __m128i v = _mm_set1_epi32((int)color);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) _mm_storeu_si128((__m128i *)(dst + i), v);
+    for (; i < n; i++) dst[i] = color;
+}
+
+__attribute__((target("avx2")))
+static void fill_span_avx2(uint32_t *dst, int n, uint32_t color) {
+    __m256i v = _mm256_set1_epi32((int)color);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) _mm256_storeu_si256((__m256i *)(dst + i), v);
+    if (i + 4 <= n) {
+        _mm_storeu_si128((__m128i *)(dst + i), _mm256_castsi256_si128(v));
+        i += 4;
+    }
+    for (; i < n; i++) dst[i] = color;
+}
+#endif
+
+// NULL : pas encore choisi (meilleur niveau disponible au premier appel)
+static void (*fill_span)(uint32_t *dst, int n, uint32_t color) = NULL;
+static RasterSimd fill_level = RASTER_SCALAR;
+
+RasterSimd raster_simd_available() {
+#ifdef RASTER_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return RASTER_AVX2;
+    if (__builtin_cpu_supports("sse2")) return RASTER_SSE2;
+#endif
+    return RASTER_SCALAR;
+}
+
+// Impose un niveau (tests, benchmarks), ramené au meilleur disponible.
+// Retourne le niveau retenu.
+RasterSimd raster_set_simd(RasterSimd level) {
+    RasterSimd available = raster_simd_available();
+    fill_level = level > available ? available : level;
+    switch (fill_level) {
+#ifdef RASTER_X86
+        case RASTER_AVX2: fill_span = fill_span_avx2; break;
+        case RASTER_SSE2: fill_span = fill_span_sse2; break;
+#endif
+        default: fill_span = fill_span_scalar; break;
+    }
+    return fill_level;
+}
+
+// ===== IMAGE =====
+
+int raster_init(RasterImage *image, int width, int height) {
+    image->pixels = NULL;
+    image->width = width;
+    image->height = height;
+    if (width <= 0 || height <= 0) return 0;
+    image->pixels = malloc((size_t)width * height * sizeof(uint32_t));
+    if (!image->pixels) return 0;
+    if (!fill_span) raster_set_simd(raster_simd_available());
+    raster_clear(image, color_background);
+    return 1;
+}
+
+void raster_free(RasterImage *image) {
+    free(image->pixels);
+    image->pixels = NULL;
+}
+
+void raster_clear(RasterImage *image, uint32_t color) {
+    fill_span(image->pixels, image->width * image->height, color);
+}
+
+// Rectangle plein, découpé aux bords de l'image.
+void raster_fill_rect(RasterImage *image, int x, int y, int w, int h, uint32_t color) {
+    int x0 = x < 0 ? 0 : x, y0 = y < 0 ? 0 : y;
+    int x1 = x + w > image->width ? image->width : x + w;
+    int y1 = y + h > image->height ? image->height : y + h;
+    if (x0 >= x1 || y0 >= y1) return;
+    uint32_t *row = image->pixels + (size_t)y0 * image->width + x0;
+    for (int yy = y0; yy < y1; yy++, row += image->width) fill_span(row, x1 - x0, color);
+}
+
+// Contour d'un pixel, comme SDL_RenderDrawRect.
+void raster_outline_rect(RasterImage *image, int x, int y, int w, int h, uint32_t color) {
+    if (w <= 0 || h <= 0) return;
+    raster_fill_rect(image, x, y, w, 1, color);
+    raster_fill_rect(image, x, y + h - 1, w, 1, color);
+    raster_fill_rect(image, x, y, 1, h, color);
+    raster_fill_rect(image, x + w - 1, y, 1, h, color);
+}
+
+// Texte : les pixels allumés d'un glyphe sont regroupés en segments par
+// ligne, chaque segment remplit `scale` lignes de l'image.
+void raster_text(RasterImage *image, const char *text, int x, int y, int scale, uint32_t color) {
+    FontQuad quads[RASTER_HUD_TEXT];
+    int count = font_layout(text, x, y, scale, quads, RASTER_HUD_TEXT);
+    int index = 0;
+    for (const unsigned char *p = (const unsigned char *)text; *p && index < count; p++) {
+        if (*p == ' ') continue;
+        const FontQuad *q = &quads[index++];
+        for (int gy = 0; gy < FONT_GLYPH_H; gy++) {
+            int gx = 0;
+            while (gx < FONT_GLYPH_W) {
+                if (!font_glyph_pixel(*p, gx, gy)) {
+                    gx++;
+                    continue;
+                }
+                int start = gx;
+                while (gx < FONT_GLYPH_W && font_glyph_pixel(*p, gx, gy)) gx++;
+                raster_fill_rect(image, q->x + start * scale, q->y + gy * scale, (gx - start) * scale, scale, color);
+            }
+        }
+    }
+}
+
+// ===== HUD =====
+
+void raster_hud_from_game(const Game *game, HudState *state) {
+    memset(state, 0, sizeof(*state));  // octets de remplissage comparés par memcmp
+    state->multiplayer = game->multiplayer;
+    state->score[0] = game->multiplayer ? game->snake1.score : game->score;
+    state->score[1] = game->multiplayer ? game->snake2.score : 0;
+    state->level = game->level;
+    state->length = game->snake1.length;
+    state->lives = game->mode == MODE_ARCADE ? game->snake1.lives : 0;
+    state->powerups = (game->slow_timer > 0) | (game->invincible_timer > 0) << 1 |
+                      (game->multiplier_timer > 0) << 2 | (game->magnetic_timer > 0) << 3;
+}
+
+// Le flux ne transporte ni le mode ni les power-ups actifs : vies
+// affichées telles quelles, pas de ligne de power-ups.
+void raster_hud_from_frame(const StreamFrame *frame, HudState *state) {
+    memset(state, 0, sizeof(*state));
+    state->multiplayer = frame->snake_count > 1;
+    state->score[0] = state->multiplayer ? frame->snakes[0].score : frame->score;
+    state->score[1] = state->multiplayer ? frame->snakes[1].score : 0;
+    state->level = frame->level;
+    state->length = frame->snake_count > 0 ? frame->snakes[0].length : 0;
+    state->lives = frame->snake_count > 0 ? frame->snakes[0].lives : 0;
+}
+
+void raster_hud_text(const HudState *state, char lines[RASTER_HUD_LINES][RASTER_HUD_TEXT + 1]) {
+    size_t size = RASTER_HUD_TEXT + 1;
+    if (state->multiplayer) {
+        snprintf(lines[0], size, "P1: %d | P2: %d | Niveau: %d", state->score[0], state->score[1], state->level);
+    } else {
+        snprintf(lines[0], size, "Score: %d | Niveau: %d | Longueur: %d | Vies: %d", state->score[0],
+                 state->level, state->length, state->lives);
+    }
+    static const char *const names[4] = {"Lent", "Invincible", "x2", "Aimant"};
+    size_t used = 0;
+    lines[1][0] = '\0';
+    for (int i = 0; i < 4 && used < size; i++) {
+        if (!(state->powerups & (1 << i))) continue;
+        used += snprintf(lines[1] + used, size - used, "%s%s", used ? "  " : "Power-ups: ", names[i]);
+    }
+}
+
+int raster_hud_scale(int cell) {
+    return cell >= 16 ? 3 : cell >= 8 ? 2 : 1;
+}
+
+// Deux lignes de texte et une marge de 10 pixels au-dessus et au-dessous
+int raster_hud_height(int cell) {
+    return RASTER_HUD_LINES * (FONT_CELL_H + 2) * raster_hud_scale(cell) + 20;
+}
+
+// ===== PARTIE =====
+
+void raster_game_size(int grid_width, int grid_height, int cell, int *width, int *height) {
+    *width = grid_width * cell;
+    *height = grid_height * cell + raster_hud_height(cell);
+}
+
+static void draw_hud(RasterImage *image, const HudState *state, int cell) {
+    char lines[RASTER_HUD_LINES][RASTER_HUD_TEXT + 1];
+    raster_hud_text(state, lines);
+    int scale = raster_hud_scale(cell);
+    int y = image->height - raster_hud_height(cell) + 10;
+    for (int i = 0; i < RASTER_HUD_LINES; i++) {
+        raster_text(image, lines[i], 10, y + i * (FONT_CELL_H + 2) * scale, scale, color_hud[i]);
+    }
+}
+
+// Rectangle de pause au centre, opaque comme celui du front end SDL (le
+// renderer y dessine sans mélange).
+static void draw_pause(RasterImage *image) {
+    raster_fill_rect(image, image->width / 2 - 100, image->height / 2 - 20, 200, 40, color_pause);
+}
+
+static void fill_cell(RasterImage *image, int x, int y, int cell, uint32_t color) {
+    raster_fill_rect(image, x * cell, y * cell, cell, cell, color);
+}
+
+// Murs et portails : cases voisines d'une même ligne regroupées en un
+// rectangle, comme le front end SDL.
+static void draw_tiles(RasterImage *image, const TileMap *map, int cell) {
+    if (!map->tiles || (map->wall_count == 0 && map->portal_count == 0)) return;
+    for (int y = 0; y < map->height; y++) {
+        const Tile *row = map->tiles + (long)y * map->width;
+        int x = 0;
+        while (x < map->width) {
+            if (row[x] == TILE_EMPTY) {
+                x++;
+                continue;
+            }
+            int portal = tile_is_portal(row[x]);
+            int start = x;
+            while (x < map->width && row[x] != TILE_EMPTY && tile_is_portal(row[x]) == portal) x++;
+            raster_fill_rect(image, start * cell, y * cell, (x - start) * cell, cell,
+                             portal ? color_portal : color_wall);
+        }
+    }
+}
+
+// Le clignotement d'invincibilité suit les ticks (tête masquée un tick sur
+// deux) : deux rendus d'un même état donnent la même image.
+void raster_draw_game(RasterImage *image, const Game *game, int cell) {
+    raster_clear(image, color_background);
+    raster_outline_rect(image, 0, 0, game->grid_width * cell, game->grid_height * cell, color_border);
+    draw_tiles(image, &game->map, cell);
+    for (int i = 0; i < game->food_count; i++) {
+        fill_cell(image, game->foods[i].pos.x, game->foods[i].pos.y, cell, food_color(game->foods[i].type));
+    }
+    if (game->powerup.active) fill_cell(image, game->powerup.pos.x, game->powerup.pos.y, cell, color_powerup);
+    const Snake *snakes[2] = {&game->snake1, &game->snake2};
+    for (int s = 0; s < (game->multiplayer ? 2 : 1); s++) {
+        const Snake *snake = snakes[s];
+        int player = snake->player == 2 ? 1 : 0;
+        for (int i = 0; i < snake->length; i++) {
+            if (i == 0 && s == 0 && game->invincible_timer > 0 && (game->tick & 1)) continue;
+            fill_cell(image, snake->body[i].x, snake->body[i].y, cell, snake_colors[player][i == 0 ? 0 : 1]);
+        }
+    }
+    HudState state;
+    raster_hud_from_game(game, &state);
+    draw_hud(image, &state, cell);
+    if (game->paused) draw_pause(image);
+}
+
+void raster_draw_frame(RasterImage *image, const StreamFrame *frame, int cell) {
+    raster_clear(image, color_background);
+    raster_outline_rect(image, 0, 0, frame->width * cell, frame->height * cell, color_border);
+    for (int i = 0; i < frame->obstacle_count; i++) {
+        fill_cell(image, frame->obstacles[i].pos.x, frame->obstacles[i].pos.y, cell,
+                  frame->obstacles[i].type ? color_portal : color_wall);
+    }
+    for (int i = 0; i < frame->food_count; i++) {
+        fill_cell(image, frame->foods[i].pos.x, frame->foods[i].pos.y, cell, food_color(frame->foods[i].type));
+    }
+    if (frame->powerup_active) fill_cell(image, frame->powerup.pos.x, frame->powerup.pos.y, cell, color_powerup);
+    for (int s = 0; s < frame->snake_count && s < 2; s++) {
+        const StreamSnake *snake = &frame->snakes[s];
+        for (int i = 0; i < snake->length; i++) {
+            fill_cell(image, snake->body[i].x, snake->body[i].y, cell, snake_colors[s][i == 0 ? 0 : 1]);
+        }
+    }
+    HudState state;
+    raster_hud_from_frame(frame, &state);
+    draw_hud(image, &state, cell);
+    if (frame->paused || frame->game_over) draw_pause(image);
+}
+
+// ===== FICHIERS =====
+
+static void rgb_row(const RasterImage *image, int y, unsigned char *out) {
+    const uint32_t *row = image->pixels + (size_t)y * image->width;
+    for (int x = 0; x < image->width; x++) {
+        out[3 * x] = (unsigned char)(row[x] >> 16);
+        out[3 * x + 1] = (unsigned char)(row[x] >> 8);
+        out[3 * x + 2] = (unsigned char)row[x];
+    }
+}
+
+int raster_write_ppm(const RasterImage *image, const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) return 0;
+    unsigned char *row = malloc((size_t)image->width * 3);
+    int ok = row != NULL && fprintf(f, "P6\n%d %d\n255\n", image->width, image->height) > 0;
+    for (int y = 0; y < image->height && ok; y++) {
+        rgb_row(image, y, row);
+        ok = fwrite(row, 3, image->width, f) == (size_t)image->width;
+    }
+    free(row);
+    return fclose(f) == 0 && ok;
+}
+
+// PNG : CRC-32 de chaque bloc, Adler-32 du flux zlib
+static uint32_t crc_table[256];
+
+static void crc_init() {
+    if (crc_table[1]) return;
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        crc_table[n] = c;
+    }
+}
+
+typedef struct {
+    FILE *f;
+    uint32_t crc;
+    uint32_t adler_a, adler_b;
+    int ok;
+} PngWriter;
+
+static void png_put(PngWriter *w, const unsigned char *data, size_t size) {
+    for (size_t i = 0; i < size; i++) w->crc = crc_table[(w->crc ^ data[i]) & 0xFF] ^ (w->crc >> 8);
+    if (fwrite(data, 1, size, w->f) != size) w->ok = 0;
+}
+
+static void png_put_u32(PngWriter *w, uint32_t v) {
+    unsigned char b[4] = {(unsigned char)(v >> 24), (unsigned char)(v >> 16), (unsigned char)(v >> 8),
+                          (unsigned char)v};
+    png_put(w, b, 4);
+}
+
+static void png_begin_chunk(PngWriter *w, const char *type, uint32_t length) {
+    unsigned char b[4] = {(unsigned char)(length >> 24), (unsigned char)(length >> 16),
+                          (unsigned char)(length >> 8), (unsigned char)length};
+    if (fwrite(b, 1, 4, w->f) != 4) w->ok = 0;  // la longueur n'entre pas dans le CRC
+    w->crc = 0xFFFFFFFFu;
+    png_put(w, (const unsigned char *)type, 4);
+}
+
+static void png_end_chunk(PngWriter *w) {
+    uint32_t crc = w->crc ^ 0xFFFFFFFFu;
+    unsigned char b[4] = {(unsigned char)(crc >> 24), (unsigned char)(crc >> 16), (unsigned char)(crc >> 8),
+                          (unsigned char)crc};
+    if (fwrite(b, 1, 4, w->f) != 4) w->ok = 0;
+}
+
+// Données brutes (octet de filtre 0 + RGB par ligne) dans des blocs deflate
+// stockés de 65535 octets au plus, écrits au fil des lignes.
+static void png_put_raw(PngWriter *w, const unsigned char *data, size_t size, size_t *block_left,
+                        size_t *raw_left) {
+    while (size > 0) {
+        if (*block_left == 0) {
+            size_t block = *raw_left < 65535 ? *raw_left : 65535;
+            unsigned char header[5] = {(unsigned char)(block == *raw_left), (unsigned char)block,
+                                       (unsigned char)(block >> 8), (unsigned char)~block,
+                                       (unsigned char)(~block >> 8)};
+            png_put(w, header, 5);
+            *block_left = block;
+        }
+        size_t n = size < *block_left ? size : *block_left;
+        // Modulo différé : 5552 octets au plus entre deux réductions sans
+        // dépasser 32 bits (borne de zlib)
+        for (size_t i = 0; i < n;) {
+            size_t end = n - i < 5552 ? n : i + 5552;
+            for (; i < end; i++) {
+                w->adler_a += data[i];
+                w->adler_b += w->adler_a;
+            }
+            w->adler_a %= 65521;
+            w->adler_b %= 65521;
+        }
+        png_put(w, data, n);
+        data += n;
+        size -= n;
+        *block_left -= n;
+        *raw_left -= n;
+    }
+}
+
+int raster_write_png(const RasterImage *image, const char *path) {
+    static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    crc_init();
+    FILE *f = fopen(path, "wb");
+    if (!f) return 0;
+    PngWriter w = {f, 0, 1, 0, 1};
+    if (fwrite(signature, 1, 8, f) != 8) w.ok = 0;
+
+    png_begin_chunk(&w, "IHDR", 13);
+    png_put_u32(&w, (uint32_t)image->width);
+    png_put_u32(&w, (uint32_t)image->height);
+    const unsigned char format[5] = {8, 2, 0, 0, 0};   // 8 bits, RGB, deflate, filtre 0, sans entrelacement
+    png_put(&w, format, 5);
+    png_end_chunk(&w);
+
+    size_t raw = (size_t)image->height * (1 + (size_t)image->width * 3);
+    size_t blocks = raw / 65535 + (raw % 65535 != 0);
+    png_begin_chunk(&w, "IDAT", (uint32_t)(2 + raw + 5 * blocks + 4));
+    const unsigned char zlib_header[2] = {0x78, 0x01};
+    png_put(&w, zlib_header, 2);
+    unsigned char *row = malloc(1 + (size_t)image->width * 3);
+    if (!row) w.ok = 0;
+    size_t block_left = 0, raw_left = raw;
+    for (int y = 0; y < image->height && w.ok; y++) {
+        row[0] = 0;
+        rgb_row(image, y, row + 1);
+        png_put_raw(&w, row, 1 + (size_t)image->width * 3, &block_left, &raw_left);
+    }
+    free(row);
+    png_put_u32(&w, w.adler_b << 16 | w.adler_a);
+    png_end_chunk(&w);
+
+    png_begin_chunk(&w, "IEND", 0);
+    png_end_chunk(&w);
+    return fclose(f) == 0 && w.ok;
+}
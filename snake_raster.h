@@ -0,0 +1,71 @@
+#ifndef SNAKE_RASTER_H
+#define SNAKE_RASTER_H
+
+#include <stdint.h>
+#include "snake_core.h"
+#include "snake_stream.h"
+
+// Rendu logiciel : la partie (ou une image d'un flux spectateur) est
+// rasterisée dans un tampon de pixels en mémoire, sans SDL ni GPU. Mêmes
+// couleurs et même disposition que le front end SDL : grille, bordure,
+// obstacles, nourriture, serpents, puis le HUD en bas (police de
+// snake_font.h). Les rectangles sont remplis ligne par ligne par des
+// écritures de 4 (SSE2) ou 8 (AVX2) pixels ; repli scalaire hors x86 ou avec
+// -DSNAKE_NO_SIMD.
+//
+// Sorties : PPM (P6) et PNG (non compressé, blocs deflate stockés : aucune
+// dépendance), ou copie dans une texture SDL en streaming (ARGB8888).
+
+// ===== CONSTANTES =====
+#define RASTER_HUD_LINES 2
+#define RASTER_HUD_TEXT 96   // caractères par ligne de HUD
+
+typedef enum {
+    RASTER_SCALAR = 0, RASTER_SSE2, RASTER_AVX2
+} RasterSimd;
+
+// ===== STRUCTURES =====
+typedef struct {
+    int width;
+    int height;
+    uint32_t *pixels;   // 0xAARRGGBB, ligne par ligne (pas = width)
+} RasterImage;
+
+// Valeurs affichées par le HUD ; les rendus ne remettent le texte en page
+// que quand elles changent.
+typedef struct {
+    int multiplayer;
+    int score[2];
+    int level;
+    int length;
+    int lives;
+    int powerups;   // bits : lent, invincible, multiplicateur, aimant
+} HudState;
+
+// ===== PROTOTYPES =====
+RasterSimd raster_simd_available();
+RasterSimd raster_set_simd(RasterSimd level);
+
+int raster_init(RasterImage *image, int width, int height);
+void raster_free(RasterImage *image);
+void raster_clear(RasterImage *image, uint32_t color);
+void raster_fill_rect(RasterImage *image, int x, int y, int w, int h, uint32_t color);
+void raster_outline_rect(RasterImage *image, int x, int y, int w, int h, uint32_t color);
+void raster_text(RasterImage *image, const char *text, int x, int y, int scale, uint32_t color);
+
+// HUD commun aux rendus (SDL et logiciel)
+void raster_hud_from_game(const Game *game, HudState *state);
+void raster_hud_from_frame(const StreamFrame *frame, HudState *state);
+void raster_hud_text(const HudState *state, char lines[RASTER_HUD_LINES][RASTER_HUD_TEXT + 1]);
+int raster_hud_scale(int cell);
+int raster_hud_height(int cell);
+
+// Taille d'image pour une grille : la grille puis la bande du HUD
+void raster_game_size(int grid_width, int grid_height, int cell, int *width, int *height);
+void raster_draw_game(RasterImage *image, const Game *game, int cell);
+void raster_draw_frame(RasterImage *image, const StreamFrame *frame, int cell);
+
+int raster_write_ppm(const RasterImage *image, const char *path);
+int raster_write_png(const RasterImage *image, const char *path);
+
+#endif
@@ -0,0 +1,208 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "snake_rollback.h"
+
+// Paquet (petit-boutiste) :
+//   u8 type, u32 graine, u32 premier tick, u8 nombre d'entrées, une direction
+//   par octet, u32 acquittement (entrées du pair reçues), u32 tick de
+//   l'empreinte + 1 (0 : aucune), u64 empreinte
+#define ROLLBACK_PACKET 0x52
+#define ROLLBACK_HEADER 10
+#define ROLLBACK_TRAILER 16
+
+// ===== ENCODAGE =====
+
+static void put32(unsigned char *p, unsigned long v) {
+    for (int i = 0; i < 4; i++) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static unsigned long get32(const unsigned char *p) {
+    unsigned long v = 0;
+    for (int i = 0; i < 4; i++) v |= (unsigned long)p[i] << (8 * i);
+    return v;
+}
+
+// ===== SIMULATION =====
+
+int rollback_init(Rollback *rb, int local, GameMode mode, Difficulty diff,
+                  unsigned int seed, int input_delay) {
+    memset(rb, 0, sizeof(*rb));
+    rb->states = calloc(ROLLBACK_WINDOW, sizeof(Game));
+    if (!rb->states) return 0;
+    if (!init_game_seeded(&rb->game, mode, diff, 1, seed)) {
+        rollback_free(rb);
+        return 0;
+    }
+    rb->local = local ? 1 : 0;
+    rb->input_delay = input_delay < 0 ? 0 : input_delay;
+    rb->seed = seed;
+    rb->local_direction = RIGHT;
+
+    // Les premiers ticks n'ont pas d'entrée : les deux serpents partent à droite
+    for (int p = 0; p < 2; p++) {
+        for (int t = 0; t < rb->input_delay; t++) rb->inputs[p][t % ROLLBACK_HISTORY] = RIGHT;
+        rb->known[p] = rb->input_delay;
+    }
+    return 1;
+}
+
+void rollback_free(Rollback *rb) {
+    free(rb->states);
+    rb->states = NULL;
+    free_game(&rb->game);
+}
+
+// Un tick avec la direction voulue par chaque joueur. Toute la simulation
+// passe par ici : c'est ce qui garantit que les deux pairs calculent la même
+// chose à partir des mêmes entrées.
+void rollback_step(Game *game, const unsigned char inputs[2]) {
+    Snake *snakes[2] = {&game->snake1, &game->snake2};
+    for (int p = 0; p < 2; p++) {
+        snakes[p]->turn_count = 0;
+        queue_turn(snakes[p], (Direction)inputs[p], 0);
+    }
+    step_game(game);
+}
+
+static void simulate(Rollback *rb, unsigned long t) {
+    int remote = 1 - rb->local;
+    unsigned char inputs[2];
+    inputs[rb->local] = rb->inputs[rb->local][t % ROLLBACK_HISTORY];
+    if (t < rb->known[remote]) {
+        inputs[remote] = rb->inputs[remote][t % ROLLBACK_HISTORY];
+    } else {
+        // Prédiction : le joueur distant garde sa dernière direction connue
+        inputs[remote] = rb->known[remote] > 0
+            ? rb->inputs[remote][(rb->known[remote] - 1) % ROLLBACK_HISTORY] : RIGHT;
+    }
+    rb->used[t % ROLLBACK_HISTORY] = inputs[remote];
+    game_copy_state(&rb->states[t % ROLLBACK_WINDOW], &rb->game);
+    rollback_step(&rb->game, inputs);
+    rb->hashes[t % ROLLBACK_HISTORY] = game_hash(&rb->game);
+}
+
+void rollback_local_input(Rollback *rb, Direction direction) {
+    rb->local_direction = direction;
+}
+
+// Entrée du joueur distant pour un tick. Les entrées doivent arriver dans
+// l'ordre : une entrée déjà connue est ignorée, une entrée après un trou est
+// refusée (retourne 0) en attendant que la répétition comble le trou.
+int rollback_remote_input(Rollback *rb, unsigned long tick, Direction direction) {
+    int remote = 1 - rb->local;
+    if (tick < rb->known[remote]) return 1;
+    if (tick > rb->known[remote] || tick >= rb->tick + ROLLBACK_HISTORY / 2) return 0;
+    rb->inputs[remote][tick % ROLLBACK_HISTORY] = (unsigned char)direction;
+    rb->known[remote]++;
+    if (tick < rb->tick && rb->used[tick % ROLLBACK_HISTORY] != direction && tick < rb->resim_from) {
+        rb->resim_from = tick;
+    }
+    return 1;
+}
+
+// Simule un tick. Corrige d'abord les ticks mal prédits (restauration de
+// l'instantané puis re-simulation). Retourne 0 sans rien faire si la
+// partie a déjà ROLLBACK_WINDOW ticks d'avance sur le joueur distant.
+int rollback_advance(Rollback *rb) {
+    int remote = 1 - rb->local;
+    if (rb->tick >= rb->known[remote] + ROLLBACK_WINDOW) {
+        rb->stalls++;
+        return 0;
+    }
+
+    if (rb->resim_from < rb->tick) {
+        unsigned long depth = rb->tick - rb->resim_from;
+        rb->rollbacks++;
+        rb->resimulated += depth;
+        if (depth > rb->max_depth) rb->max_depth = depth;
+        game_copy_state(&rb->game, &rb->states[rb->resim_from % ROLLBACK_WINDOW]);
+        for (unsigned long t = rb->resim_from; t < rb->tick; t++) simulate(rb, t);
+    }
+
+    while (rb->known[rb->local] <= rb->tick + rb->input_delay) {
+        rb->inputs[rb->local][rb->known[rb->local] % ROLLBACK_HISTORY] = (unsigned char)rb->local_direction;
+        rb->known[rb->local]++;
+    }
+    simulate(rb, rb->tick);
+    rb->tick++;
+    rb->resim_from = rb->tick;
+    return 1;
+}
+
+// Les ticks < rollback_confirmed sont définitifs : entrées des deux joueurs
+// connues et état re-simulé si besoin.
+unsigned long rollback_confirmed(const Rollback *rb) {
+    unsigned long confirmed = rb->tick;
+    if (rb->resim_from < confirmed) confirmed = rb->resim_from;
+    for (int p = 0; p < 2; p++) {
+        if (rb->known[p] < confirmed) confirmed = rb->known[p];
+    }
+    return confirmed;
+}
+
+// Empreinte de l'état après un tick définitif encore dans l'historique.
+int rollback_hash(const Rollback *rb, unsigned long tick, unsigned long *hash) {
+    if (tick >= rollback_confirmed(rb) || rb->tick - tick > ROLLBACK_HISTORY) return 0;
+    *hash = rb->hashes[tick % ROLLBACK_HISTORY];
+    return 1;
+}
+
+// ===== PAQUETS =====
+
+int rollback_encode(Rollback *rb, unsigned char *buffer, int capacity) {
+    unsigned long last = rb->known[rb->local];
+    unsigned long first = rb->peer_known;
+    if (first > last) first = last;
+    if (last - first > ROLLBACK_MAX_RESEND) first = last - ROLLBACK_MAX_RESEND;
+    int count = (int)(last - first);
+    int size = ROLLBACK_HEADER + count + ROLLBACK_TRAILER;
+    if (size > capacity) return 0;
+
+    buffer[0] = ROLLBACK_PACKET;
+    put32(buffer + 1, rb->seed);
+    put32(buffer + 5, first);
+    buffer[9] = (unsigned char)count;
+    for (int i = 0; i < count; i++) {
+        buffer[ROLLBACK_HEADER + i] = rb->inputs[rb->local][(first + i) % ROLLBACK_HISTORY];
+    }
+    unsigned char *trailer = buffer + ROLLBACK_HEADER + count;
+    put32(trailer, rb->known[1 - rb->local]);
+    unsigned long confirmed = rollback_confirmed(rb);
+    unsigned long hash = 0;
+    if (confirmed > 0 && rollback_hash(rb, confirmed - 1, &hash)) {
+        put32(trailer + 4, confirmed);
+    } else {
+        put32(trailer + 4, 0);
+    }
+    put32(trailer + 8, hash & 0xffffffffUL);
+    put32(trailer + 12, hash >> 32);
+    return size;
+}
+
+// Retourne 0 si le paquet est invalide ou vient d'une partie différente.
+int rollback_decode(Rollback *rb, const unsigned char *data, int size) {
+    if (size < ROLLBACK_HEADER + ROLLBACK_TRAILER || data[0] != ROLLBACK_PACKET ||
+        get32(data + 1) != rb->seed || size != ROLLBACK_HEADER + data[9] + ROLLBACK_TRAILER) {
+        rb->packets_ignored++;
+        return 0;
+    }
+    unsigned long first = get32(data + 5);
+    int count = data[9];
+    for (int i = 0; i < count; i++) {
+        rollback_remote_input(rb, first + i, (Direction)(data[ROLLBACK_HEADER + i] & 3));
+    }
+
+    const unsigned char *trailer = data + ROLLBACK_HEADER + count;
+    unsigned long ack = get32(trailer);
+    if (ack > rb->peer_known) rb->peer_known = ack;
+    unsigned long hash_tick = get32(trailer + 4);
+    unsigned long theirs = get32(trailer + 8) | (get32(trailer + 12) << 32);
+    unsigned long mine;
+    if (hash_tick > 0 && rollback_hash(rb, hash_tick - 1, &mine)) {
+        rb->hash_checks++;
+        if (mine != theirs && rb->desync_tick == 0) rb->desync_tick = hash_tick;
+    }
+    return 1;
+}
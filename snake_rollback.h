@@ -0,0 +1,73 @@
+#ifndef SNAKE_ROLLBACK_H
+#define SNAKE_ROLLBACK_H
+
+#include "snake_core.h"
+
+// Lockstep avec rollback pour deux joueurs (boucle locale ou réseau local).
+//
+// Chaque pair simule la même partie (init_game_seeded, même graine). Une
+// entrée est la direction voulue par un joueur à un tick donné ; l'entrée
+// locale est programmée `input_delay` ticks à l'avance et envoyée à l'autre
+// pair. Quand l'entrée distante d'un tick n'est pas encore arrivée, on prédit
+// la dernière direction connue et on avance quand même. Si la vraie entrée
+// diffère de la prédiction, on restaure l'instantané pris avant ce tick et on
+// re-simule jusqu'au tick courant.
+//
+// On ne prend jamais plus de ROLLBACK_WINDOW ticks d'avance sur la dernière
+// entrée distante confirmée (rollback_advance retourne 0 : il faut attendre).
+// Le module ne fait pas d'entrées/sorties : les paquets sont encodés et
+// décodés ici, l'envoi (UDP dans snake_netplay.c) est à la charge de l'appelant.
+// Chaque paquet répète toutes les entrées que le pair n'a pas acquittées et
+// porte l'empreinte (game_hash) du dernier tick définitif, comparée à la
+// réception pour détecter une désynchronisation.
+
+// ===== CONSTANTES =====
+#define ROLLBACK_WINDOW 16          // ticks d'avance maximum (instantanés conservés)
+#define ROLLBACK_HISTORY 256        // entrées et empreintes conservées, par tick
+#define ROLLBACK_DEFAULT_DELAY 2    // ticks entre la touche et son exécution
+#define ROLLBACK_MAX_PACKET 96
+#define ROLLBACK_MAX_RESEND 64      // entrées répétées par paquet au plus
+
+// ===== STRUCTURES =====
+typedef struct {
+    Game game;                  // état courant, avant le tick `tick`
+    Game *states;               // states[t % ROLLBACK_WINDOW] : état avant le tick t
+    unsigned long tick;         // prochain tick à simuler
+    int local;                  // 0 : snake1, 1 : snake2
+    int input_delay;
+    unsigned int seed;
+
+    // inputs[p][t % ROLLBACK_HISTORY] : direction du joueur p au tick t,
+    // connue pour tous les t < known[p]
+    unsigned char inputs[2][ROLLBACK_HISTORY];
+    unsigned long known[2];
+    unsigned char used[ROLLBACK_HISTORY];     // entrée distante utilisée (prédite ou non)
+    unsigned long hashes[ROLLBACK_HISTORY];   // game_hash après le tick t
+    unsigned long resim_from;                 // premier tick à re-simuler (= tick : rien)
+    Direction local_direction;                // dernière direction demandée localement
+    unsigned long peer_known;                 // entrées locales reçues par le pair
+
+    // Statistiques
+    unsigned long rollbacks;
+    unsigned long resimulated;  // ticks re-simulés au total
+    unsigned long max_depth;    // plus long rollback (ticks)
+    unsigned long stalls;       // appels à rollback_advance bloqués par la fenêtre
+    unsigned long hash_checks;
+    unsigned long desync_tick;  // 0 : aucune ; sinon premier tick divergent + 1
+    unsigned long packets_ignored;
+} Rollback;
+
+// ===== PROTOTYPES =====
+int rollback_init(Rollback *rb, int local, GameMode mode, Difficulty diff,
+                  unsigned int seed, int input_delay);
+void rollback_free(Rollback *rb);
+void rollback_step(Game *game, const unsigned char inputs[2]);
+void rollback_local_input(Rollback *rb, Direction direction);
+int rollback_remote_input(Rollback *rb, unsigned long tick, Direction direction);
+int rollback_advance(Rollback *rb);
+unsigned long rollback_confirmed(const Rollback *rb);
+int rollback_hash(const Rollback *rb, unsigned long tick, unsigned long *hash);
+int rollback_encode(Rollback *rb, unsigned char *buffer, int capacity);
+int rollback_decode(Rollback *rb, const unsigned char *data, int size);
+
+#endif
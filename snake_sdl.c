@@ -0,0 +1,444 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "snake_sdl.h"
+#include "snake_font.h"
+#include "snake_raster.h"
+
+// Couleurs tête / corps par joueur
+static const SDL_Color snake_colors[2][2] = {
+    {{0, 255, 0, 255}, {255, 255, 0, 255}},   // Joueur 1 : vert / jaune
+    {{0, 255, 255, 255}, {0, 0, 255, 255}}    // Joueur 2 : cyan / bleu
+};
+
+// SDL globals
+SDL_Window *window = NULL;
+SDL_Renderer *renderer = NULL;
+int screen_w = SCREEN_WIDTH;
+int screen_h = SCREEN_HEIGHT;
+
+// Atlas de la police du HUD (snake_font.h), NULL : HUD masqué
+static SDL_Texture *font_atlas = NULL;
+
+// Couche statique (bordure, murs, portails) rendue dans une texture cible
+static SDL_Texture *static_texture = NULL;
+static int static_texture_w = 0;
+static int static_texture_h = 0;
+static unsigned int static_texture_version = 0;
+static int static_texture_ready = 0;
+static int static_texture_disabled = 0;  // pas de texture cible : rectangles
+
+// Rendu logiciel dans une texture en streaming (--software)
+int software_render = 0;
+static RasterImage soft_image = {0, 0, NULL};
+static SDL_Texture *soft_texture = NULL;
+
+// Appels SDL_Render* qui dessinent (effacement, rectangles, copies,
+// géométrie, présentation) : le coût par image mesuré par bench_render.c
+unsigned long sdl_draw_calls = 0;
+
+// ===== IMPLÉMENTATION =====
+
+int init_sdl() {
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        fprintf(stderr, "Erreur SDL: %s\n", SDL_GetError());
+        return 0;
+    }
+    
+    window = SDL_CreateWindow("Jeu du Serpent",
+                              SDL_WINDOWPOS_UNDEFINED,
+                              SDL_WINDOWPOS_UNDEFINED,
+                              screen_w, screen_h,
+                              SDL_WINDOW_SHOWN);
+    
+    if (!window) {
+        fprintf(stderr, "Erreur création fenêtre: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 0;
+    }
+    
+    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (!renderer) {
+        // Pas d'accélération (pilote "dummy", serveur sans GPU) : renderer logiciel
+        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+    }
+    if (!renderer) {
+        fprintf(stderr, "Erreur création renderer: %s\n", SDL_GetError());
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 0;
+    }
+    
+    if (!create_font_atlas()) fprintf(stderr, "Attention : atlas de police indisponible, HUD masqué\n");
+    return 1;
+}
+
+void cleanup_sdl() {
+    if (soft_texture) SDL_DestroyTexture(soft_texture);
+    soft_texture = NULL;
+    raster_free(&soft_image);
+    if (font_atlas) SDL_DestroyTexture(font_atlas);
+    font_atlas = NULL;
+    if (static_texture) SDL_DestroyTexture(static_texture);
+    static_texture = NULL;
+    static_texture_ready = 0;
+    if (renderer) SDL_DestroyRenderer(renderer);
+    if (window) SDL_DestroyWindow(window);
+    SDL_Quit();
+}
+
+// Textures cibles perdues (SDL_RENDER_TARGETS_RESET) : couche statique à
+// refaire ; pilote réinitialisé (SDL_RENDER_DEVICE_RESET) : toutes les
+// textures sont perdues et recréées à la prochaine image.
+void sdl_handle_render_event(const SDL_Event *e) {
+    if (e->type == SDL_RENDER_TARGETS_RESET) {
+        static_texture_ready = 0;
+    } else if (e->type == SDL_RENDER_DEVICE_RESET) {
+        if (static_texture) SDL_DestroyTexture(static_texture);
+        static_texture = NULL;
+        static_texture_ready = 0;
+        if (font_atlas) SDL_DestroyTexture(font_atlas);
+        create_font_atlas();
+        if (soft_texture) SDL_DestroyTexture(soft_texture);
+        soft_texture = NULL;
+    }
+}
+
+void draw_rect(int x, int y, int w, int h, SDL_Color color) {
+    SDL_Rect rect = {x, y, w, h};
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderFillRect(renderer, &rect);
+    sdl_draw_calls++;
+}
+
+// Murs et portails : les cases voisines d'une même ligne sont fusionnées en
+// rectangles, recalculés seulement quand la version de la carte change, puis
+// dessinés en un appel SDL_RenderFillRects par couleur.
+static SDL_Rect *wall_rects = NULL;
+static SDL_Rect *portal_rects = NULL;
+static int wall_rect_count = 0;
+static int portal_rect_count = 0;
+static int static_rect_capacity = 0;
+static unsigned int static_layer_version = 0;
+
+static void build_static_rects(const TileMap *map) {
+    int needed = map->width * map->height;
+    if (needed > static_rect_capacity) {
+        SDL_Rect *walls = realloc(wall_rects, needed * sizeof(SDL_Rect));
+        if (walls) wall_rects = walls;
+        SDL_Rect *portals = realloc(portal_rects, needed * sizeof(SDL_Rect));
+        if (portals) portal_rects = portals;
+        if (!walls || !portals) return;
+        static_rect_capacity = needed;
+    }
+    wall_rect_count = 0;
+    portal_rect_count = 0;
+    for (int y = 0; y < map->height; y++) {
+        const Tile *row = map->tiles + y * map->width;
+        int x = 0;
+        while (x < map->width) {
+            if (row[x] == TILE_EMPTY) {
+                x++;
+                continue;
+            }
+            int portal = tile_is_portal(row[x]);
+            int start = x;
+            while (x < map->width && row[x] != TILE_EMPTY && tile_is_portal(row[x]) == portal) x++;
+            SDL_Rect rect = {start * CELL_SIZE, y * CELL_SIZE, (x - start) * CELL_SIZE, CELL_SIZE};
+            if (portal) portal_rects[portal_rect_count++] = rect;
+            else wall_rects[wall_rect_count++] = rect;
+        }
+    }
+    static_layer_version = map->version;
+}
+
+static void fill_static_rects() {
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderFillRects(renderer, wall_rects, wall_rect_count);
+    SDL_SetRenderDrawColor(renderer, 255, 0, 255, 255);
+    SDL_RenderFillRects(renderer, portal_rects, portal_rect_count);
+    sdl_draw_calls += 2;
+}
+
+static void draw_border(const Game *game) {
+    SDL_SetRenderDrawColor(renderer, 0, 255, 255, 255);
+    SDL_Rect border = {0, 0, game->grid_width * CELL_SIZE, game->grid_height * CELL_SIZE};
+    SDL_RenderDrawRect(renderer, &border);
+    sdl_draw_calls++;
+}
+
+// Couche statique complète (fond de la grille, bordure, murs, portails)
+// rendue une fois dans une texture cible, puis copiée en un SDL_RenderCopy
+// par image. Refaite quand la carte change (version) ou quand le pilote perd
+// ses textures cibles (SDL_RENDER_TARGETS_RESET).
+static int build_static_texture(const Game *game) {
+    int w = game->grid_width * CELL_SIZE, h = game->grid_height * CELL_SIZE;
+    if (!SDL_RenderTargetSupported(renderer)) {
+        static_texture_disabled = 1;
+        return 0;
+    }
+    if (static_texture && (static_texture_w != w || static_texture_h != h)) {
+        SDL_DestroyTexture(static_texture);
+        static_texture = NULL;
+    }
+    if (!static_texture) {
+        static_texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+        if (!static_texture) {
+            static_texture_disabled = 1;
+            return 0;
+        }
+        static_texture_w = w;
+        static_texture_h = h;
+    }
+    if (game->obstacle_count > 0 && static_layer_version != game->map.version) build_static_rects(&game->map);
+    if (game->obstacle_count > 0 && static_layer_version != game->map.version) return 0;
+    if (SDL_SetRenderTarget(renderer, static_texture) != 0) return 0;
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    sdl_draw_calls++;
+    draw_border(game);
+    if (game->obstacle_count > 0) fill_static_rects();
+    SDL_SetRenderTarget(renderer, NULL);
+    static_texture_version = game->map.version;
+    static_texture_ready = 1;
+    return 1;
+}
+
+// Bordure et obstacles. Sans texture cible (pilote qui n'en a pas, création
+// refusée), repli sur les rectangles fusionnés : un appel par couleur.
+void draw_static_layer(Game *game) {
+    int stale = !static_texture_ready || static_texture_version != game->map.version ||
+                static_texture_w != game->grid_width * CELL_SIZE || static_texture_h != game->grid_height * CELL_SIZE;
+    if (stale && !static_texture_disabled) {
+        static_texture_ready = 0;
+        build_static_texture(game);
+    }
+    if (static_texture_ready) {
+        SDL_Rect dst = {0, 0, static_texture_w, static_texture_h};
+        SDL_RenderCopy(renderer, static_texture, NULL, &dst);
+        sdl_draw_calls++;
+        return;
+    }
+    
+    draw_border(game);
+    if (game->obstacle_count == 0) return;
+    if (static_layer_version != game->map.version) build_static_rects(&game->map);
+    if (static_layer_version != game->map.version) return;
+    fill_static_rects();
+}
+
+// ===== HUD =====
+
+// Texte du HUD : police intégrée (snake_font.h) dans un atlas chargé une
+// fois au démarrage. Les lignes ne sont remises en page que si une valeur
+// affichée change (HudState, commun avec le rendu logiciel), dans des
+// tampons statiques de sommets ; chaque ligne est ensuite un seul appel
+// SDL_RenderGeometry. Aucune allocation par image.
+typedef struct {
+    SDL_Vertex vertices[RASTER_HUD_TEXT * 4];
+    int quads;
+} HudLine;
+
+static HudLine hud_lines[RASTER_HUD_LINES];
+static int hud_indices[RASTER_HUD_TEXT * 6];
+static HudState hud_state;
+static int hud_ready = 0;
+
+int create_font_atlas() {
+    static uint32_t pixels[FONT_ATLAS_W * FONT_ATLAS_H];
+    font_build_atlas(pixels, FONT_ATLAS_W, 0xFFFFFFFFu, 0);
+    font_atlas = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC,
+                                   FONT_ATLAS_W, FONT_ATLAS_H);
+    if (!font_atlas) return 0;
+    SDL_UpdateTexture(font_atlas, NULL, pixels, FONT_ATLAS_W * sizeof(uint32_t));
+    SDL_SetTextureBlendMode(font_atlas, SDL_BLENDMODE_BLEND);
+    for (int i = 0; i < RASTER_HUD_TEXT; i++) {
+        static const int corners[6] = {0, 1, 2, 2, 1, 3};
+        for (int k = 0; k < 6; k++) hud_indices[i * 6 + k] = i * 4 + corners[k];
+    }
+    hud_ready = 0;
+    return 1;
+}
+
+static void layout_hud_line(HudLine *line, const char *text, int x, int y, int scale, SDL_Color color) {
+    FontQuad quads[RASTER_HUD_TEXT];
+    line->quads = font_layout(text, x, y, scale, quads, RASTER_HUD_TEXT);
+    for (int i = 0; i < line->quads; i++) {
+        const FontQuad *q = &quads[i];
+        float u0 = (float)q->u / FONT_ATLAS_W, v0 = (float)q->v / FONT_ATLAS_H;
+        float u1 = (float)(q->u + FONT_GLYPH_W) / FONT_ATLAS_W, v1 = (float)(q->v + FONT_GLYPH_H) / FONT_ATLAS_H;
+        SDL_Vertex *v = &line->vertices[i * 4];
+        v[0] = (SDL_Vertex){{q->x, q->y}, color, {u0, v0}};
+        v[1] = (SDL_Vertex){{q->x + q->w, q->y}, color, {u1, v0}};
+        v[2] = (SDL_Vertex){{q->x, q->y + q->h}, color, {u0, v1}};
+        v[3] = (SDL_Vertex){{q->x + q->w, q->y + q->h}, color, {u1, v1}};
+    }
+}
+
+// Même disposition que le rendu logiciel : bande du HUD en bas de la fenêtre
+static void layout_hud(const HudState *state) {
+    static const SDL_Color colors[RASTER_HUD_LINES] = {{255, 255, 255, 255}, {0, 255, 0, 255}};
+    char lines[RASTER_HUD_LINES][RASTER_HUD_TEXT + 1];
+    raster_hud_text(state, lines);
+    int scale = raster_hud_scale(CELL_SIZE);
+    int y = screen_h - raster_hud_height(CELL_SIZE) + 10;
+    for (int i = 0; i < RASTER_HUD_LINES; i++) {
+        layout_hud_line(&hud_lines[i], lines[i], 10, y + i * (FONT_CELL_H + 2) * scale, scale, colors[i]);
+    }
+}
+
+void draw_hud(Game *game) {
+    if (!font_atlas) return;
+    HudState state;
+    raster_hud_from_game(game, &state);
+    if (!hud_ready || memcmp(&state, &hud_state, sizeof(state)) != 0) {
+        layout_hud(&state);
+        hud_state = state;
+        hud_ready = 1;
+    }
+    for (int i = 0; i < RASTER_HUD_LINES; i++) {
+        if (hud_lines[i].quads == 0) continue;
+        SDL_RenderGeometry(renderer, font_atlas, hud_lines[i].vertices, hud_lines[i].quads * 4, hud_indices,
+                           hud_lines[i].quads * 6);
+        sdl_draw_calls++;
+    }
+}
+
+// ===== RENDU LOGICIEL (--software) =====
+
+// L'image entière est rasterisée en mémoire (snake_raster.h) puis copiée
+// dans une texture en streaming : un seul SDL_RenderCopy par image.
+
+static void draw_game_software(Game *game) {
+    if (!soft_image.pixels && !raster_init(&soft_image, screen_w, screen_h)) return;
+    if (!soft_texture) {
+        soft_texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+                                         soft_image.width, soft_image.height);
+        if (!soft_texture) return;
+    }
+    raster_draw_game(&soft_image, game, CELL_SIZE);
+    SDL_UpdateTexture(soft_texture, NULL, soft_image.pixels, soft_image.width * sizeof(uint32_t));
+    SDL_RenderCopy(renderer, soft_texture, NULL, NULL);
+    SDL_RenderPresent(renderer);
+    sdl_draw_calls += 2;
+}
+
+// ===== PARTIE ET FLUX SPECTATEUR =====
+
+static SDL_Color food_color(int type) {
+    switch (type) {
+        case FOOD_GOLDEN: return (SDL_Color){255, 215, 0, 255};
+        case FOOD_POISON: return (SDL_Color){255, 0, 255, 255};
+        case FOOD_FAST: return (SDL_Color){0, 255, 255, 255};
+        case FOOD_BONUS: return (SDL_Color){255, 255, 255, 255};
+        default: return (SDL_Color){255, 0, 0, 255};
+    }
+}
+
+void draw_game(Game *game) {
+    if (software_render) {
+        draw_game_software(game);
+        return;
+    }
+    
+    // Fond noir
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    sdl_draw_calls++;
+    
+    // Bordure et obstacles
+    draw_static_layer(game);
+    
+    // Nourriture
+    for (int i = 0; i < game->food_count; i++) {
+        int x = game->foods[i].pos.x * CELL_SIZE;
+        int y = game->foods[i].pos.y * CELL_SIZE;
+        draw_rect(x, y, CELL_SIZE, CELL_SIZE, food_color(game->foods[i].type));
+    }
+    
+    // Power-up
+    if (game->powerup.active) {
+        int x = game->powerup.pos.x * CELL_SIZE;
+        int y = game->powerup.pos.y * CELL_SIZE;
+        draw_rect(x, y, CELL_SIZE, CELL_SIZE, (SDL_Color){0, 255, 0, 255});
+    }
+    
+    // Serpent 1
+    for (int i = 0; i < game->snake1.length; i++) {
+        int x = game->snake1.body[i].x * CELL_SIZE;
+        int y = game->snake1.body[i].y * CELL_SIZE;
+        SDL_Color color = snake_colors[game->snake1.player - 1][i == 0 ? 0 : 1];
+        if (i == 0 && game->invincible_timer > 0) {
+            // Clignotement pour invincibilité
+            if ((SDL_GetTicks() / 100) % 2) {
+                draw_rect(x, y, CELL_SIZE, CELL_SIZE, color);
+            }
+        } else {
+            draw_rect(x, y, CELL_SIZE, CELL_SIZE, color);
+        }
+    }
+    
+    // Serpent 2 (multijoueur)
+    if (game->multiplayer) {
+        for (int i = 0; i < game->snake2.length; i++) {
+            int x = game->snake2.body[i].x * CELL_SIZE;
+            int y = game->snake2.body[i].y * CELL_SIZE;
+            SDL_Color color = snake_colors[game->snake2.player - 1][i == 0 ? 0 : 1];
+            draw_rect(x, y, CELL_SIZE, CELL_SIZE, color);
+        }
+    }
+    
+    // HUD (texte)
+    draw_hud(game);
+    
+    if (game->paused) {
+        // Dessiner un rectangle semi-transparent pour la pause
+        SDL_SetRenderDrawColor(renderer, 128, 128, 128, 128);
+        SDL_Rect pause_rect = {screen_w / 2 - 100, screen_h / 2 - 20, 200, 40};
+        SDL_RenderFillRect(renderer, &pause_rect);
+        sdl_draw_calls++;
+    }
+    
+    SDL_RenderPresent(renderer);
+    sdl_draw_calls++;
+}
+
+void draw_stream_frame(const StreamFrame *frame) {
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, 0, 255, 255, 255);
+    SDL_Rect border = {0, 0, frame->width * CELL_SIZE, frame->height * CELL_SIZE};
+    SDL_RenderDrawRect(renderer, &border);
+    sdl_draw_calls += 2;
+    
+    for (int i = 0; i < frame->obstacle_count; i++) {
+        SDL_Color color = frame->obstacles[i].type ? (SDL_Color){255, 0, 255, 255}
+                                                   : (SDL_Color){255, 255, 255, 255};
+        draw_rect(frame->obstacles[i].pos.x * CELL_SIZE, frame->obstacles[i].pos.y * CELL_SIZE,
+                  CELL_SIZE, CELL_SIZE, color);
+    }
+    for (int i = 0; i < frame->food_count; i++) {
+        draw_rect(frame->foods[i].pos.x * CELL_SIZE, frame->foods[i].pos.y * CELL_SIZE,
+                  CELL_SIZE, CELL_SIZE, food_color(frame->foods[i].type));
+    }
+    if (frame->powerup_active) {
+        draw_rect(frame->powerup.pos.x * CELL_SIZE, frame->powerup.pos.y * CELL_SIZE,
+                  CELL_SIZE, CELL_SIZE, (SDL_Color){0, 255, 0, 255});
+    }
+    for (int s = 0; s < frame->snake_count; s++) {
+        const StreamSnake *snake = &frame->snakes[s];
+        for (int i = 0; i < snake->length; i++) {
+            draw_rect(snake->body[i].x * CELL_SIZE, snake->body[i].y * CELL_SIZE,
+                      CELL_SIZE, CELL_SIZE, snake_colors[s][i == 0 ? 0 : 1]);
+        }
+    }
+    if (frame->paused || frame->game_over) {
+        SDL_SetRenderDrawColor(renderer, 128, 128, 128, 128);
+        SDL_Rect pause_rect = {screen_w / 2 - 100, screen_h / 2 - 20, 200, 40};
+        SDL_RenderFillRect(renderer, &pause_rect);
+        sdl_draw_calls++;
+    }
+    SDL_RenderPresent(renderer);
+    sdl_draw_calls++;
+}
@@ -0,0 +1,36 @@
+#ifndef SNAKE_SDL_H
+#define SNAKE_SDL_H
+
+#include <SDL2/SDL.h>
+#include "snake_core.h"
+#include "snake_stream.h"
+
+// Rendu SDL de la partie et du flux spectateur, séparé de la boucle de jeu
+// (snake.c) pour que bench_render.c puisse appeler draw_game sur des états
+// synthétiques, avec le pilote vidéo "dummy" et le renderer logiciel.
+
+// ===== CONSTANTES =====
+#define CELL_SIZE 20
+#define SCREEN_WIDTH (GRID_WIDTH * CELL_SIZE)
+#define SCREEN_HEIGHT (GRID_HEIGHT * CELL_SIZE + 100)  // +100 pour le HUD
+
+// ===== GLOBALES =====
+extern SDL_Window *window;
+extern SDL_Renderer *renderer;
+extern int screen_w;
+extern int screen_h;
+extern int software_render;          // --software : image rasterisée puis copiée
+extern unsigned long sdl_draw_calls; // appels de dessin SDL depuis le début
+
+// ===== PROTOTYPES =====
+int init_sdl();
+void cleanup_sdl();
+void sdl_handle_render_event(const SDL_Event *e);
+void draw_rect(int x, int y, int w, int h, SDL_Color color);
+void draw_static_layer(Game *game);
+int create_font_atlas();
+void draw_hud(Game *game);
+void draw_game(Game *game);
+void draw_stream_frame(const StreamFrame *frame);
+
+#endif
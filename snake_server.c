@@ -0,0 +1,107 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include "snake_net.h"
+
+// Serveur de partie en réseau local (UDP) : possède la simulation et envoie
+// à chaque client un delta par tick. Les places libres sont jouées par l'IA.
+//
+//   ./snake_server [--port P] [--size WxH] [--clients N] [--bots N]
+//                  [--tick-ms MS] [--seed S]
+
+static volatile sig_atomic_t running = 1;
+
+static void on_signal(int sig) {
+    (void)sig;
+    running = 0;
+}
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double cpu_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+    int port = NET_DEFAULT_PORT;
+    int width = 80, height = 40;
+    int max_clients = 8, bots = 8;
+    int tick_ms = 100;
+    unsigned int seed = (unsigned int)time(NULL);
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+            port = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &width, &height) != 2) width = 0;
+        } else if (strcmp(argv[i], "--clients") == 0 && i + 1 < argc) {
+            max_clients = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--bots") == 0 && i + 1 < argc) {
+            bots = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--tick-ms") == 0 && i + 1 < argc) {
+            tick_ms = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "Usage : %s [--port P] [--size WxH] [--clients N] [--bots N] "
+                            "[--tick-ms MS] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (tick_ms <= 0) tick_ms = 100;
+
+    NetServer server;
+    if (!net_server_init(&server, port, width, height, max_clients, bots, 128, 8, seed)) {
+        fprintf(stderr, "Erreur : impossible de démarrer le serveur (port %d, %dx%d, %d places)\n",
+                port, width, height, max_clients);
+        return 1;
+    }
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    printf("Serveur sur le port %d : grille %dx%d, %d places, %d bots, tick %d ms\n",
+           server.port, width, height, max_clients, bots, tick_ms);
+
+    double next_tick = now_seconds();
+    double report_time = next_tick + 5.0;
+    double cpu_start = cpu_seconds();
+    unsigned long bytes_start = 0;
+    while (running) {
+        net_server_poll(&server);
+        double now = now_seconds();
+        if (now >= next_tick) {
+            net_server_step(&server);
+            net_server_flush(&server);
+            next_tick += tick_ms / 1000.0;
+            if (next_tick < now) next_tick = now;  // pas de rattrapage en rafale
+        }
+        if (now >= report_time) {
+            unsigned long bytes = 0;
+            for (int i = 0; i < NET_MAX_CLIENTS; i++) bytes += server.clients[i].bytes_sent;
+            double cpu = cpu_seconds();
+            printf("tick %lu : %d client(s), %.1f ko/s envoyés, CPU %.1f %%\n", server.arena.tick,
+                   server.client_count, (bytes - bytes_start) / 5.0 / 1024.0,
+                   (cpu - cpu_start) / 5.0 * 100.0);
+            fflush(stdout);
+            bytes_start = bytes;
+            cpu_start = cpu;
+            report_time = now + 5.0;
+        }
+        double wait = next_tick - now_seconds();
+        if (wait > 0.001) wait = 0.001;  // on relit le réseau toutes les millisecondes
+        if (wait > 0) {
+            struct timespec ts = {0, (long)(wait * 1e9)};
+            nanosleep(&ts, NULL);
+        }
+    }
+    net_server_free(&server);
+    return 0;
+}
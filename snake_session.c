@@ -0,0 +1,315 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "snake_session.h"
+
+// En-têtes : 16 octets pour le journal (les enregistrements restent alignés
+// sur 8 octets dans la projection), 32 pour l'index.
+typedef struct {
+    char magic[8];
+    uint32_t record_size;
+    uint32_t reserved;
+} SessionLogHeader;
+
+typedef struct {
+    char magic[8];
+    uint32_t record_size;
+    uint32_t block_records;
+    uint64_t blocks;
+    int64_t first_time;     // date du premier enregistrement : un journal recréé invalide l'index
+} SessionIndexHeader;
+
+static const char log_magic[8] = "SNKLOG1";
+static const char index_magic[8] = "SNKIDX1";
+
+_Static_assert(sizeof(SessionRecord) == 48, "SessionRecord : 48 octets");
+_Static_assert(sizeof(SessionLogHeader) % 8 == 0, "Enregistrements alignés");
+
+// ===== ENREGISTREMENTS =====
+
+void session_record_fill(SessionRecord *record, const Game *game, unsigned int seed, int flags) {
+    memset(record, 0, sizeof(*record));
+    record->end_time = (int64_t)time(NULL);
+    record->ticks = game->tick;
+    record->seed = seed;
+    record->score = game->score;
+    record->score2 = game->multiplayer ? game->snake2.score : 0;
+    record->time_played = game->time_played;
+    record->food_eaten = game->food_eaten;
+    record->level = (int16_t)game->level;
+    record->length = (int16_t)game->snake1.length;
+    record->mode = (uint8_t)game->mode;
+    record->difficulty = (uint8_t)game->difficulty;
+    record->players = game->multiplayer ? 2 : 1;
+    record->winner = (uint8_t)game->winner;
+    record->lives = (uint8_t)(game->snake1.lives > 0 ? game->snake1.lives : 0);
+    record->flags = (uint8_t)flags;
+}
+
+// ===== ÉCRITURE =====
+
+// Journal neuf : l'en-tête est écrit dans un fichier temporaire puis lié sous
+// le nom final, pour qu'aucun autre processus ne voie un journal sans en-tête.
+static int create_log(const char *path) {
+    char temp[4096];
+    if (snprintf(temp, sizeof(temp), "%s.XXXXXX", path) >= (int)sizeof(temp)) return 0;
+    int fd = mkstemp(temp);
+    if (fd < 0) return 0;
+    SessionLogHeader header = {{0}, sizeof(SessionRecord), 0};
+    memcpy(header.magic, log_magic, sizeof(header.magic));
+    int ok = fchmod(fd, 0644) == 0 && write(fd, &header, sizeof(header)) == (ssize_t)sizeof(header);
+    close(fd);
+    if (ok && link(temp, path) != 0 && errno != EEXIST) ok = 0;
+    unlink(temp);
+    return ok;
+}
+
+int session_log_open(SessionLog *log, const char *path, int sync_every) {
+    memset(log, 0, sizeof(*log));
+    log->fd = -1;
+    log->sync_every = sync_every;
+    int fd = open(path, O_RDWR | O_APPEND);
+    if (fd < 0 && errno == ENOENT && create_log(path)) fd = open(path, O_RDWR | O_APPEND);
+    if (fd < 0) return 0;
+    SessionLogHeader header;
+    if (pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+        memcmp(header.magic, log_magic, sizeof(header.magic)) != 0 || header.record_size != sizeof(SessionRecord)) {
+        close(fd);
+        return 0;
+    }
+    // Enregistrement tronqué par une écriture interrompue : retiré avant
+    // d'ajouter, sans quoi tous les enregistrements suivants seraient décalés.
+    // La taille vue sans verrou peut tomber au milieu du write() d'un autre
+    // processus : elle est relue sous verrou exclusif, qui attend la fin des
+    // écritures en cours (verrou partagé, session_log_flush).
+    struct stat st;
+    int ok = fstat(fd, &st) == 0;
+    if (ok && (st.st_size - (off_t)sizeof(header)) % (off_t)sizeof(SessionRecord) != 0) {
+        ok = flock(fd, LOCK_EX) == 0 && fstat(fd, &st) == 0;
+        off_t tail = ok ? (st.st_size - (off_t)sizeof(header)) % (off_t)sizeof(SessionRecord) : 0;
+        if (tail != 0) ok = ftruncate(fd, st.st_size - tail) == 0;
+        flock(fd, LOCK_UN);
+    }
+    if (!ok) {
+        close(fd);
+        return 0;
+    }
+    log->fd = fd;
+    return 1;
+}
+
+// Écrit le tampon en un seul write(), sous verrou partagé : la réparation
+// d'une fin tronquée (session_log_open) ne coupe pas une écriture en cours.
+// Une écriture partielle (disque plein) laisserait les ajouts suivants
+// décalés : le journal est alors fermé.
+int session_log_flush(SessionLog *log) {
+    if (log->fd < 0) return 0;
+    if (log->buffered == 0) return 1;
+    size_t size = log->buffered * sizeof(SessionRecord);
+    if (flock(log->fd, LOCK_SH) != 0) return 0;
+    ssize_t written = write(log->fd, log->buffer, size);
+    flock(log->fd, LOCK_UN);
+    if (written != (ssize_t)size) {
+        if (written > 0) {
+            close(log->fd);
+            log->fd = -1;
+        }
+        log->buffered = 0;
+        return 0;
+    }
+    log->written += log->buffered;
+    log->unsynced += log->buffered;
+    log->buffered = 0;
+    if (log->sync_every > 0 && log->unsynced >= log->sync_every) {
+        fdatasync(log->fd);
+        log->syncs++;
+        log->unsynced = 0;
+    }
+    return 1;
+}
+
+int session_log_append(SessionLog *log, const SessionRecord *record) {
+    if (log->fd < 0) return 0;
+    log->buffer[log->buffered++] = *record;
+    if (log->buffered == SESSION_BUFFER_RECORDS) return session_log_flush(log);
+    return 1;
+}
+
+int session_log_close(SessionLog *log) {
+    if (log->fd < 0) return 0;
+    int ok = session_log_flush(log);
+    if (log->fd < 0) return 0;
+    if (log->unsynced > 0) {
+        ok = fdatasync(log->fd) == 0 && ok;
+        log->syncs++;
+        log->unsynced = 0;
+    }
+    ok = close(log->fd) == 0 && ok;
+    log->fd = -1;
+    return ok;
+}
+
+// Une partie, un enregistrement : pour les front ends qui jouent une partie
+// par lancement.
+int session_log_game(const char *path, const Game *game, unsigned int seed, int flags) {
+    SessionLog log;
+    if (!session_log_open(&log, path, 0)) return 0;
+    SessionRecord record;
+    session_record_fill(&record, game, seed, flags);
+    session_log_append(&log, &record);
+    return session_log_close(&log);
+}
+
+// ===== LECTURE =====
+
+int session_map_open(SessionMap *map, const char *path) {
+    memset(map, 0, sizeof(*map));
+    map->fd = -1;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(SessionLogHeader)) {
+        close(fd);
+        return 0;
+    }
+    void *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return 0;
+    }
+    const SessionLogHeader *header = base;
+    if (memcmp(header->magic, log_magic, sizeof(header->magic)) != 0 || header->record_size != sizeof(SessionRecord)) {
+        munmap(base, (size_t)st.st_size);
+        close(fd);
+        return 0;
+    }
+    map->fd = fd;
+    map->base = base;
+    map->size = (size_t)st.st_size;
+    map->records = (const SessionRecord *)(map->base + sizeof(SessionLogHeader));
+    map->count = (map->size - sizeof(SessionLogHeader)) / sizeof(SessionRecord);
+    return 1;
+}
+
+void session_map_close(SessionMap *map) {
+    if (map->base) munmap((void *)map->base, map->size);
+    if (map->fd >= 0) close(map->fd);
+    memset(map, 0, sizeof(*map));
+    map->fd = -1;
+}
+
+// ===== INDEX =====
+
+static void summarize_block(SessionBlock *block, const SessionRecord *records, size_t count) {
+    memset(block, 0, sizeof(*block));
+    block->first_time = records[0].end_time;
+    block->last_time = records[0].end_time;
+    for (size_t i = 0; i < count; i++) {
+        const SessionRecord *record = &records[i];
+        if (record->end_time < block->first_time) block->first_time = record->end_time;
+        if (record->end_time > block->last_time) block->last_time = record->end_time;
+        if (record->mode < SESSION_MODES && record->difficulty < SESSION_DIFFICULTIES) {
+            block->counts[record->mode * SESSION_DIFFICULTIES + record->difficulty]++;
+        }
+    }
+}
+
+// Reprend les blocs déjà résumés dans le fichier, résume les blocs complets
+// ajoutés depuis et les écrit à la suite (blocs d'abord, en-tête ensuite).
+// Si le fichier ne peut pas être écrit, l'index reste utilisable en mémoire.
+int session_index_open(SessionIndex *index, const char *path, const SessionMap *map) {
+    memset(index, 0, sizeof(*index));
+    size_t full = map->count / SESSION_BLOCK_RECORDS;
+    index->blocks = malloc((full > 0 ? full : 1) * sizeof(SessionBlock));
+    if (!index->blocks) return 0;
+    int64_t first_time = map->count > 0 ? map->records[0].end_time : 0;
+
+    size_t known = 0;
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    SessionIndexHeader header;
+    if (fd >= 0 && pread(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header) &&
+        memcmp(header.magic, index_magic, sizeof(header.magic)) == 0 && header.record_size == sizeof(SessionRecord) &&
+        header.block_records == SESSION_BLOCK_RECORDS && header.blocks <= full && header.first_time == first_time) {
+        ssize_t bytes = (ssize_t)(header.blocks * sizeof(SessionBlock));
+        if (pread(fd, index->blocks, bytes, sizeof(header)) == bytes) known = header.blocks;
+    }
+    for (size_t b = known; b < full; b++) {
+        summarize_block(&index->blocks[b], map->records + b * SESSION_BLOCK_RECORDS, SESSION_BLOCK_RECORDS);
+    }
+    index->count = full;
+
+    index->saved = fd >= 0;
+    if (fd >= 0 && (full > known || known == 0)) {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, index_magic, sizeof(header.magic));
+        header.record_size = sizeof(SessionRecord);
+        header.block_records = SESSION_BLOCK_RECORDS;
+        header.blocks = full;
+        header.first_time = first_time;
+        ssize_t bytes = (ssize_t)((full - known) * sizeof(SessionBlock));
+        off_t offset = (off_t)(sizeof(header) + known * sizeof(SessionBlock));
+        index->saved = pwrite(fd, index->blocks + known, bytes, offset) == bytes &&
+                       pwrite(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header) &&
+                       ftruncate(fd, offset + bytes) == 0;
+    }
+    if (fd >= 0) close(fd);
+    return 1;
+}
+
+void session_index_free(SessionIndex *index) {
+    free(index->blocks);
+    memset(index, 0, sizeof(*index));
+}
+
+// ===== REQUÊTES =====
+
+static int record_matches(const SessionRecord *record, const SessionQuery *query) {
+    return (query->mode < 0 || record->mode == query->mode) &&
+           (query->difficulty < 0 || record->difficulty == query->difficulty) &&
+           (query->since == 0 || record->end_time >= query->since) &&
+           (query->until == 0 || record->end_time < query->until);
+}
+
+static int block_may_match(const SessionBlock *block, const SessionQuery *query) {
+    if (query->since != 0 && block->last_time < query->since) return 0;
+    if (query->until != 0 && block->first_time >= query->until) return 0;
+    for (int m = 0; m < SESSION_MODES; m++) {
+        if (query->mode >= 0 && m != query->mode) continue;
+        for (int d = 0; d < SESSION_DIFFICULTIES; d++) {
+            if (query->difficulty >= 0 && d != query->difficulty) continue;
+            if (block->counts[m * SESSION_DIFFICULTIES + d] > 0) return 1;
+        }
+    }
+    return 0;
+}
+
+size_t session_query(const SessionMap *map, const SessionIndex *index, const SessionQuery *query,
+                     void (*visit)(const SessionRecord *record, void *context), void *context,
+                     SessionScan *scan) {
+    SessionScan local = {0, 0, 0, 0};
+    size_t indexed = index ? index->count : 0;
+    for (size_t begin = 0, b = 0; begin < map->count; begin += SESSION_BLOCK_RECORDS, b++) {
+        if (b < indexed && !block_may_match(&index->blocks[b], query)) {
+            local.blocks_skipped++;
+            continue;
+        }
+        size_t end = begin + SESSION_BLOCK_RECORDS < map->count ? begin + SESSION_BLOCK_RECORDS : map->count;
+        local.blocks_read++;
+        local.records_read += end - begin;
+        for (size_t i = begin; i < end; i++) {
+            if (!record_matches(&map->records[i], query)) continue;
+            local.matched++;
+            if (visit) visit(&map->records[i], context);
+        }
+    }
+    if (scan) *scan = local;
+    return local.matched;
+}
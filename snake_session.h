@@ -0,0 +1,125 @@
+#ifndef SNAKE_SESSION_H
+#define SNAKE_SESSION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "snake_core.h"
+
+// Journal des parties : chaque partie terminée est ajoutée en fin de fichier
+// sous forme d'un enregistrement de taille fixe, derrière un en-tête de 16
+// octets. Les ajouts passent par un tampon écrit en un seul write() sur un
+// descripteur O_APPEND, toujours par enregistrements entiers : plusieurs
+// processus peuvent écrire dans le même journal. fdatasync n'est appelé que
+// tous les `sync_every` enregistrements et à la fermeture. Chaque write() se
+// fait sous verrou flock partagé ; la réparation d'une fin tronquée à
+// l'ouverture prend le verrou exclusif.
+//
+// Lecture par mmap. L'index (CHEMIN.idx) résume chaque bloc complet de
+// SESSION_BLOCK_RECORDS enregistrements : dates extrêmes et nombre de
+// parties par mode et difficulté. Une requête ne lit que les blocs qui
+// peuvent contenir des parties retenues, plus le bloc incomplet de la fin.
+// L'index est complété à chaque ouverture avec les blocs ajoutés depuis.
+//
+// Un enregistrement tronqué en fin de journal (écriture interrompue) est
+// ignoré à la lecture et retiré par session_log_open. Entiers dans l'ordre de la machine : le journal ne change pas
+// d'architecture.
+
+// ===== CONSTANTES =====
+#define SESSION_LOG_DEFAULT ".snake_sessions"
+#define SESSION_BUFFER_RECORDS 64
+#define SESSION_SYNC_EVERY 4096   // fdatasync par lots pour les longues séries
+#define SESSION_BLOCK_RECORDS 256
+#define SESSION_MODES 4
+#define SESSION_DIFFICULTIES 4
+
+// Drapeaux d'un enregistrement
+#define SESSION_TRUNCATED 0x01   // arrêtée par une limite de ticks, pas par la fin de partie
+#define SESSION_HEADLESS 0x02    // jouée sans affichage (joueurs automatiques)
+
+// ===== STRUCTURES =====
+typedef struct {
+    int64_t end_time;       // fin de partie (secondes depuis 1970)
+    uint64_t ticks;
+    uint32_t seed;
+    int32_t score;
+    int32_t score2;         // serpent 2 (multijoueur), 0 sinon
+    int32_t time_played;    // secondes
+    int32_t food_eaten;
+    int16_t level;
+    int16_t length;
+    uint8_t mode;
+    uint8_t difficulty;
+    uint8_t players;
+    uint8_t winner;
+    uint8_t lives;
+    uint8_t flags;
+    uint8_t reserved[2];
+} SessionRecord;
+
+typedef struct {
+    int fd;
+    int sync_every;         // enregistrements entre deux fdatasync (0 : à la fermeture seulement)
+    int unsynced;
+    int buffered;
+    SessionRecord buffer[SESSION_BUFFER_RECORDS];
+    unsigned long written;
+    unsigned long syncs;
+} SessionLog;
+
+typedef struct {
+    int fd;
+    const unsigned char *base;
+    size_t size;
+    const SessionRecord *records;
+    size_t count;
+} SessionMap;
+
+typedef struct {
+    int64_t first_time;     // plus petite et plus grande date du bloc
+    int64_t last_time;
+    uint32_t counts[SESSION_MODES * SESSION_DIFFICULTIES];
+} SessionBlock;
+
+typedef struct {
+    SessionBlock *blocks;
+    size_t count;
+    int saved;              // 0 : index calculé en mémoire, fichier non écrit
+} SessionIndex;
+
+typedef struct {
+    int mode;               // -1 : tous les modes
+    int difficulty;         // -1 : toutes
+    int64_t since;          // end_time >= since (0 : pas de borne)
+    int64_t until;          // end_time < until (0 : pas de borne)
+} SessionQuery;
+
+typedef struct {
+    size_t blocks_read;
+    size_t blocks_skipped;
+    size_t records_read;
+    size_t matched;
+} SessionScan;
+
+// ===== PROTOTYPES =====
+void session_record_fill(SessionRecord *record, const Game *game, unsigned int seed, int flags);
+
+int session_log_open(SessionLog *log, const char *path, int sync_every);
+int session_log_append(SessionLog *log, const SessionRecord *record);
+int session_log_flush(SessionLog *log);
+int session_log_close(SessionLog *log);
+int session_log_game(const char *path, const Game *game, unsigned int seed, int flags);
+
+int session_map_open(SessionMap *map, const char *path);
+void session_map_close(SessionMap *map);
+
+int session_index_open(SessionIndex *index, const char *path, const SessionMap *map);
+void session_index_free(SessionIndex *index);
+
+// Appelle `visit` pour chaque partie retenue, dans l'ordre du journal.
+// index peut être NULL (lecture de tout le journal). Retourne le nombre de
+// parties retenues ; scan peut être NULL.
+size_t session_query(const SessionMap *map, const SessionIndex *index, const SessionQuery *query,
+                     void (*visit)(const SessionRecord *record, void *context), void *context,
+                     SessionScan *scan);
+
+#endif
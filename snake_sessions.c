@@ -0,0 +1,163 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "snake_session.h"
+#include "snake_profile.h"
+
+// Requêtes sur le journal des parties (snake_session.h) :
+//
+//   ./snake_sessions [--log CHEMIN] [--mode classic|arcade|challenge|free]
+//                    [--difficulty easy|medium|hard|extreme] [--days N]
+//                    [--no-index]
+//
+// Affiche, pour les parties retenues, nombre, moyenne, p50, p95, p99 et
+// maximum du score, de la longueur, du niveau, des repas, des ticks et de la
+// durée, avec les blocs lus et ignorés grâce à l'index (CHEMIN.idx, complété
+// au passage). --days N : parties finies dans les N derniers jours.
+
+static const char *mode_names[] = {"classic", "arcade", "challenge", "free"};
+static const char *difficulty_names[] = {"easy", "medium", "hard", "extreme"};
+
+static int parse_name(const char *value, const char *const *names, int count) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(value, names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+// ===== STATISTIQUES =====
+
+enum { FIELD_SCORE, FIELD_LENGTH, FIELD_LEVEL, FIELD_FOOD, FIELD_TICKS, FIELD_TIME, FIELD_COUNT };
+static const char *field_names[FIELD_COUNT] = {"score", "longueur", "niveau", "repas", "ticks", "durée (s)"};
+
+typedef struct {
+    double *values[FIELD_COUNT];
+    size_t count;
+    size_t capacity;
+    int failed;
+} Collected;
+
+static void collect(const SessionRecord *record, void *context) {
+    Collected *collected = context;
+    if (collected->failed) return;
+    if (collected->count == collected->capacity) {
+        size_t capacity = collected->capacity ? collected->capacity * 2 : 4096;
+        for (int f = 0; f < FIELD_COUNT; f++) {
+            double *grown = realloc(collected->values[f], capacity * sizeof(double));
+            if (!grown) {
+                collected->failed = 1;
+                return;
+            }
+            collected->values[f] = grown;
+        }
+        collected->capacity = capacity;
+    }
+    size_t i = collected->count++;
+    collected->values[FIELD_SCORE][i] = record->score;
+    collected->values[FIELD_LENGTH][i] = record->length;
+    collected->values[FIELD_LEVEL][i] = record->level;
+    collected->values[FIELD_FOOD][i] = record->food_eaten;
+    collected->values[FIELD_TICKS][i] = (double)record->ticks;
+    collected->values[FIELD_TIME][i] = record->time_played;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Même rang que profile_percentile, sur un tableau trié
+static double sorted_percentile(const double *sorted, size_t count, double p) {
+    return sorted[(size_t)(p / 100.0 * (count - 1) + 0.5)];
+}
+
+static void report(Collected *collected) {
+    printf("%-10s %12s %10s %10s %10s %10s\n", "", "moyenne", "p50", "p95", "p99", "max");
+    for (int f = 0; f < FIELD_COUNT; f++) {
+        double *values = collected->values[f];
+        size_t count = collected->count;
+        double sum = 0;
+        for (size_t i = 0; i < count; i++) sum += values[i];
+        qsort(values, count, sizeof(double), compare_doubles);
+        printf("%-10s %12.1f %10.0f %10.0f %10.0f %10.0f\n", field_names[f], sum / count,
+               sorted_percentile(values, count, 50), sorted_percentile(values, count, 95),
+               sorted_percentile(values, count, 99), values[count - 1]);
+    }
+}
+
+// ===== PROGRAMME PRINCIPAL =====
+
+int main(int argc, char *argv[]) {
+    const char *path = SESSION_LOG_DEFAULT;
+    SessionQuery query = {-1, -1, 0, 0};
+    int use_index = 1, ok = 1;
+    for (int i = 1; i < argc && ok; i++) {
+        if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+            path = argv[++i];
+        } else if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc) {
+            query.mode = parse_name(argv[++i], mode_names, 4);
+            ok = query.mode >= 0;
+        } else if (strcmp(argv[i], "--difficulty") == 0 && i + 1 < argc) {
+            query.difficulty = parse_name(argv[++i], difficulty_names, 4);
+            ok = query.difficulty >= 0;
+        } else if (strcmp(argv[i], "--days") == 0 && i + 1 < argc) {
+            double days = atof(argv[++i]);
+            ok = days > 0;
+            query.since = (int64_t)time(NULL) - (int64_t)(days * 86400);
+        } else if (strcmp(argv[i], "--no-index") == 0) {
+            use_index = 0;
+        } else {
+            ok = 0;
+        }
+    }
+    if (!ok) {
+        fprintf(stderr, "Usage : %s [--log CHEMIN] [--mode classic|arcade|challenge|free]\n"
+                        "       [--difficulty easy|medium|hard|extreme] [--days N] [--no-index]\n", argv[0]);
+        return 2;
+    }
+
+    SessionMap map;
+    if (!session_map_open(&map, path)) {
+        fprintf(stderr, "Erreur : journal %s illisible\n", path);
+        return 1;
+    }
+    double start = profiler_now_ms();
+    SessionIndex index = {NULL, 0, 0};
+    if (use_index) {
+        char index_path[4096];
+        snprintf(index_path, sizeof(index_path), "%s.idx", path);
+        if (!session_index_open(&index, index_path, &map)) {
+            fprintf(stderr, "Erreur : mémoire insuffisante\n");
+            session_map_close(&map);
+            return 1;
+        }
+        if (!index.saved) fprintf(stderr, "Attention : index %s non écrit\n", index_path);
+    }
+    double indexed = profiler_now_ms();
+
+    Collected collected;
+    memset(&collected, 0, sizeof(collected));
+    SessionScan scan;
+    session_query(&map, use_index ? &index : NULL, &query, collect, &collected, &scan);
+    double queried = profiler_now_ms();
+
+    printf("%s : %zu parties, %zu retenues (mode %s, difficulté %s", path, map.count, scan.matched,
+           query.mode >= 0 ? mode_names[query.mode] : "tous", query.difficulty >= 0 ? difficulty_names[query.difficulty] : "toutes");
+    if (query.since) printf(", depuis %.1f jours", (double)((int64_t)time(NULL) - query.since) / 86400);
+    printf(")\n");
+    printf("Blocs lus : %zu, ignorés : %zu, enregistrements lus : %zu | index %.1f ms, requête %.1f ms\n",
+           scan.blocks_read, scan.blocks_skipped, scan.records_read, indexed - start, queried - indexed);
+    int status = 0;
+    if (collected.failed) {
+        fprintf(stderr, "Erreur : mémoire insuffisante\n");
+        status = 1;
+    } else if (collected.count > 0) {
+        report(&collected);
+    }
+    for (int f = 0; f < FIELD_COUNT; f++) free(collected.values[f]);
+    session_index_free(&index);
+    session_map_close(&map);
+    return status;
+}
@@ -0,0 +1,199 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "snake_shm.h"
+
+// ===== RÉGION =====
+
+// shm_open attend un nom commençant par '/'.
+static int region_name(ShmLink *link, const char *name) {
+    int written = snprintf(link->name, sizeof(link->name), "%s%s", name[0] == '/' ? "" : "/", name);
+    return written > 1 && written < (int)sizeof(link->name) && !strchr(link->name + 1, '/');
+}
+
+static int map_region(ShmLink *link) {
+    void *mem = mmap(NULL, sizeof(ShmRegion), PROT_READ | PROT_WRITE, MAP_SHARED, link->fd, 0);
+    if (mem == MAP_FAILED) return 0;
+    link->region = mem;
+    return 1;
+}
+
+// Crée (ou recrée) la région côté jeu. Retourne 0 en cas d'échec.
+int shm_create(ShmLink *link, const char *name, int players) {
+    memset(link, 0, sizeof(*link));
+    link->fd = -1;
+    if (!region_name(link, name)) return 0;
+    link->fd = shm_open(link->name, O_CREAT | O_RDWR, 0600);
+    if (link->fd < 0) return 0;
+    link->owner = 1;
+    if (ftruncate(link->fd, sizeof(ShmRegion)) != 0 || !map_region(link)) {
+        shm_close(link);
+        return 0;
+    }
+    ShmRegion *region = link->region;
+    memset(region, 0, sizeof(*region));
+    region->version = SHM_VERSION;
+    region->size = sizeof(ShmRegion);
+    region->players = players == 2 ? 2 : 1;
+    region->state_offset = offsetof(ShmRegion, state);
+    region->seq_offset = offsetof(ShmRegion, seq);
+    region->commands_offset = offsetof(ShmRegion, commands);
+    // Le nombre magique en dernier : un bot qui s'attache trop tôt le voit nul
+    atomic_thread_fence(memory_order_release);
+    region->magic = SHM_MAGIC;
+    return 1;
+}
+
+// S'attache à une région existante (côté bot). Retourne 0 si elle n'existe
+// pas ou n'a pas le format attendu.
+int shm_attach(ShmLink *link, const char *name) {
+    memset(link, 0, sizeof(*link));
+    link->fd = -1;
+    if (!region_name(link, name)) return 0;
+    link->fd = shm_open(link->name, O_RDWR, 0);
+    struct stat st;
+    if (link->fd < 0 || fstat(link->fd, &st) != 0 || st.st_size < (off_t)sizeof(ShmRegion) ||
+        !map_region(link) || link->region->magic != SHM_MAGIC || link->region->version != SHM_VERSION) {
+        shm_close(link);
+        return 0;
+    }
+    return 1;
+}
+
+void shm_close(ShmLink *link) {
+    if (link->region) munmap(link->region, sizeof(ShmRegion));
+    if (link->fd >= 0) close(link->fd);
+    if (link->owner) shm_unlink(link->name);
+    link->region = NULL;
+    link->fd = -1;
+    link->owner = 0;
+}
+
+// ===== CÔTÉ JEU =====
+
+static void publish_snake(ShmSnake *out, const Snake *snake) {
+    out->length = (uint32_t)snake->length;
+    out->direction = (uint32_t)snake->direction;
+    out->score = snake->score;
+    out->lives = snake->lives;
+    for (int i = 0; i < snake->length; i++) {
+        out->body[i].x = (int16_t)snake->body[i].x;
+        out->body[i].y = (int16_t)snake->body[i].y;
+    }
+}
+
+static void mark_cell(ShmState *state, Position pos, uint8_t value) {
+    if (pos.x >= 0 && pos.x < state->width && pos.y >= 0 && pos.y < state->height) {
+        state->cells[pos.y * state->width + pos.x] = value;
+    }
+}
+
+// Publie l'état après un tick. Seul le jeu écrit : le seqlock n'a besoin
+// que de deux incréments de `seq` autour de l'écriture.
+void shm_publish(ShmLink *link, const Game *game) {
+    ShmRegion *region = link->region;
+    if (game->grid_width * game->grid_height > SHM_MAX_CELLS) return;
+    uint32_t seq = atomic_load_explicit(&region->seq, memory_order_relaxed);
+    atomic_store_explicit(&region->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    ShmState *state = &region->state;
+    state->tick = game->tick;
+    state->width = game->grid_width;
+    state->height = game->grid_height;
+    state->score = game->score;
+    state->level = game->level;
+    state->game_over = game->game_over;
+    state->winner = game->winner;
+    state->food_count = game->food_count;
+    state->powerup_active = game->powerup.active;
+    state->powerup.pos = (ShmPos){(int16_t)game->powerup.pos.x, (int16_t)game->powerup.pos.y};
+    state->powerup.type = (uint32_t)game->powerup.type;
+    publish_snake(&state->snakes[0], &game->snake1);
+    if (game->multiplayer) publish_snake(&state->snakes[1], &game->snake2);
+
+    int cells = game->grid_width * game->grid_height;
+    for (int i = 0; i < cells; i++) {
+        Tile tile = game->map.tiles ? game->map.tiles[i] : TILE_EMPTY;
+        state->cells[i] = tile == TILE_EMPTY ? SHM_CELL_EMPTY
+                        : tile_is_portal(tile) ? SHM_CELL_PORTAL : SHM_CELL_WALL;
+    }
+    for (int i = 0; i < game->food_count; i++) {
+        state->foods[i].pos = (ShmPos){(int16_t)game->foods[i].pos.x, (int16_t)game->foods[i].pos.y};
+        state->foods[i].type = (uint32_t)game->foods[i].type;
+        mark_cell(state, game->foods[i].pos, SHM_CELL_FOOD);
+    }
+    if (game->powerup.active) mark_cell(state, game->powerup.pos, SHM_CELL_POWERUP);
+    for (int i = game->snake1.length - 1; i >= 0; i--) mark_cell(state, game->snake1.body[i], SHM_CELL_SNAKE1);
+    if (game->multiplayer) {
+        for (int i = game->snake2.length - 1; i >= 0; i--) mark_cell(state, game->snake2.body[i], SHM_CELL_SNAKE2);
+    }
+
+    atomic_store_explicit(&region->seq, seq + 2, memory_order_release);
+    link->published++;
+}
+
+// Lit la commande d'un joueur. Retourne 1 si une nouvelle direction a été
+// écrite depuis le dernier appel.
+int shm_poll_command(ShmLink *link, int player, Direction *direction) {
+    uint64_t command = atomic_load_explicit(&link->region->commands[player], memory_order_acquire);
+    if (command == SHM_NO_COMMAND || command == link->last_command[player]) return 0;
+    link->last_command[player] = command;
+    unsigned int value = (unsigned int)(command & 0xff);
+    if (value < 1 || value > 4) return 0;
+    *direction = (Direction)(value - 1);
+    if ((command >> 8) < link->region->state.tick) link->late++;
+    link->commands++;
+    return 1;
+}
+
+// À appeler avant chaque tick : les directions des bots rejoignent la file de
+// virages sans horodatage (lues juste avant le tick, elles ne mesureraient
+// rien) ; le retard des bots se lit dans link->late.
+void shm_apply_commands(ShmLink *link, Game *game) {
+    Snake *snakes[2] = {&game->snake1, &game->snake2};
+    int players = game->multiplayer ? 2 : 1;
+    for (int p = 0; p < players; p++) {
+        Direction direction;
+        if (shm_poll_command(link, p, &direction)) queue_turn(snakes[p], direction, 0);
+    }
+}
+
+// ===== CÔTÉ BOT =====
+
+// Début de lecture : attend la fin d'une écriture en cours et retourne le
+// numéro de séquence à repasser à shm_read_retry.
+uint32_t shm_read_begin(const ShmLink *link) {
+    uint32_t seq;
+    while ((seq = atomic_load_explicit(&link->region->seq, memory_order_acquire)) & 1) {
+        sched_yield();
+    }
+    return seq;
+}
+
+// Fin de lecture : retourne 1 si le jeu a écrit pendant la lecture (à refaire).
+int shm_read_retry(const ShmLink *link, uint32_t seq) {
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&link->region->seq, memory_order_relaxed) != seq;
+}
+
+// Copie cohérente de l'état (pour un bot qui préfère travailler sur une copie).
+void shm_read(const ShmLink *link, ShmState *copy) {
+    uint32_t seq;
+    do {
+        seq = shm_read_begin(link);
+        memcpy(copy, (const void *)&link->region->state, sizeof(*copy));
+    } while (shm_read_retry(link, seq));
+}
+
+void shm_send(ShmLink *link, int player, uint64_t tick, Direction direction) {
+    atomic_store_explicit(&link->region->commands[player], (tick << 8) | ((uint64_t)direction + 1),
+                          memory_order_release);
+}
@@ -0,0 +1,120 @@
+#ifndef SNAKE_SHM_H
+#define SNAKE_SHM_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include "snake_core.h"
+
+// Interface mémoire partagée pour les bots externes (Python, Rust, C...).
+//
+// Le jeu crée une région POSIX (shm_open + mmap, /dev/shm/<nom>) et y
+// publie l'état après chaque tick, protégé par un seqlock : `seq` est impair
+// pendant l'écriture. Un bot lit l'état sur place, sans appel système ni
+// sérialisation :
+//
+//   do { s = seq (attendre qu'il soit pair) ; lire l'état ; } while (seq != s)
+//
+// puis répond en écrivant un seul mot de 64 bits dans son emplacement de
+// commande (une écriture atomique, sans verrou) :
+//
+//   commands[joueur] = (tick << 8) | (direction + 1)
+//
+// Le jeu lit ce mot avant le tick suivant et applique la direction si elle
+// est nouvelle. Le bot n'attend jamais le jeu et le jeu n'attend jamais le bot.
+//
+// Disposition : l'en-tête donne l'offset de chaque partie, en octets depuis
+// le début de la région (voir examples/shm_bot.py). Entiers petit-boutistes
+// de la machine, positions en int16.
+
+// ===== CONSTANTES =====
+#define SHM_MAGIC 0x314B4E53u       // "SNK1"
+#define SHM_VERSION 1
+#define SHM_MAX_CELLS 4096          // plus grande grille publiée (80x30 en facile)
+#define SHM_NO_COMMAND 0
+
+// Contenu de `cells`
+enum {
+    SHM_CELL_EMPTY = 0,
+    SHM_CELL_WALL,
+    SHM_CELL_PORTAL,
+    SHM_CELL_FOOD,
+    SHM_CELL_POWERUP,
+    SHM_CELL_SNAKE1,
+    SHM_CELL_SNAKE2
+};
+
+// ===== STRUCTURES =====
+typedef struct {
+    int16_t x;
+    int16_t y;
+} ShmPos;
+
+typedef struct {
+    ShmPos pos;
+    uint32_t type;
+} ShmItem;
+
+typedef struct {
+    uint32_t length;
+    uint32_t direction;
+    int32_t score;
+    int32_t lives;
+    ShmPos body[MAX_LENGTH];        // body[0] : tête
+} ShmSnake;
+
+// État publié, protégé par le seqlock
+typedef struct {
+    uint64_t tick;
+    int32_t width;
+    int32_t height;
+    int32_t score;
+    int32_t level;
+    int32_t game_over;
+    int32_t winner;
+    int32_t food_count;
+    int32_t powerup_active;
+    ShmItem powerup;
+    ShmItem foods[MAX_FOOD];
+    ShmSnake snakes[2];
+    uint8_t cells[SHM_MAX_CELLS];   // cells[y * width + x]
+} ShmState;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;                  // taille de la région
+    uint32_t players;               // serpents en jeu (1 ou 2)
+    uint32_t state_offset;
+    uint32_t seq_offset;
+    uint32_t commands_offset;
+    uint32_t reserved;
+    _Alignas(64) _Atomic uint32_t seq;
+    _Alignas(64) ShmState state;
+    _Alignas(64) _Atomic uint64_t commands[2];   // écrits par les bots
+} ShmRegion;
+
+typedef struct {
+    int fd;
+    ShmRegion *region;
+    char name[64];
+    int owner;                      // créateur : supprime la région à la fermeture
+    uint64_t last_command[2];       // dernière commande appliquée, par joueur
+    unsigned long published;
+    unsigned long commands;         // commandes appliquées
+    unsigned long late;             // commandes arrivées après le tick suivant
+} ShmLink;
+
+// ===== PROTOTYPES =====
+int shm_create(ShmLink *link, const char *name, int players);
+int shm_attach(ShmLink *link, const char *name);
+void shm_close(ShmLink *link);
+void shm_publish(ShmLink *link, const Game *game);
+int shm_poll_command(ShmLink *link, int player, Direction *direction);
+void shm_apply_commands(ShmLink *link, Game *game);
+
+uint32_t shm_read_begin(const ShmLink *link);
+int shm_read_retry(const ShmLink *link, uint32_t seq);
+void shm_read(const ShmLink *link, ShmState *copy);
+void shm_send(ShmLink *link, int player, uint64_t tick, Direction direction);
+
+#endif
@@ -0,0 +1,648 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include "snake_stream.h"
+
+// Format d'un message (petit-boutiste) :
+//   'S', type ('K' instantané, 'D' delta), u16 réservé, u32 taille, u32 tick, contenu
+// Un delta commence par le tick de base puis une suite d'opérations terminée par OP_END.
+#define STREAM_MAGIC 'S'
+#define STREAM_KEY 'K'
+#define STREAM_DELTA 'D'
+#define STREAM_HEADER 12
+
+enum {
+    OP_END = 0,
+    OP_HEAD,        // serpent, x, y : nouvelle tête
+    OP_TAIL,        // serpent, n : la queue perd n segments
+    OP_SCORE,       // serpent, score, vies
+    OP_FOOD_COUNT,  // nombre de nourritures
+    OP_FOOD,        // indice, x, y, type
+    OP_POWERUP,     // actif, x, y, type
+    OP_GAME         // score, niveau, drapeaux (fin, pause)
+};
+
+// ===== ENCODAGE =====
+
+static int chunk_reserve(StreamChunk *chunk, size_t extra) {
+    if (chunk->size + extra <= chunk->capacity) return 1;
+    size_t capacity = chunk->capacity ? chunk->capacity : 256;
+    while (capacity < chunk->size + extra) capacity *= 2;
+    unsigned char *data = realloc(chunk->data, capacity);
+    if (!data) return 0;
+    chunk->data = data;
+    chunk->capacity = capacity;
+    return 1;
+}
+
+static void put8(StreamChunk *c, unsigned int v) {
+    if (chunk_reserve(c, 1)) c->data[c->size++] = (unsigned char)v;
+}
+
+static void put16(StreamChunk *c, unsigned int v) {
+    put8(c, v & 0xff);
+    put8(c, (v >> 8) & 0xff);
+}
+
+static void put32(StreamChunk *c, unsigned long v) {
+    put16(c, v & 0xffff);
+    put16(c, (v >> 16) & 0xffff);
+}
+
+static void put_item(StreamChunk *c, StreamItem item) {
+    put16(c, (unsigned short)item.pos.x);
+    put16(c, (unsigned short)item.pos.y);
+    put8(c, item.type);
+}
+
+typedef struct {
+    const unsigned char *data;
+    size_t size;
+    size_t pos;
+    int error;
+} Cursor;
+
+static unsigned int get8(Cursor *c) {
+    if (c->pos >= c->size) {
+        c->error = 1;
+        return 0;
+    }
+    return c->data[c->pos++];
+}
+
+static unsigned int get16(Cursor *c) {
+    unsigned int lo = get8(c);
+    return lo | (get8(c) << 8);
+}
+
+static unsigned long get32(Cursor *c) {
+    unsigned long lo = get16(c);
+    return lo | ((unsigned long)get16(c) << 16);
+}
+
+static StreamItem get_item(Cursor *c) {
+    StreamItem item;
+    item.pos.x = (short)get16(c);
+    item.pos.y = (short)get16(c);
+    item.type = (unsigned char)get8(c);
+    return item;
+}
+
+static int same_pos(StreamPos a, StreamPos b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+static int same_item(StreamItem a, StreamItem b) {
+    return same_pos(a.pos, b.pos) && a.type == b.type;
+}
+
+static void begin_message(StreamChunk *c, int type, unsigned long tick) {
+    c->size = 0;
+    put8(c, STREAM_MAGIC);
+    put8(c, type);
+    put16(c, 0);
+    put32(c, 0);  // taille, complétée par end_message
+    put32(c, tick);
+}
+
+static int end_message(StreamChunk *c) {
+    if (c->size < STREAM_HEADER) return 0;
+    unsigned long payload = c->size - STREAM_HEADER;
+    c->data[4] = payload & 0xff;
+    c->data[5] = (payload >> 8) & 0xff;
+    c->data[6] = (payload >> 16) & 0xff;
+    c->data[7] = (payload >> 24) & 0xff;
+    return 1;
+}
+
+static void encode_keyframe(StreamChunk *c, const StreamFrame *f) {
+    begin_message(c, STREAM_KEY, f->tick);
+    put16(c, f->width);
+    put16(c, f->height);
+    put8(c, f->snake_count);
+    for (int s = 0; s < f->snake_count; s++) {
+        const StreamSnake *snake = &f->snakes[s];
+        put32(c, (unsigned long)snake->score);
+        put8(c, snake->lives);
+        put16(c, snake->length);
+        for (int i = 0; i < snake->length; i++) {
+            put16(c, (unsigned short)snake->body[i].x);
+            put16(c, (unsigned short)snake->body[i].y);
+        }
+    }
+    put8(c, f->food_count);
+    for (int i = 0; i < f->food_count; i++) put_item(c, f->foods[i]);
+    put8(c, f->powerup_active);
+    put_item(c, f->powerup);
+    put16(c, f->obstacle_count);
+    for (int i = 0; i < f->obstacle_count; i++) put_item(c, f->obstacles[i]);
+    put32(c, (unsigned long)f->score);
+    put16(c, f->level);
+    put8(c, (f->game_over ? 1 : 0) | (f->paused ? 2 : 0));
+}
+
+// Nombre de têtes ajoutées (0 ou 1) si le nouveau corps s'obtient à partir
+// de l'ancien en ajoutant une tête et en retirant des segments en queue ;
+// -1 sinon (réapparition, téléportation d'un corps entier...).
+static int body_shift(const StreamSnake *old, const StreamSnake *cur) {
+    for (int k = 0; k <= 1; k++) {
+        int kept = cur->length - k;
+        if (kept < 0 || kept > old->length) continue;
+        int match = 1;
+        for (int i = 0; i < kept && match; i++) {
+            match = same_pos(cur->body[k + i], old->body[i]);
+        }
+        if (match) return k;
+    }
+    return -1;
+}
+
+// Retourne 0 si le changement ne s'exprime pas en delta.
+static int encode_delta(StreamChunk *c, const StreamFrame *old, const StreamFrame *f) {
+    if (old->width != f->width || old->height != f->height || old->snake_count != f->snake_count ||
+        old->obstacle_count != f->obstacle_count)
+        return 0;
+    for (int i = 0; i < f->obstacle_count; i++) {
+        if (!same_item(old->obstacles[i], f->obstacles[i])) return 0;
+    }
+
+    begin_message(c, STREAM_DELTA, f->tick);
+    put32(c, old->tick);
+    for (int s = 0; s < f->snake_count; s++) {
+        const StreamSnake *prev = &old->snakes[s], *snake = &f->snakes[s];
+        int heads = body_shift(prev, snake);
+        if (heads < 0) return 0;
+        if (heads) {
+            put8(c, OP_HEAD);
+            put8(c, s);
+            put16(c, (unsigned short)snake->body[0].x);
+            put16(c, (unsigned short)snake->body[0].y);
+        }
+        int dropped = prev->length + heads - snake->length;
+        if (dropped > 0) {
+            put8(c, OP_TAIL);
+            put8(c, s);
+            put16(c, dropped);
+        }
+        if (prev->score != snake->score || prev->lives != snake->lives) {
+            put8(c, OP_SCORE);
+            put8(c, s);
+            put32(c, (unsigned long)snake->score);
+            put8(c, snake->lives);
+        }
+    }
+    if (old->food_count != f->food_count) {
+        put8(c, OP_FOOD_COUNT);
+        put8(c, f->food_count);
+    }
+    for (int i = 0; i < f->food_count; i++) {
+        if (i < old->food_count && same_item(old->foods[i], f->foods[i])) continue;
+        put8(c, OP_FOOD);
+        put8(c, i);
+        put_item(c, f->foods[i]);
+    }
+    if (old->powerup_active != f->powerup_active || !same_item(old->powerup, f->powerup)) {
+        put8(c, OP_POWERUP);
+        put8(c, f->powerup_active);
+        put_item(c, f->powerup);
+    }
+    if (old->score != f->score || old->level != f->level ||
+        old->game_over != f->game_over || old->paused != f->paused) {
+        put8(c, OP_GAME);
+        put32(c, (unsigned long)f->score);
+        put16(c, f->level);
+        put8(c, (f->game_over ? 1 : 0) | (f->paused ? 2 : 0));
+    }
+    put8(c, OP_END);
+    return 1;
+}
+
+// ===== ÉCRIVAIN =====
+
+static int parse_target(const char *target, StreamKind *kind, char *path, size_t size) {
+    *kind = STREAM_FILE;
+    if (strncmp(target, "unix:", 5) == 0) {
+        *kind = STREAM_UNIX;
+        target += 5;
+    }
+    if (strlen(target) == 0 || strlen(target) >= size) return 0;
+    snprintf(path, size, "%s", target);
+    struct stat st;
+    if (*kind == STREAM_FILE && stat(path, &st) == 0 && S_ISFIFO(st.st_mode)) *kind = STREAM_FIFO;
+    return 1;
+}
+
+static int writer_alloc(StreamWriter *writer) {
+    writer->prev = malloc(sizeof(StreamFrame));
+    return writer->prev != NULL;
+}
+
+int stream_writer_open(StreamWriter *writer, const char *target) {
+    memset(writer, 0, sizeof(*writer));
+    writer->fd = -1;
+    writer->listen_fd = -1;
+    if (!parse_target(target, &writer->kind, writer->path, sizeof(writer->path)) || !writer_alloc(writer)) {
+        stream_writer_close(writer);
+        return 0;
+    }
+    // Un lecteur qui part ne doit pas tuer la partie
+    signal(SIGPIPE, SIG_IGN);
+
+    if (writer->kind == STREAM_FILE) {
+        writer->fd = open(writer->path, O_WRONLY | O_CREAT | O_APPEND | O_NONBLOCK, 0644);
+        if (writer->fd < 0) {
+            stream_writer_close(writer);
+            return 0;
+        }
+    } else if (writer->kind == STREAM_UNIX) {
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (strlen(writer->path) >= sizeof(addr.sun_path)) {
+            stream_writer_close(writer);
+            return 0;
+        }
+        strcpy(addr.sun_path, writer->path);
+        unlink(writer->path);
+        writer->listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (writer->listen_fd < 0 || fcntl(writer->listen_fd, F_SETFL, O_NONBLOCK) != 0 ||
+            bind(writer->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+            listen(writer->listen_fd, 4) != 0) {
+            stream_writer_close(writer);
+            return 0;
+        }
+    }
+    // FIFO : ouverte au premier tick où un lecteur est présent
+    return 1;
+}
+
+int stream_writer_open_fd(StreamWriter *writer, int fd) {
+    memset(writer, 0, sizeof(*writer));
+    writer->kind = STREAM_FD;
+    writer->fd = fd;
+    writer->listen_fd = -1;
+    if (!writer_alloc(writer) || fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK) != 0) {
+        stream_writer_close(writer);
+        return 0;
+    }
+    return 1;
+}
+
+void stream_writer_close(StreamWriter *writer) {
+    if (writer->fd >= 0 && writer->kind != STREAM_FD) close(writer->fd);
+    if (writer->listen_fd >= 0) {
+        close(writer->listen_fd);
+        unlink(writer->path);
+    }
+    for (int i = 0; i < STREAM_MAX_CHUNKS; i++) free(writer->chunks[i].data);
+    free(writer->prev);
+    memset(writer, 0, sizeof(*writer));
+    writer->fd = -1;
+    writer->listen_fd = -1;
+}
+
+static void drop_queue(StreamWriter *writer, int keep_partial) {
+    int keep = keep_partial && writer->first_offset > 0 ? 1 : 0;
+    writer->dropped += writer->chunk_count - keep;
+    writer->chunk_count = keep;
+    writer->queued_bytes = keep ? writer->chunks[writer->chunk_first].size - writer->first_offset : 0;
+    if (!keep) writer->first_offset = 0;
+    writer->need_keyframe = 1;
+}
+
+static void lose_reader(StreamWriter *writer) {
+    if (writer->kind == STREAM_FIFO || writer->kind == STREAM_UNIX) {
+        close(writer->fd);
+        writer->fd = -1;
+    }
+    drop_queue(writer, 0);
+}
+
+// Nouveau lecteur (FIFO ouverte ou connexion sur le socket) : il part d'un instantané.
+static void accept_reader(StreamWriter *writer) {
+    int fd = -1;
+    if (writer->kind == STREAM_FIFO && writer->fd < 0) {
+        fd = open(writer->path, O_WRONLY | O_NONBLOCK);  // ENXIO tant qu'aucun lecteur
+    } else if (writer->kind == STREAM_UNIX) {
+        fd = accept(writer->listen_fd, NULL, NULL);
+        if (fd >= 0) fcntl(fd, F_SETFL, O_NONBLOCK);
+    }
+    if (fd < 0) return;
+    if (writer->fd >= 0) close(writer->fd);  // un seul spectateur : le dernier arrivé
+    writer->fd = fd;
+    writer->chunk_count = 0;
+    writer->first_offset = 0;
+    writer->queued_bytes = 0;
+    writer->need_keyframe = 1;
+}
+
+// Écrit autant de messages que possible en un appel writev, sans bloquer.
+static void flush_queue(StreamWriter *writer) {
+    while (writer->chunk_count > 0 && writer->fd >= 0) {
+        struct iovec iov[STREAM_MAX_CHUNKS];
+        for (int i = 0; i < writer->chunk_count; i++) {
+            StreamChunk *chunk = &writer->chunks[(writer->chunk_first + i) % STREAM_MAX_CHUNKS];
+            size_t offset = i == 0 ? writer->first_offset : 0;
+            iov[i].iov_base = chunk->data + offset;
+            iov[i].iov_len = chunk->size - offset;
+        }
+        ssize_t n = writev(writer->fd, iov, writer->chunk_count);
+        writer->writev_calls++;
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return;
+            lose_reader(writer);
+            return;
+        }
+        writer->bytes_written += n;
+        writer->queued_bytes -= n;
+        size_t left = (size_t)n;
+        while (writer->chunk_count > 0) {
+            StreamChunk *chunk = &writer->chunks[writer->chunk_first];
+            size_t rest = chunk->size - writer->first_offset;
+            if (left < rest) {
+                writer->first_offset += left;
+                return;  // écriture partielle : le tube est plein
+            }
+            left -= rest;
+            writer->first_offset = 0;
+            writer->chunk_first = (writer->chunk_first + 1) % STREAM_MAX_CHUNKS;
+            writer->chunk_count--;
+        }
+    }
+}
+
+// Publie l'état d'un tick. Ne bloque jamais : retourne 0 seulement si le
+// message n'a pas pu être construit (mémoire).
+int stream_publish(StreamWriter *writer, const StreamFrame *frame) {
+    accept_reader(writer);
+    flush_queue(writer);
+
+    // Lecteur trop lent : on abandonne ce qui attend (sauf un message entamé)
+    if (writer->chunk_count >= STREAM_MAX_CHUNKS - 1 || writer->queued_bytes > STREAM_QUEUE_LIMIT) {
+        drop_queue(writer, 1);
+    }
+
+    if (writer->fd < 0) {
+        // Pas encore de lecteur : on garde seulement l'état pour le prochain delta
+        memcpy(writer->prev, frame, sizeof(StreamFrame));
+        writer->have_prev = 1;
+        writer->need_keyframe = 1;
+        return 1;
+    }
+
+    StreamChunk *chunk = &writer->chunks[(writer->chunk_first + writer->chunk_count) % STREAM_MAX_CHUNKS];
+    // Nouvelle partie (tick qui repart de zéro) : instantané complet
+    int keyframe = writer->need_keyframe || !writer->have_prev || frame->tick <= writer->prev->tick ||
+                   frame->tick - writer->last_keyframe >= STREAM_KEYFRAME_INTERVAL;
+    if (keyframe || !encode_delta(chunk, writer->prev, frame)) {
+        encode_keyframe(chunk, frame);
+        keyframe = 1;
+    }
+    if (!end_message(chunk)) return 0;
+
+    memcpy(writer->prev, frame, sizeof(StreamFrame));
+    writer->have_prev = 1;
+    writer->frames++;
+    if (keyframe) {
+        writer->keyframes++;
+        writer->last_keyframe = frame->tick;
+        writer->need_keyframe = 0;
+    }
+    writer->chunk_count++;
+    writer->queued_bytes += chunk->size;
+    flush_queue(writer);
+    return 1;
+}
+
+// ===== LECTEUR =====
+
+static int reader_attach(StreamReader *reader, int fd) {
+    reader->fd = fd;
+    reader->frame = calloc(1, sizeof(StreamFrame));
+    if (!reader->frame || fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK) != 0) {
+        stream_reader_close(reader);
+        return 0;
+    }
+    return 1;
+}
+
+int stream_reader_open(StreamReader *reader, const char *target) {
+    memset(reader, 0, sizeof(*reader));
+    reader->fd = -1;
+    if (!parse_target(target, &reader->kind, reader->path, sizeof(reader->path))) return 0;
+    int fd = -1;
+    if (reader->kind == STREAM_UNIX) {
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (strlen(reader->path) >= sizeof(addr.sun_path)) return 0;
+        strcpy(addr.sun_path, reader->path);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    } else {
+        // FIFO ouverte en lecture non bloquante : l'écrivain peut arriver plus tard
+        fd = open(reader->path, O_RDONLY | O_NONBLOCK);
+    }
+    if (fd < 0) return 0;
+    return reader_attach(reader, fd);
+}
+
+int stream_reader_open_fd(StreamReader *reader, int fd) {
+    memset(reader, 0, sizeof(*reader));
+    reader->kind = STREAM_FD;
+    return reader_attach(reader, fd);
+}
+
+void stream_reader_close(StreamReader *reader) {
+    if (reader->fd >= 0 && reader->kind != STREAM_FD) close(reader->fd);
+    free(reader->buffer);
+    free(reader->frame);
+    memset(reader, 0, sizeof(*reader));
+    reader->fd = -1;
+}
+
+static int decode_keyframe(StreamFrame *f, Cursor *c, unsigned long tick) {
+    f->tick = tick;
+    f->width = get16(c);
+    f->height = get16(c);
+    f->snake_count = get8(c);
+    if (f->snake_count > STREAM_MAX_SNAKES) return 0;
+    for (int s = 0; s < f->snake_count; s++) {
+        StreamSnake *snake = &f->snakes[s];
+        snake->score = (int)get32(c);
+        snake->lives = get8(c);
+        snake->length = get16(c);
+        if (snake->length > STREAM_MAX_LENGTH) return 0;
+        for (int i = 0; i < snake->length; i++) {
+            snake->body[i].x = (short)get16(c);
+            snake->body[i].y = (short)get16(c);
+        }
+    }
+    f->food_count = get8(c);
+    if (f->food_count > STREAM_MAX_FOOD) return 0;
+    for (int i = 0; i < f->food_count; i++) f->foods[i] = get_item(c);
+    f->powerup_active = get8(c);
+    f->powerup = get_item(c);
+    f->obstacle_count = get16(c);
+    if (f->obstacle_count > STREAM_MAX_OBSTACLES) return 0;
+    for (int i = 0; i < f->obstacle_count; i++) f->obstacles[i] = get_item(c);
+    f->score = (int)get32(c);
+    f->level = get16(c);
+    unsigned int flags = get8(c);
+    f->game_over = flags & 1;
+    f->paused = (flags >> 1) & 1;
+    return !c->error;
+}
+
+static int decode_delta(StreamFrame *f, Cursor *c, unsigned long tick) {
+    for (;;) {
+        unsigned int op = get8(c);
+        if (c->error) return 0;
+        if (op == OP_END) break;
+        if (op == OP_HEAD || op == OP_TAIL || op == OP_SCORE) {
+            unsigned int s = get8(c);
+            if (s >= (unsigned int)f->snake_count) return 0;
+            StreamSnake *snake = &f->snakes[s];
+            if (op == OP_HEAD) {
+                if (snake->length >= STREAM_MAX_LENGTH) return 0;
+                memmove(snake->body + 1, snake->body, snake->length * sizeof(StreamPos));
+                snake->body[0].x = (short)get16(c);
+                snake->body[0].y = (short)get16(c);
+                snake->length++;
+            } else if (op == OP_TAIL) {
+                int n = get16(c);
+                if (n > snake->length) return 0;
+                snake->length -= n;
+            } else {
+                snake->score = (int)get32(c);
+                snake->lives = get8(c);
+            }
+        } else if (op == OP_FOOD_COUNT) {
+            f->food_count = get8(c);
+            if (f->food_count > STREAM_MAX_FOOD) return 0;
+        } else if (op == OP_FOOD) {
+            unsigned int i = get8(c);
+            if (i >= (unsigned int)f->food_count) return 0;
+            f->foods[i] = get_item(c);
+        } else if (op == OP_POWERUP) {
+            f->powerup_active = get8(c);
+            f->powerup = get_item(c);
+        } else if (op == OP_GAME) {
+            f->score = (int)get32(c);
+            f->level = get16(c);
+            unsigned int flags = get8(c);
+            f->game_over = flags & 1;
+            f->paused = (flags >> 1) & 1;
+        } else {
+            return 0;
+        }
+    }
+    f->tick = tick;
+    return !c->error;
+}
+
+// Applique un message complet ; un delta dont la base n'est pas l'état
+// courant est ignoré jusqu'au prochain instantané.
+static void apply_message(StreamReader *reader, const unsigned char *msg, size_t size) {
+    Cursor c = {msg + STREAM_HEADER, size - STREAM_HEADER, 0, 0};
+    Cursor h = {msg, STREAM_HEADER, 8, 0};
+    unsigned long tick = get32(&h);
+    if (msg[1] == STREAM_KEY) {
+        reader->synced = decode_keyframe(reader->frame, &c, tick);
+        if (reader->synced) reader->frames++;
+        return;
+    }
+    unsigned long base = get32(&c);
+    if (!reader->synced || base != reader->frame->tick) {
+        reader->synced = 0;
+        reader->gaps++;
+        return;
+    }
+    reader->synced = decode_delta(reader->frame, &c, tick);
+    if (reader->synced) reader->frames++;
+}
+
+// Lit ce qui est disponible sans bloquer. Retourne 1 si l'écrivain a fermé
+// le socket.
+static int read_available(StreamReader *reader) {
+    if (reader->start > 0) {
+        memmove(reader->buffer, reader->buffer + reader->start, reader->size - reader->start);
+        reader->size -= reader->start;
+        reader->start = 0;
+    }
+    for (;;) {
+        if (reader->capacity - reader->size < 4096) {
+            size_t capacity = reader->capacity ? reader->capacity * 2 : 65536;
+            unsigned char *buffer = realloc(reader->buffer, capacity);
+            if (!buffer) return 0;
+            reader->buffer = buffer;
+            reader->capacity = capacity;
+        }
+        ssize_t n = read(reader->fd, reader->buffer + reader->size, reader->capacity - reader->size);
+        if (n == 0 && (reader->kind == STREAM_UNIX || reader->kind == STREAM_FD)) return 1;
+        if (n <= 0) return 0;
+        reader->size += n;
+    }
+}
+
+// Applique au plus `limit` messages complets du tampon à partir de
+// reader->start (le tampon n'est compacté qu'avant une lecture).
+static void apply_buffered(StreamReader *reader, unsigned long limit) {
+    unsigned long before = reader->frames;
+    size_t pos = reader->start;
+    while (reader->size - pos >= STREAM_HEADER && reader->frames - before < limit) {
+        const unsigned char *msg = reader->buffer + pos;
+        if (msg[0] != STREAM_MAGIC || (msg[1] != STREAM_KEY && msg[1] != STREAM_DELTA)) {
+            pos++;  // resynchronisation octet par octet
+            reader->synced = 0;
+            continue;
+        }
+        size_t payload = msg[4] | (msg[5] << 8) | ((size_t)msg[6] << 16) | ((size_t)msg[7] << 24);
+        if (payload > 16 * 1024 * 1024) {
+            pos++;
+            reader->synced = 0;
+            continue;
+        }
+        if (reader->size - pos < STREAM_HEADER + payload) break;
+        apply_message(reader, msg, STREAM_HEADER + payload);
+        pos += STREAM_HEADER + payload;
+    }
+    reader->start = pos;
+}
+
+// Lit ce qui est disponible sans bloquer ; retourne le nombre de messages
+// appliqués (-1 si l'écrivain a fermé le socket). Un fichier ou une FIFO
+// est suivi comme `tail -f` : la fin de fichier n'est pas une fermeture.
+int stream_reader_poll(StreamReader *reader) {
+    unsigned long before = reader->frames;
+    int closed = read_available(reader);
+    apply_buffered(reader, (unsigned long)-1);
+    if (closed && reader->frames == before) return -1;
+    return (int)(reader->frames - before);
+}
+
+// Comme stream_reader_poll, mais une image à la fois (relecture d'un
+// enregistrement tick par tick) : retourne 1 si reader->frame est une
+// nouvelle image, 0 s'il n'y en a pas encore, -1 si l'écrivain a fermé le
+// socket et que tout a été lu.
+int stream_reader_next(StreamReader *reader) {
+    unsigned long before = reader->frames;
+    apply_buffered(reader, 1);
+    if (reader->frames != before) return 1;
+    int closed = read_available(reader);
+    apply_buffered(reader, 1);
+    if (reader->frames != before) return 1;
+    return closed ? -1 : 0;
+}
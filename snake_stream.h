@@ -0,0 +1,127 @@
+#ifndef SNAKE_STREAM_H
+#define SNAKE_STREAM_H
+
+#include <stddef.h>
+
+// Flux spectateur : la partie publie un message binaire par tick (instantané
+// complet ou delta par rapport au tick précédent) vers un fichier, une FIFO
+// ou un socket Unix. Les écritures sont non bloquantes et regroupées avec
+// writev : si le lecteur ne suit pas, les messages en attente sont abandonnés
+// et le flux repart sur un instantané complet. Des instantanés sont aussi
+// émis à intervalle régulier pour qu'un lecteur arrivé en cours de route se
+// synchronise.
+//
+// Ce module ne dépend d'aucun autre : les deux front ends (SDL et ncurses)
+// remplissent un StreamFrame à partir de leur propre état de jeu.
+//
+// Cibles : "chemin" (fichier, ajout en fin ; FIFO si le chemin en est une)
+//          "unix:chemin" (socket Unix ; le jeu écoute, le spectateur se connecte)
+
+// ===== CONSTANTES =====
+#define STREAM_MAX_SNAKES 2
+#define STREAM_MAX_LENGTH 1000
+#define STREAM_MAX_FOOD 8
+#define STREAM_MAX_OBSTACLES 4096
+#define STREAM_KEYFRAME_INTERVAL 100   // ticks entre deux instantanés complets
+#define STREAM_MAX_CHUNKS 64           // messages en attente d'écriture
+#define STREAM_QUEUE_LIMIT (256 * 1024)
+
+typedef enum {
+    STREAM_FILE = 0,
+    STREAM_FIFO,
+    STREAM_UNIX,
+    STREAM_FD        // descripteur fourni par l'appelant (tests)
+} StreamKind;
+
+// ===== STRUCTURES =====
+typedef struct {
+    short x;
+    short y;
+} StreamPos;
+
+typedef struct {
+    StreamPos pos;
+    unsigned char type;   // type de nourriture / power-up ; obstacles : 0 mur, 1 portail
+} StreamItem;
+
+typedef struct {
+    StreamPos body[STREAM_MAX_LENGTH];  // body[0] : tête
+    int length;
+    int score;
+    int lives;
+} StreamSnake;
+
+typedef struct {
+    unsigned long tick;
+    int width;
+    int height;
+    int snake_count;
+    StreamSnake snakes[STREAM_MAX_SNAKES];
+    StreamItem foods[STREAM_MAX_FOOD];
+    int food_count;
+    StreamItem powerup;
+    int powerup_active;
+    StreamItem obstacles[STREAM_MAX_OBSTACLES];
+    int obstacle_count;
+    int score;
+    int level;
+    int game_over;
+    int paused;
+} StreamFrame;
+
+typedef struct {
+    unsigned char *data;
+    size_t size;
+    size_t capacity;
+} StreamChunk;
+
+typedef struct {
+    StreamKind kind;
+    char path[256];
+    int fd;                  // -1 : pas de lecteur pour l'instant
+    int listen_fd;           // socket Unix d'écoute
+    StreamChunk chunks[STREAM_MAX_CHUNKS];
+    int chunk_first;         // premier message en attente
+    int chunk_count;
+    size_t first_offset;     // octets déjà écrits du premier message
+    size_t queued_bytes;
+    StreamFrame *prev;
+    int have_prev;
+    int need_keyframe;
+    unsigned long last_keyframe;
+
+    // Statistiques
+    unsigned long frames;
+    unsigned long keyframes;
+    unsigned long dropped;   // messages abandonnés (lecteur trop lent)
+    unsigned long bytes_written;
+    unsigned long writev_calls;
+} StreamWriter;
+
+typedef struct {
+    StreamKind kind;
+    char path[256];
+    int fd;
+    unsigned char *buffer;
+    size_t start;            // premier octet non appliqué
+    size_t size;
+    size_t capacity;
+    StreamFrame *frame;
+    int synced;              // un instantané complet a été reçu depuis la dernière perte
+    unsigned long frames;
+    unsigned long gaps;      // deltas ignorés en attendant un instantané
+} StreamReader;
+
+// ===== PROTOTYPES =====
+int stream_writer_open(StreamWriter *writer, const char *target);
+int stream_writer_open_fd(StreamWriter *writer, int fd);
+void stream_writer_close(StreamWriter *writer);
+int stream_publish(StreamWriter *writer, const StreamFrame *frame);
+
+int stream_reader_open(StreamReader *reader, const char *target);
+int stream_reader_open_fd(StreamReader *reader, int fd);
+void stream_reader_close(StreamReader *reader);
+int stream_reader_poll(StreamReader *reader);
+int stream_reader_next(StreamReader *reader);
+
+#endif
@@ -0,0 +1,310 @@
+#define _DEFAULT_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "snake_term.h"
+#include "snake_raster.h"
+
+// Pire cas par cellule : déplacement absolu (\e[rrrr;ccccH) + SGR complet
+// (\e[0;1;5;3Xm) + le caractère. Le tampon de sortie est dimensionné une
+// fois pour toutes dans term_init.
+#define TERM_CELL_MAX_BYTES 28
+#define TERM_CLEAR_SEQ "\x1b[0m\x1b[H\x1b[2J"
+
+// ===== ÉCRAN =====
+
+int term_init(TermScreen *screen, int width, int height) {
+    memset(screen, 0, sizeof(*screen));
+    screen->raw_fd = -1;
+    term_invalidate(screen);
+    if (width <= 0 || height <= 0 || width > 9999 || height > 9999) return 0;
+    size_t count = (size_t)width * height;
+    screen->cells = malloc(count * sizeof(TermCell));
+    screen->shown = malloc(count * sizeof(TermCell));
+    screen->out_cap = count * TERM_CELL_MAX_BYTES + sizeof(TERM_CLEAR_SEQ);
+    screen->out = malloc(screen->out_cap);
+    if (!screen->cells || !screen->shown || !screen->out) {
+        term_free(screen);
+        return 0;
+    }
+    screen->width = width;
+    screen->height = height;
+    term_clear(screen);
+    return 1;
+}
+
+void term_free(TermScreen *screen) {
+    free(screen->cells);
+    free(screen->shown);
+    free(screen->out);
+    screen->cells = screen->shown = NULL;
+    screen->out = NULL;
+    screen->width = screen->height = 0;
+}
+
+static void write_all(int fd, const char *data, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, data, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return;
+        data += n;
+        len -= (size_t)n;
+    }
+}
+
+// Mode brut : ni écho, ni mode ligne, ni signaux clavier (Ctrl-C arrive
+// comme un octet), lectures non bloquantes. Écran alternatif et curseur
+// masqué jusqu'à term_restore.
+int term_raw_mode(TermScreen *screen, int in_fd, int out_fd) {
+    if (tcgetattr(in_fd, &screen->saved) != 0) return 0;
+    struct termios raw = screen->saved;
+    raw.c_iflag &= ~(BRKINT | ICRNL | INPCK | ISTRIP | IXON);
+    raw.c_oflag &= ~OPOST;
+    raw.c_cflag |= CS8;
+    raw.c_lflag &= ~(ECHO | ICANON | IEXTEN | ISIG);
+    raw.c_cc[VMIN] = 0;
+    raw.c_cc[VTIME] = 0;
+    if (tcsetattr(in_fd, TCSAFLUSH, &raw) != 0) return 0;
+    screen->raw_fd = in_fd;
+    static const char enter[] = "\x1b[?1049h\x1b[?25l";
+    write_all(out_fd, enter, sizeof(enter) - 1);
+    term_invalidate(screen);
+    return 1;
+}
+
+void term_restore(TermScreen *screen, int out_fd) {
+    static const char leave[] = "\x1b[0m\x1b[?25h\x1b[?1049l";
+    write_all(out_fd, leave, sizeof(leave) - 1);
+    if (screen->raw_fd >= 0) tcsetattr(screen->raw_fd, TCSAFLUSH, &screen->saved);
+    screen->raw_fd = -1;
+}
+
+// Contenu du terminal inconnu (démarrage, redimensionnement, reprise après
+// suspension) : la prochaine image efface l'écran et repart de zéro.
+void term_invalidate(TermScreen *screen) {
+    screen->valid = 0;
+    screen->cursor_x = screen->cursor_y = screen->style = -1;
+}
+
+// ===== COMPOSITION =====
+
+void term_clear(TermScreen *screen) {
+    size_t count = (size_t)screen->width * screen->height;
+    for (size_t i = 0; i < count; i++) screen->cells[i] = (TermCell){' ', TERM_DEFAULT};
+}
+
+void term_put(TermScreen *screen, int x, int y, char ch, int style) {
+    if (x < 0 || y < 0 || x >= screen->width || y >= screen->height) return;
+    screen->cells[y * screen->width + x] = (TermCell){ch, (unsigned char)style};
+}
+
+void term_text(TermScreen *screen, int x, int y, const char *text, int style) {
+    for (; *text; text++, x++) term_put(screen, x, y, *text, style);
+}
+
+// ===== DIFFÉRENCES =====
+
+static char *put_uint(char *p, unsigned int value) {
+    char digits[10];
+    int n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    while (n) *p++ = digits[--n];
+    return p;
+}
+
+static char *put_color(char *p, int color) {
+    *p++ = '3';
+    *p++ = (char)('0' + color);
+    return p;
+}
+
+// Passe du style `from` (-1 : inconnu) au style `to`. Si seuls les
+// attributs restent, la couleur seule change ; sinon remise à zéro.
+static char *put_style(char *p, int from, int to) {
+    *p++ = '\x1b';
+    *p++ = '[';
+    if (from >= 0 && (from & ~0x0F) == (to & ~0x0F)) {
+        p = put_color(p, to & 0x0F);
+    } else {
+        *p++ = '0';
+        if (to & TERM_BOLD) {
+            *p++ = ';';
+            *p++ = '1';
+        }
+        if (to & TERM_BLINK) {
+            *p++ = ';';
+            *p++ = '5';
+        }
+        if ((to & 0x0F) != TERM_DEFAULT) {
+            *p++ = ';';
+            p = put_color(p, to & 0x0F);
+        }
+    }
+    *p++ = 'm';
+    return p;
+}
+
+static int same_cell(TermCell a, TermCell b) {
+    return a.ch == b.ch && a.style == b.style;
+}
+
+// Compose dans screen->out les séquences qui amènent le terminal de
+// l'image affichée à l'image composée, et retourne leur longueur (0 : rien
+// n'a changé). Sur une même ligne, un petit trou de cellules inchangées du
+// style courant est réécrit tel quel quand c'est plus court qu'un
+// déplacement ; sinon \e[nC, ou \e[l;cH pour changer de ligne. Le curseur
+// et le style du terminal sont repris de l'image précédente.
+size_t term_render(TermScreen *screen) {
+    char *p = screen->out;
+    int cx = screen->cursor_x, cy = screen->cursor_y, style = screen->style;
+    if (!screen->valid) {
+        memcpy(p, TERM_CLEAR_SEQ, sizeof(TERM_CLEAR_SEQ) - 1);
+        p += sizeof(TERM_CLEAR_SEQ) - 1;
+        size_t count = (size_t)screen->width * screen->height;
+        for (size_t i = 0; i < count; i++) screen->shown[i] = (TermCell){' ', TERM_DEFAULT};
+        cx = cy = 0;
+        style = TERM_DEFAULT;
+        screen->valid = 1;
+    }
+    for (int y = 0; y < screen->height; y++) {
+        TermCell *cells = screen->cells + y * screen->width;
+        TermCell *shown = screen->shown + y * screen->width;
+        for (int x = 0; x < screen->width; x++) {
+            if (same_cell(cells[x], shown[x])) continue;
+            if (cy != y || cx < 0 || x < cx) {
+                *p++ = '\x1b';
+                *p++ = '[';
+                p = put_uint(p, (unsigned int)y + 1);
+                *p++ = ';';
+                p = put_uint(p, (unsigned int)x + 1);
+                *p++ = 'H';
+            } else if (x > cx) {
+                int gap = x - cx, reuse = gap <= 3;
+                for (int k = cx; k < x && reuse; k++) reuse = shown[k].style == style;
+                if (reuse) {
+                    for (int k = cx; k < x; k++) *p++ = shown[k].ch;
+                } else {
+                    *p++ = '\x1b';
+                    *p++ = '[';
+                    p = put_uint(p, (unsigned int)gap);
+                    *p++ = 'C';
+                }
+            }
+            if (cells[x].style != style) {
+                p = put_style(p, style, cells[x].style);
+                style = cells[x].style;
+            }
+            *p++ = cells[x].ch;
+            shown[x] = cells[x];
+            cy = y;
+            // Après la dernière colonne, la position dépend du terminal
+            cx = x + 1 < screen->width ? x + 1 : -1;
+        }
+    }
+    screen->cursor_x = cx;
+    screen->cursor_y = cy;
+    screen->style = style;
+    screen->out_len = (size_t)(p - screen->out);
+    return screen->out_len;
+}
+
+// Une image : term_render puis un seul write() (répété seulement si le
+// noyau n'accepte qu'une partie du tampon). Retourne 0 en cas d'erreur.
+int term_flush(TermScreen *screen, int fd) {
+    size_t len = term_render(screen);
+    screen->frames++;
+    const char *data = screen->out;
+    while (len > 0) {
+        ssize_t n = write(fd, data, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            term_invalidate(screen);  // état du terminal inconnu
+            return 0;
+        }
+        screen->writes++;
+        screen->bytes += (unsigned long)n;
+        data += n;
+        len -= (size_t)n;
+    }
+    return 1;
+}
+
+// ===== PARTIE =====
+
+// Mêmes glyphes et couleurs que snake_ncurses (thème classique)
+static const TermCell food_glyphs[FOOD_BONUS + 1] = {
+    {'*', TERM_RED}, {'$', TERM_YELLOW}, {'X', TERM_MAGENTA}, {'!', TERM_CYAN}, {'?', TERM_WHITE}
+};
+
+static const char powerup_chars[POWERUP_MAGNETIC + 1] = {'P', 'S', 'I', 'M', 'G'};
+
+static const TermCell snake_glyphs[2][2] = {
+    {{'@', TERM_GREEN}, {'o', TERM_YELLOW}},
+    {{'#', TERM_CYAN}, {'*', TERM_BLUE}}
+};
+
+static void draw_border(TermScreen *screen, int width, int height) {
+    for (int x = 1; x <= width; x++) {
+        term_put(screen, x, 0, '-', TERM_CYAN);
+        term_put(screen, x, height + 1, '-', TERM_CYAN);
+    }
+    for (int y = 1; y <= height; y++) {
+        term_put(screen, 0, y, '|', TERM_CYAN);
+        term_put(screen, width + 1, y, '|', TERM_CYAN);
+    }
+    term_put(screen, 0, 0, '+', TERM_CYAN);
+    term_put(screen, width + 1, 0, '+', TERM_CYAN);
+    term_put(screen, 0, height + 1, '+', TERM_CYAN);
+    term_put(screen, width + 1, height + 1, '+', TERM_CYAN);
+}
+
+void term_draw_game(TermScreen *screen, const Game *game) {
+    term_clear(screen);
+    draw_border(screen, game->grid_width, game->grid_height);
+    const TileMap *map = &game->map;
+    for (int y = 0; y < map->height && game->obstacle_count > 0; y++) {
+        const Tile *row = map->tiles + y * map->width;
+        for (int x = 0; x < map->width; x++) {
+            if (row[x] == TILE_EMPTY) continue;
+            if (tile_is_portal(row[x])) term_put(screen, x + 1, y + 1, 'O', TERM_MAGENTA);
+            else term_put(screen, x + 1, y + 1, '#', TERM_WHITE);
+        }
+    }
+    for (int i = 0; i < game->food_count; i++) {
+        TermCell glyph = food_glyphs[game->foods[i].type <= FOOD_BONUS ? game->foods[i].type : FOOD_NORMAL];
+        term_put(screen, game->foods[i].pos.x + 1, game->foods[i].pos.y + 1, glyph.ch,
+                 glyph.style | (game->foods[i].pulse < 5 ? TERM_BOLD : 0));
+    }
+    if (game->powerup.active) {
+        int type = game->powerup.type <= POWERUP_MAGNETIC ? game->powerup.type : POWERUP_NONE;
+        term_put(screen, game->powerup.pos.x + 1, game->powerup.pos.y + 1, powerup_chars[type],
+                 TERM_GREEN | TERM_BOLD);
+    }
+    const Snake *snakes[2] = {&game->snake1, &game->snake2};
+    for (int s = 0; s < (game->multiplayer ? 2 : 1); s++) {
+        const Snake *snake = snakes[s];
+        const TermCell *glyphs = snake_glyphs[snake->player == 2 ? 1 : 0];
+        int head_style = glyphs[0].style;
+        if (s == 0 && game->invincible_timer > 0) head_style |= TERM_BOLD | TERM_BLINK;
+        for (int i = 0; i < snake->length; i++) {
+            term_put(screen, snake->body[i].x + 1, snake->body[i].y + 1, glyphs[i == 0 ? 0 : 1].ch,
+                     i == 0 ? head_style : glyphs[1].style);
+        }
+    }
+
+    HudState state;
+    char lines[RASTER_HUD_LINES][RASTER_HUD_TEXT + 1];
+    raster_hud_from_game(game, &state);
+    raster_hud_text(&state, lines);
+    term_text(screen, 2, 0, lines[0], TERM_WHITE);
+    if (lines[1][0]) term_text(screen, 2, game->grid_height + 1, lines[1], TERM_WHITE);
+    if (game->paused) {
+        const char *pause_msg = "PAUSE - Appuyez sur P pour continuer";
+        term_text(screen, (game->grid_width - (int)strlen(pause_msg)) / 2, game->grid_height / 2, pause_msg,
+                  TERM_WHITE);
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef SNAKE_TERM_H
+#define SNAKE_TERM_H
+
+#include <stddef.h>
+#include <termios.h>
+#include "snake_core.h"
+
+// Rendu terminal sans ncurses, pour les bornes peu puissantes : le terminal
+// est mis en mode brut (termios) par ce module, l'image est composée dans
+// une grille de cellules puis comparée à l'image affichée. Seules les
+// cellules changées partent, avec les séquences ANSI minimales (déplacement
+// du curseur, SGR), dans un tampon écrit en un seul write() par image.
+//
+// Caractères ASCII uniquement (une cellule = un octet) ; couleurs des 8
+// couleurs ANSI sur le fond par défaut du terminal.
+
+// ===== CONSTANTES =====
+typedef enum {
+    TERM_BLACK = 0, TERM_RED, TERM_GREEN, TERM_YELLOW, TERM_BLUE, TERM_MAGENTA, TERM_CYAN, TERM_WHITE,
+    TERM_DEFAULT = 9
+} TermColor;
+
+// Style d'une cellule : couleur (4 bits bas) | attributs
+#define TERM_BOLD 0x10
+#define TERM_BLINK 0x20
+
+// ===== STRUCTURES =====
+typedef struct {
+    char ch;
+    unsigned char style;
+} TermCell;
+
+typedef struct {
+    int width;
+    int height;
+    TermCell *cells;   // image en cours de composition
+    TermCell *shown;   // image affichée par le terminal
+    int valid;         // 0 : effacer l'écran et tout redessiner
+    int cursor_x;      // position et style laissés par l'image précédente,
+    int cursor_y;      // -1 : inconnus
+    int style;
+    char *out;         // séquences de la prochaine image
+    size_t out_len;
+    size_t out_cap;
+    unsigned long frames;   // images envoyées
+    unsigned long bytes;    // octets écrits
+    unsigned long writes;   // appels write()
+    int raw_fd;             // entrée en mode brut, -1 : terminal laissé tel quel
+    struct termios saved;
+} TermScreen;
+
+// ===== PROTOTYPES =====
+int term_init(TermScreen *screen, int width, int height);
+void term_free(TermScreen *screen);
+int term_raw_mode(TermScreen *screen, int in_fd, int out_fd);
+void term_restore(TermScreen *screen, int out_fd);
+void term_invalidate(TermScreen *screen);
+
+void term_clear(TermScreen *screen);
+void term_put(TermScreen *screen, int x, int y, char ch, int style);
+void term_text(TermScreen *screen, int x, int y, const char *text, int style);
+
+size_t term_render(TermScreen *screen);
+int term_flush(TermScreen *screen, int fd);
+
+// Partie : bordure (HUD dans la bordure haute et basse), grille décalée d'une
+// case. Taille d'écran : grid_width + 2 par grid_height + 2.
+void term_draw_game(TermScreen *screen, const Game *game);
+
+#endif
@@ -0,0 +1,238 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <fcntl.h>
+#include "snake_core.h"
+#include "snake_term.h"
+#include "snake_session.h"
+
+// Front end terminal sans ncurses (snake_term.h), pour les bornes peu
+// puissantes : le terminal est mis en mode brut par le programme, une image
+// n'est envoyée que si la partie a changé, en un seul write().
+//
+//   ./snake_tty [--mode classic|arcade|challenge|free]
+//               [--difficulty easy|medium|hard|extreme]
+//   ./snake_tty --bench-draw IMAGES
+//
+// Commandes : flèches ou WASD, p : pause, q ou Échap : quitter.
+//
+// --bench-draw rejoue le scénario de `snake_ncurses --bench-draw` (80x30,
+// serpent de 600 cases qui avance à chaque image) vers /dev/null et affiche
+// le temps CPU, les octets et les appels write() par image.
+
+static const char *mode_names[] = {"classic", "arcade", "challenge", "free"};
+static const char *difficulty_names[] = {"easy", "medium", "hard", "extreme"};
+
+static int parse_name(const char *value, const char *const *names, int count) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(value, names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+// ===== ENTRÉES =====
+
+// Touches lues en mode brut : flèches (\e[A..D), WASD, p, q, Échap seul ou
+// Ctrl-C. Retourne 0 si le joueur quitte.
+static int read_keys(Game *game) {
+    unsigned char buf[64];
+    ssize_t n = read(STDIN_FILENO, buf, sizeof(buf));
+    for (ssize_t i = 0; i < n; i++) {
+        int turn = -1;
+        if (buf[i] == 27 && i + 2 < n && buf[i + 1] == '[') {
+            switch (buf[i + 2]) {
+                case 'A': turn = UP; break;
+                case 'B': turn = DOWN; break;
+                case 'C': turn = RIGHT; break;
+                case 'D': turn = LEFT; break;
+            }
+            i += 2;
+        } else {
+            switch (buf[i]) {
+                case 'w': turn = UP; break;
+                case 'd': turn = RIGHT; break;
+                case 's': turn = DOWN; break;
+                case 'a': turn = LEFT; break;
+                case 'p':
+                    game->paused = !game->paused;
+                    break;
+                case 'q':
+                case 27:
+                case 3:
+                    return 0;
+            }
+        }
+        if (turn >= 0 && !game->paused) queue_turn(&game->snake1, (Direction)turn, snake_ticks_ms());
+    }
+    return 1;
+}
+
+// ===== BOUCLE DE JEU =====
+
+// La simulation avance au rythme de game->speed ; entre deux ticks, le
+// programme dort dans poll() sur l'entrée standard. Le clignotement de la
+// tête invincible est confié au terminal (SGR 5) : aucune image en plus.
+static void play(Game *game, TermScreen *screen) {
+    unsigned int last_move = snake_ticks_ms();
+    unsigned long drawn_tick = (unsigned long)-1;
+    int drawn_paused = -1;
+    int running = 1;
+    while (running && !game->game_over) {
+        if (game->tick != drawn_tick || game->paused != drawn_paused) {
+            term_draw_game(screen, game);
+            term_flush(screen, STDOUT_FILENO);
+            drawn_tick = game->tick;
+            drawn_paused = game->paused;
+        }
+        unsigned int now = snake_ticks_ms();
+        int wait = game->paused ? -1 : (int)(last_move + game->speed - now);
+        if (wait < 0 && !game->paused) wait = 0;
+        struct pollfd input = {STDIN_FILENO, POLLIN, 0};
+        if (poll(&input, 1, wait) > 0) running = read_keys(game);
+        now = snake_ticks_ms();
+        if (!game->paused && now - last_move >= (unsigned int)game->speed) {
+            step_game(game);
+            last_move = now;
+        }
+    }
+}
+
+// ===== MESURE DU RENDU (--bench-draw) =====
+
+// Octets et appels système d'écriture du processus (/proc/self/io)
+static int read_write_counters(unsigned long *bytes, unsigned long *calls) {
+    FILE *f = fopen("/proc/self/io", "r");
+    if (!f) return 0;
+    char line[64];
+    int found = 0;
+    while (fgets(line, sizeof(line), f)) {
+        found += sscanf(line, "wchar: %lu", bytes) == 1;
+        found += sscanf(line, "syscw: %lu", calls) == 1;
+    }
+    fclose(f);
+    return found == 2;
+}
+
+static void lay_bench_snake(Game *game, int length, int offset) {
+    int cells = game->grid_width * game->grid_height;
+    game->snake1.length = length;
+    for (int i = 0; i < length; i++) {
+        int p = (offset + length - 1 - i) % cells;
+        int y = p / game->grid_width, x = p % game->grid_width;
+        game->snake1.body[i] = (Position){y % 2 ? game->grid_width - 1 - x : x, y};
+    }
+}
+
+static int bench_draw(int frames) {
+    int fd = open("/dev/null", O_WRONLY);
+    Game *game = malloc(sizeof(Game));
+    TermScreen screen;
+    if (fd < 0 || !game) {
+        if (fd >= 0) close(fd);
+        free(game);
+        return 0;
+    }
+    if (!init_game_seeded(game, MODE_CHALLENGE, DIFF_EASY, 0, 1)) {
+        close(fd);
+        free(game);
+        return 0;
+    }
+    game->food_count = MAX_FOOD;
+    generate_food(game);
+    game->powerup = (PowerUp){{game->grid_width - 3, 2}, POWERUP_MAGNETIC, 0, 1};
+    game->magnetic_timer = 1;
+    if (!term_init(&screen, game->grid_width + 2, game->grid_height + 2)) {
+        close(fd);
+        free_game(game);
+        free(game);
+        return 0;
+    }
+
+    unsigned long bytes0 = 0, calls0 = 0, bytes1 = 0, calls1 = 0;
+    int counted = read_write_counters(&bytes0, &calls0);
+    clock_t start = clock();
+    for (int f = 0; f < frames; f++) {
+        lay_bench_snake(game, 600, f);
+        game->score = f;
+        term_draw_game(&screen, game);
+        term_flush(&screen, fd);
+    }
+    double cpu = (double)(clock() - start) / CLOCKS_PER_SEC;
+    counted = counted && read_write_counters(&bytes1, &calls1);
+    printf("snake_tty %dx%d : %d images, %.1f µs CPU par image, %.1f octets par image, %.2f write() par image\n",
+           game->grid_width, game->grid_height, frames, cpu / frames * 1e6, (double)screen.bytes / frames,
+           (double)screen.writes / frames);
+    if (counted) {
+        printf("  /proc/self/io : %.1f octets par image, %.2f write() par image\n",
+               (double)(bytes1 - bytes0) / frames, (double)(calls1 - calls0) / frames);
+    }
+    term_free(&screen);
+    close(fd);
+    free_game(game);
+    free(game);
+    return 1;
+}
+
+// ===== PROGRAMME PRINCIPAL =====
+
+int main(int argc, char *argv[]) {
+    int mode = MODE_CLASSIC, difficulty = DIFF_MEDIUM, bench_frames = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc) {
+            mode = parse_name(argv[++i], mode_names, 4);
+        } else if (strcmp(argv[i], "--difficulty") == 0 && i + 1 < argc) {
+            difficulty = parse_name(argv[++i], difficulty_names, 4);
+        } else if (strcmp(argv[i], "--bench-draw") == 0 && i + 1 < argc) {
+            bench_frames = atoi(argv[++i]);
+            if (bench_frames <= 0) mode = -1;
+        } else {
+            mode = -1;
+        }
+        if (mode < 0 || difficulty < 0) {
+            fprintf(stderr, "Usage : %s [--mode classic|arcade|challenge|free] "
+                            "[--difficulty easy|medium|hard|extreme]\n"
+                            "       %s --bench-draw IMAGES\n", argv[0], argv[0]);
+            return 1;
+        }
+    }
+    if (bench_frames > 0) return bench_draw(bench_frames) ? 0 : 1;
+
+    if (!isatty(STDIN_FILENO) || !isatty(STDOUT_FILENO)) {
+        fprintf(stderr, "Erreur : %s demande un terminal\n", argv[0]);
+        return 1;
+    }
+    Game *game = malloc(sizeof(Game));
+    if (!game) return 1;
+    unsigned int seed = (unsigned int)time(NULL);
+    if (!init_game_seeded(game, (GameMode)mode, (Difficulty)difficulty, 0, seed)) {
+        fprintf(stderr, "Erreur : mémoire insuffisante pour la carte\n");
+        free(game);
+        return 1;
+    }
+    TermScreen screen;
+    if (!term_init(&screen, game->grid_width + 2, game->grid_height + 2) || !term_raw_mode(&screen, STDIN_FILENO, STDOUT_FILENO)) {
+        fprintf(stderr, "Erreur : impossible de préparer le terminal\n");
+        term_free(&screen);
+        free_game(game);
+        free(game);
+        return 1;
+    }
+
+    play(game, &screen);
+
+    term_restore(&screen, STDOUT_FILENO);
+    game->time_played = (snake_ticks_ms() - game->start_time) / 1000;
+    add_top_score(game, game->score);
+    session_log_game(SESSION_LOG_DEFAULT, game, seed, 0);
+    printf("Score : %d | Niveau : %d | Longueur : %d | %lu images, %.1f octets par image\n", game->score,
+           game->level, game->snake1.length, screen.frames,
+           screen.frames ? (double)screen.bytes / screen.frames : 0.0);
+    term_free(&screen);
+    free_game(game);
+    free(game);
+    return 0;
+}
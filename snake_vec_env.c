@@ -0,0 +1,165 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "snake_vec_env.h"
+
+// ===== ENVIRONNEMENTS =====
+
+// Couche statique d'un environnement, recalculée à chaque nouvel épisode
+// (les obstacles du mode défi changent d'une partie à l'autre).
+static void build_layer(VecEnv *env, int index) {
+    unsigned char *layer = env->layers + (size_t)index * env->width * env->height;
+    const TileMap *map = &env->games[index].map;
+    if (map->wall_count == 0 && map->portal_count == 0) {
+        memset(layer, VEC_CELL_EMPTY, (size_t)env->width * env->height);
+        return;
+    }
+    for (int i = 0; i < env->width * env->height; i++) {
+        Tile tile = map->tiles[i];
+        layer[i] = tile == TILE_EMPTY ? VEC_CELL_EMPTY : tile_is_portal(tile) ? VEC_CELL_PORTAL : VEC_CELL_WALL;
+    }
+}
+
+static unsigned int episode_seed(const VecEnv *env, int index) {
+    return env->seeds[index] + (unsigned int)(env->episodes[index] * env->num_envs);
+}
+
+static void start_episode(VecEnv *env, int index) {
+    reset_game(&env->games[index], episode_seed(env, index));
+    build_layer(env, index);
+}
+
+int vec_env_init(VecEnv *env, int num_envs, GameMode mode, Difficulty difficulty, unsigned long max_steps) {
+    memset(env, 0, sizeof(*env));
+    if (num_envs <= 0) return 0;
+    env->num_envs = num_envs;
+    env->mode = mode;
+    env->difficulty = difficulty;
+    env->max_steps = max_steps;
+    env->games = calloc(num_envs, sizeof(Game));
+    env->seeds = calloc(num_envs, sizeof(unsigned int));
+    env->episodes = calloc(num_envs, sizeof(unsigned long));
+    if (!env->games || !env->seeds || !env->episodes) {
+        vec_env_free(env);
+        return 0;
+    }
+    for (int i = 0; i < num_envs; i++) {
+        env->seeds[i] = (unsigned int)i + 1;
+        if (!init_game_seeded(&env->games[i], mode, difficulty, 0, env->seeds[i])) {
+            vec_env_free(env);
+            return 0;
+        }
+    }
+    env->width = env->games[0].grid_width;
+    env->height = env->games[0].grid_height;
+    env->layers = malloc((size_t)num_envs * env->width * env->height);
+    if (!env->layers) {
+        vec_env_free(env);
+        return 0;
+    }
+    for (int i = 0; i < num_envs; i++) build_layer(env, i);
+    return 1;
+}
+
+void vec_env_free(VecEnv *env) {
+    if (env->games) {
+        for (int i = 0; i < env->num_envs; i++) free_game(&env->games[i]);
+    }
+    free(env->games);
+    free(env->layers);
+    free(env->seeds);
+    free(env->episodes);
+    memset(env, 0, sizeof(*env));
+}
+
+// Recommence toutes les parties. seeds peut être NULL (graines 1..N) ;
+// obs_out peut être NULL.
+void vec_env_reset(VecEnv *env, const unsigned int *seeds, unsigned char *obs_out) {
+    size_t cells = (size_t)env->width * env->height;
+    for (int i = 0; i < env->num_envs; i++) {
+        env->seeds[i] = seeds ? seeds[i] : (unsigned int)i + 1;
+        env->episodes[i] = 0;
+        start_episode(env, i);
+        if (obs_out) vec_env_observe(env, i, obs_out + i * cells);
+    }
+}
+
+// Avance toutes les parties d'un tick. obs_out, rewards_out et dones_out
+// peuvent être NULL si l'appelant n'en a pas besoin.
+void vec_env_step(VecEnv *env, const unsigned char *actions, unsigned char *obs_out,
+                  float *rewards_out, unsigned char *dones_out) {
+    size_t cells = (size_t)env->width * env->height;
+    for (int i = 0; i < env->num_envs; i++) {
+        Game *game = &env->games[i];
+        if (actions[i] < VEC_ENV_KEEP) {
+            game->snake1.turn_count = 0;
+            queue_turn(&game->snake1, (Direction)actions[i], 0);
+        }
+        int before = game->score;
+        step_game(game);
+        int reward = game->score - before;
+        unsigned char done = 0;
+        if (game->game_over) {
+            done = VEC_ENV_DONE;
+        } else if (env->max_steps && game->tick >= env->max_steps) {
+            done = VEC_ENV_DONE | VEC_ENV_TRUNCATED;
+        }
+        if (done) {
+            if (env->log) {
+                SessionRecord record;
+                session_record_fill(&record, game, episode_seed(env, i),
+                                    SESSION_HEADLESS | (done & VEC_ENV_TRUNCATED ? SESSION_TRUNCATED : 0));
+                session_log_append(env->log, &record);
+            }
+            env->episodes[i]++;
+            env->episodes_done++;
+            start_episode(env, i);
+        }
+        if (rewards_out) rewards_out[i] = (float)reward;
+        if (dones_out) dones_out[i] = done;
+        if (obs_out) vec_env_observe(env, i, obs_out + i * cells);
+    }
+    env->steps += (unsigned long)env->num_envs;
+}
+
+// Grille d'un environnement : couche statique, puis nourriture, power-up,
+// corps et tête (la tête est écrite en dernier).
+void vec_env_observe(const VecEnv *env, int index, unsigned char *out) {
+    const Game *game = &env->games[index];
+    int width = env->width;
+    memcpy(out, env->layers + (size_t)index * width * env->height, (size_t)width * env->height);
+    for (int i = 0; i < game->food_count; i++) {
+        out[game->foods[i].pos.y * width + game->foods[i].pos.x] = VEC_CELL_FOOD;
+    }
+    if (game->powerup.active) out[game->powerup.pos.y * width + game->powerup.pos.x] = VEC_CELL_POWERUP;
+    const Snake *snake = &game->snake1;
+    for (int i = 1; i < snake->length; i++) {
+        out[snake->body[i].y * width + snake->body[i].x] = VEC_CELL_BODY;
+    }
+    out[snake->body[0].y * width + snake->body[0].x] = VEC_CELL_HEAD;
+}
+
+// ===== LIAISONS =====
+
+VecEnv *vec_env_create(int num_envs, int mode, int difficulty, unsigned long max_steps) {
+    VecEnv *env = malloc(sizeof(VecEnv));
+    if (!env) return NULL;
+    if (!vec_env_init(env, num_envs, (GameMode)mode, (Difficulty)difficulty, max_steps)) {
+        free(env);
+        return NULL;
+    }
+    return env;
+}
+
+void vec_env_destroy(VecEnv *env) {
+    if (!env) return;
+    vec_env_free(env);
+    free(env);
+}
+
+void vec_env_shape(const VecEnv *env, int *num_envs, int *height, int *width) {
+    *num_envs = env->num_envs;
+    *height = env->height;
+    *width = env->width;
+}
@@ -0,0 +1,71 @@
+#ifndef SNAKE_VEC_ENV_H
+#define SNAKE_VEC_ENV_H
+
+#include "snake_core.h"
+#include "snake_session.h"
+
+// Environnement vectorisé pour l'apprentissage par renforcement : N parties
+// indépendantes avancées ensemble par vec_env_step. Les sorties vont dans
+// des tampons contigus fournis par l'appelant (tableaux numpy par exemple,
+// voir examples/vec_env.py) ; aucune allocation après vec_env_init.
+//
+//   obs     : uint8  [N][hauteur][largeur]   codes VEC_CELL_*
+//   rewards : float  [N]                     points gagnés pendant le tick
+//   dones   : uint8  [N]                     VEC_ENV_DONE | VEC_ENV_TRUNCATED
+//   actions : uint8  [N]                     0 haut, 1 droite, 2 bas, 3 gauche,
+//                                            4 (ou plus) garder la direction
+//
+// Une partie finie repart aussitôt : son observation est déjà celle du
+// premier état de l'épisode suivant, `dones` et `rewards` décrivent le tick
+// qui l'a terminée. Après vec_env_reset(seeds), l'épisode e de
+// l'environnement i utilise la graine seeds[i] + e * N. Si `log` est
+// renseigné, chaque épisode terminé y est ajouté (snake_session.h).
+
+// ===== CONSTANTES =====
+#define VEC_ENV_DONE 0x01
+#define VEC_ENV_TRUNCATED 0x02
+#define VEC_ENV_KEEP 4
+
+enum {
+    VEC_CELL_EMPTY = 0,
+    VEC_CELL_WALL,
+    VEC_CELL_PORTAL,
+    VEC_CELL_FOOD,
+    VEC_CELL_POWERUP,
+    VEC_CELL_BODY,
+    VEC_CELL_HEAD
+};
+
+// ===== STRUCTURES =====
+typedef struct {
+    int num_envs;
+    GameMode mode;
+    Difficulty difficulty;
+    unsigned long max_steps;      // 0 : épisodes sans limite de durée
+    int width;
+    int height;
+    Game *games;
+    unsigned char *layers;        // couche statique (murs, portails) par environnement
+    unsigned int *seeds;          // graine de l'épisode 0 de chaque environnement
+    unsigned long *episodes;
+    SessionLog *log;              // journal des épisodes terminés, NULL : aucun
+
+    // Statistiques
+    unsigned long steps;
+    unsigned long episodes_done;
+} VecEnv;
+
+// ===== PROTOTYPES =====
+int vec_env_init(VecEnv *env, int num_envs, GameMode mode, Difficulty difficulty, unsigned long max_steps);
+void vec_env_free(VecEnv *env);
+void vec_env_reset(VecEnv *env, const unsigned int *seeds, unsigned char *obs_out);
+void vec_env_step(VecEnv *env, const unsigned char *actions, unsigned char *obs_out,
+                  float *rewards_out, unsigned char *dones_out);
+void vec_env_observe(const VecEnv *env, int index, unsigned char *out);
+
+// Pour les liaisons (ctypes...) qui ne connaissent pas la taille de VecEnv
+VecEnv *vec_env_create(int num_envs, int mode, int difficulty, unsigned long max_steps);
+void vec_env_destroy(VecEnv *env);
+void vec_env_shape(const VecEnv *env, int *num_envs, int *height, int *width);
+
+#endif
@@ -0,0 +1,1924 @@
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include "snake_core.h"
+#include "snake_arena.h"
+#include "snake_mapgen.h"
+#include "snake_net.h"
+#include "snake_stream.h"
+#include "snake_profile.h"
+#include "snake_pacing.h"
+#include "snake_font.h"
+#include "snake_raster.h"
+#include "snake_term.h"
+#include "snake_rollback.h"
+#include "snake_shm.h"
+#include "snake_botpipe.h"
+#include "snake_vec_env.h"
+#include "snake_features.h"
+#include "snake_bitboard.h"
+#include "snake_policy.h"
+#include "snake_session.h"
+#include "snake_leaderboard.h"
+
+// Tests des modules sans affichage (snake_core, arène, ...).
+// Même framework que test_snake.c.
+
+// ===== FRAMEWORK DE TEST =====
+
+static int tests_run = 0, tests_passed = 0, tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ PASS: %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ FAIL: %s (ligne %d)\n", message, __LINE__); \
+        } \
+    } while(0)
+
+#define TEST_EQUAL(actual, expected, message) TEST_ASSERT((actual) == (expected), message)
+#define TEST_RANGE(value, min, max, message) TEST_ASSERT((value) >= (min) && (value) <= (max), message)
+
+// ===== OUTILS =====
+
+// Vérifie que la grille d'occupation correspond exactement aux corps et à la nourriture.
+static int arena_is_consistent(const Arena *arena) {
+    long body_cells = 0, food_cells = 0, occupied = 0, foods = 0;
+    for (int id = 0; id < arena->snake_count; id++) {
+        const ArenaSnake *snake = &arena->snakes[id];
+        if (!snake->alive) continue;
+        body_cells += snake->length;
+        for (int i = 0; i < snake->length; i++) {
+            Position p = arena_segment(snake, i);
+            if (!arena_in_bounds(arena, p)) return 0;
+            if (arena->cells[arena_index(arena, p)] != id + 1) return 0;
+        }
+    }
+    for (int i = 0; i < arena->food_count; i++) {
+        if (arena->foods[i].x < 0) continue;
+        foods++;
+        if (arena->cells[arena_index(arena, arena->foods[i])] != -(i + 1)) return 0;
+    }
+    for (int i = 0; i < arena->width * arena->height; i++) {
+        if (arena->cells[i] > 0) occupied++;
+        if (arena->cells[i] < 0) food_cells++;
+    }
+    return occupied == body_cells && food_cells == foods;
+}
+
+// ===== TESTS =====
+
+void test_arena_init() {
+    printf("\n=== Test: arena_init ===\n");
+    Arena arena;
+    TEST_EQUAL(arena_init(&arena, 128, 128, 100, 64, 100, 42), 1, "Arène initialisée");
+    TEST_EQUAL(arena.snake_count, 100, "100 serpents");
+    TEST_EQUAL(arena.alive_count, 100, "Tous les serpents sont vivants");
+    TEST_EQUAL(arena.snakes[0].length, 1, "Serpent apparu avec un segment");
+    TEST_EQUAL(arena.snakes[0].grow, ARENA_START_LENGTH - 1, "Croissance initiale en attente");
+    TEST_ASSERT(arena_is_consistent(&arena), "Occupation cohérente après initialisation");
+    arena_free(&arena);
+    TEST_EQUAL(arena_init(&arena, 0, 10, 1, 64, 1, 1), 0, "Grille vide refusée");
+    TEST_EQUAL(arena_init(&arena, 10, 10, 1, 2, 1, 1), 0, "Capacité trop petite refusée");
+}
+
+void test_arena_ticks_consistent() {
+    printf("\n=== Test: arena_tick (cohérence) ===\n");
+    Arena arena;
+    arena_init(&arena, 96, 64, 200, 32, 50, 7);
+    int consistent = 1;
+    for (int t = 0; t < 500; t++) {
+        arena_tick(&arena);
+        if (!arena_is_consistent(&arena)) consistent = 0;
+    }
+    TEST_ASSERT(consistent, "Occupation cohérente pendant 500 ticks");
+    TEST_EQUAL(arena.tick, 500UL, "Compteur de ticks");
+    TEST_ASSERT(arena.food_eaten > 0, "De la nourriture a été mangée");
+    TEST_ASSERT(arena.deaths > 0, "Des collisions ont eu lieu sur une grille dense");
+    int max_len = 0;
+    for (int id = 0; id < arena.snake_count; id++) {
+        if (arena.snakes[id].length > max_len) max_len = arena.snakes[id].length;
+    }
+    TEST_RANGE(max_len, ARENA_START_LENGTH, 32, "Longueur bornée par la capacité");
+    arena_free(&arena);
+}
+
+void test_arena_deterministic() {
+    printf("\n=== Test: arena déterministe ===\n");
+    Arena a, b;
+    arena_init(&a, 64, 64, 50, 64, 20, 1234);
+    arena_init(&b, 64, 64, 50, 64, 20, 1234);
+    for (int t = 0; t < 300; t++) {
+        arena_tick(&a);
+        arena_tick(&b);
+    }
+    TEST_ASSERT(memcmp(a.cells, b.cells, sizeof(int) * 64 * 64) == 0, "Même graine, même grille");
+    TEST_EQUAL(a.food_eaten, b.food_eaten, "Même graine, même nourriture mangée");
+    TEST_EQUAL(a.deaths, b.deaths, "Même graine, mêmes morts");
+    arena_free(&a);
+    arena_free(&b);
+}
+
+void test_arena_eat_and_collide() {
+    printf("\n=== Test: arena nourriture et collisions ===\n");
+    Arena arena;
+    arena_init(&arena, 8, 8, 1, 16, 1, 99);
+    memset(arena.cells, 0, sizeof(int) * 64);
+    ArenaSnake *snake = &arena.snakes[0];
+    snake->head = 0;
+    snake->body[0] = (Position){2, 2};
+    snake->length = 1;
+    snake->grow = 0;
+    snake->direction = RIGHT;
+    arena.cells[arena_index(&arena, snake->body[0])] = 1;
+    arena.foods[0] = (Position){3, 2};
+    arena.cells[arena_index(&arena, arena.foods[0])] = -1;
+
+    arena_tick(&arena);
+    TEST_EQUAL(arena_segment(snake, 0).x, 3, "La tête avance vers la nourriture");
+    TEST_EQUAL(snake->score, 1, "Nourriture comptée");
+    TEST_EQUAL(snake->grow, 1, "Croissance programmée");
+    TEST_ASSERT(arena.foods[0].x != 3 || arena.foods[0].y != 2, "Nourriture replacée");
+    arena_tick(&arena);
+    TEST_EQUAL(snake->length, 2, "Le serpent a grandi");
+    TEST_ASSERT(arena_is_consistent(&arena), "Occupation cohérente après repas");
+
+    // Un mur de bord : le serpent coincé dans un coin meurt.
+    memset(arena.cells, 0, sizeof(int) * 64);
+    snake->head = 0;
+    snake->body[0] = (Position){0, 0};
+    snake->body[1] = (Position){1, 0};
+    snake->length = 2;
+    snake->grow = 0;
+    snake->direction = LEFT;
+    arena.cells[0] = 1;
+    arena.cells[1] = 1;
+    arena.cells[arena_index(&arena, (Position){0, 1})] = 1;  // case bloquée
+    arena.foods[0] = (Position){7, 7};
+    arena.cells[63] = -1;
+    arena_tick(&arena);
+    TEST_EQUAL(snake->alive, 0, "Serpent mort sans issue");
+    TEST_EQUAL(arena.alive_count, 0, "Plus aucun serpent vivant");
+    TEST_EQUAL(snake->respawn_timer, ARENA_RESPAWN_TICKS - 1, "Réapparition programmée");
+    arena_free(&arena);
+}
+
+// Place un serpent de longueur `length` horizontal, tête en (x, y), corps vers la gauche.
+static void arena_place_snake(Arena *arena, int id, int x, int y, int length, Direction dir) {
+    ArenaSnake *snake = &arena->snakes[id];
+    snake->head = 0;
+    snake->length = length;
+    snake->grow = 0;
+    snake->direction = dir;
+    snake->alive = 1;
+    for (int i = 0; i < length; i++) {
+        snake->body[i] = (Position){x - i, y};
+        arena->cells[arena_index(arena, snake->body[i])] = id + 1;
+    }
+}
+
+static void arena_clear(Arena *arena, Position food) {
+    memset(arena->cells, 0, sizeof(int) * arena->width * arena->height);
+    arena->foods[0] = food;
+    arena->cells[arena_index(arena, food)] = -1;
+    arena->alive_count = arena->snake_count;
+}
+
+void test_arena_simultaneous_moves() {
+    printf("\n=== Test: arena résolution simultanée ===\n");
+    Arena arena;
+    arena_init(&arena, 8, 1, 2, 8, 1, 5);
+
+    // Deux têtes visent la même nourriture : les deux meurent, la nourriture reste.
+    arena_clear(&arena, (Position){3, 0});
+    arena_place_snake(&arena, 0, 2, 0, 1, RIGHT);
+    arena_place_snake(&arena, 1, 4, 0, 1, LEFT);
+    arena_tick(&arena);
+    TEST_EQUAL(arena.snakes[0].alive, 0, "Face à face : serpent 1 mort");
+    TEST_EQUAL(arena.snakes[1].alive, 0, "Face à face : serpent 2 mort (pas d'avantage au premier)");
+    TEST_EQUAL(arena.head_on, 2UL, "Deux morts par face à face");
+    TEST_EQUAL(arena.cells[3], -1, "La nourriture disputée reste en place");
+
+    // Échange de cases : chacun entre dans la tête de l'autre (serpents qui
+    // grandissent, comme à l'apparition, donc sans queue libérée).
+    arena_clear(&arena, (Position){7, 0});
+    arena_place_snake(&arena, 0, 2, 0, 1, RIGHT);
+    arena_place_snake(&arena, 1, 3, 0, 1, LEFT);
+    arena.snakes[0].grow = 1;
+    arena.snakes[1].grow = 1;
+    arena_tick(&arena);
+    TEST_ASSERT(!arena.snakes[0].alive && !arena.snakes[1].alive, "Échange de cases : les deux meurent");
+
+    // Suivre une queue qui avance est autorisé.
+    arena_clear(&arena, (Position){7, 0});
+    arena_place_snake(&arena, 0, 2, 0, 1, RIGHT);
+    arena_place_snake(&arena, 1, 4, 0, 2, RIGHT);
+    arena_tick(&arena);
+    TEST_EQUAL(arena.snakes[0].alive, 1, "Entrer dans une queue qui se libère");
+    TEST_EQUAL(arena_segment(&arena.snakes[0], 0).x, 3, "Tête sur l'ancienne queue");
+    TEST_EQUAL(arena.cells[3], 1, "Case attribuée au serpent qui suit");
+    TEST_ASSERT(arena_is_consistent(&arena), "Occupation cohérente");
+    arena_free(&arena);
+}
+
+void test_arena_thread_independence() {
+    printf("\n=== Test: arena indépendante du nombre de threads ===\n");
+    unsigned long hashes[3];
+    int threads[3] = {1, 3, 8};
+    for (int t = 0; t < 3; t++) {
+        Arena arena;
+        arena_init(&arena, 80, 60, 300, 32, 100, 77);
+        arena.lookahead = 16;
+        TEST_EQUAL(arena_set_threads(&arena, threads[t]), 1, "Threads démarrés");
+        for (int i = 0; i < 200; i++) arena_tick(&arena);
+        hashes[t] = arena_hash(&arena);
+        TEST_ASSERT(arena_is_consistent(&arena), "Occupation cohérente avec threads");
+        arena_free(&arena);
+    }
+    TEST_EQUAL(hashes[0], hashes[1], "1 thread et 3 threads : même état");
+    TEST_EQUAL(hashes[0], hashes[2], "1 thread et 8 threads : même état");
+
+    // Au-delà de ARENA_MAX_LOOKAHEAD : même IA qu'à la borne
+    for (int t = 0; t < 2; t++) {
+        Arena arena;
+        arena_init(&arena, 80, 60, 300, 32, 100, 77);
+        arena.lookahead = ARENA_MAX_LOOKAHEAD + t;
+        for (int i = 0; i < 50; i++) arena_tick(&arena);
+        hashes[t] = arena_hash(&arena);
+        TEST_ASSERT(arena_is_consistent(&arena), "Occupation cohérente, lookahead élevé");
+        arena_free(&arena);
+    }
+    TEST_EQUAL(hashes[0], hashes[1], "Lookahead borné à ARENA_MAX_LOOKAHEAD");
+}
+
+void test_tilemap() {
+    printf("\n=== Test: TileMap ===\n");
+    TileMap map;
+    TEST_EQUAL(tilemap_init(&map, 10, 5), 1, "Carte allouée");
+    unsigned int version = map.version;
+    TEST_EQUAL(tilemap_get(&map, (Position){3, 2}), TILE_EMPTY, "Case vide par défaut");
+    TEST_EQUAL(tilemap_set_wall(&map, (Position){3, 2}), 1, "Mur posé");
+    TEST_EQUAL(tilemap_set_wall(&map, (Position){3, 2}), 0, "Case déjà occupée refusée");
+    TEST_EQUAL(tilemap_get(&map, (Position){3, 2}), TILE_WALL, "Lecture du mur");
+    TEST_ASSERT(map.version != version, "Version changée après modification");
+    int id = tilemap_add_portal(&map, (Position){5, 1}, (Position){8, 4});
+    TEST_EQUAL(id, 0, "Premier portail = identifiant 0");
+    Tile tile = tilemap_get(&map, (Position){5, 1});
+    TEST_ASSERT(tile_is_portal(tile), "Case portail reconnue");
+    TEST_EQUAL(map.portal_dest[tile_portal_id(tile)].x, 8, "Destination X du portail");
+    TEST_EQUAL(map.portal_dest[tile_portal_id(tile)].y, 4, "Destination Y du portail");
+    TEST_EQUAL(tilemap_add_portal(&map, (Position){3, 2}, (Position){0, 0}), -1, "Portail sur un mur refusé");
+    for (int i = 0; i < 20; i++) {
+        tilemap_add_portal(&map, (Position){i % 10, i < 10 ? 0 : 3}, (Position){0, 4});
+    }
+    TEST_EQUAL(map.portal_count, 21, "Table des portails agrandie");
+    TEST_EQUAL(map.portal_dest[20].y, 4, "Destinations conservées après agrandissement");
+    TEST_EQUAL(map.wall_count, 1, "Un seul mur");
+    tilemap_clear(&map);
+    TEST_EQUAL(tilemap_get(&map, (Position){3, 2}), TILE_EMPTY, "Carte effacée");
+    TEST_EQUAL(map.portal_count, 0, "Portails effacés");
+    tilemap_free(&map);
+    TEST_ASSERT(map.tiles == NULL, "Carte libérée");
+}
+
+void test_core_obstacles() {
+    printf("\n=== Test: obstacles du noyau ===\n");
+    Game game;
+    init_game(&game, MODE_CHALLENGE, DIFF_EASY, 0);
+    int walls = 0, portals = 0;
+    for (int y = 0; y < game.grid_height; y++) {
+        for (int x = 0; x < game.grid_width; x++) {
+            Tile tile = tilemap_get(&game.map, (Position){x, y});
+            if (tile == TILE_WALL) walls++;
+            else if (tile_is_portal(tile)) portals++;
+        }
+    }
+    TEST_EQUAL(walls + portals, game.obstacle_count, "Tuiles = nombre d'obstacles");
+    TEST_EQUAL(portals, game.map.portal_count, "Portails = table des destinations");
+    TEST_RANGE(game.obstacle_count, 1, (80 * 30) / 50, "Obstacles générés en mode défi");
+    free_game(&game);
+
+    init_game(&game, MODE_CLASSIC, DIFF_MEDIUM, 0);
+    TEST_EQUAL(game.obstacle_count, 0, "Pas d'obstacle en mode classique");
+    Position wall = {5, 5};
+    tilemap_set_wall(&game.map, wall);
+    game.obstacle_count = 1;
+    TEST_EQUAL(is_position_valid(&game, wall, 0), 0, "Position sur un mur rejetée");
+    game.snake1.body[0] = wall;
+    check_obstacle_collision(&game, &game.snake1);
+    TEST_EQUAL(game.game_over, 1, "Mur mortel en mode classique");
+
+    game.game_over = 0;
+    game.mode = MODE_ARCADE;
+    game.snake1.lives = 3;
+    game.snake1.body[0] = wall;
+    check_obstacle_collision(&game, &game.snake1);
+    TEST_EQUAL(game.game_over, 0, "Mur non mortel en arcade");
+    TEST_EQUAL(game.snake1.lives, 2, "Une vie perdue sur un mur");
+    TEST_EQUAL(game.snake1.body[0].x, game.grid_width / 2, "Serpent replacé au centre");
+
+    game.snake1.lives = 3;
+    game.invincible_timer = 10;
+    game.snake1.body[0] = wall;
+    check_obstacle_collision(&game, &game.snake1);
+    TEST_EQUAL(game.snake1.lives, 3, "Invincible : pas de vie perdue");
+    game.invincible_timer = 0;
+
+    Position portal = {10, 3};
+    tilemap_add_portal(&game.map, portal, (Position){40, 12});
+    game.snake1.body[0] = portal;
+    check_obstacle_collision(&game, &game.snake1);
+    TEST_EQUAL(game.snake1.body[0].x, 40, "Téléportation X");
+    TEST_EQUAL(game.snake1.body[0].y, 12, "Téléportation Y");
+    free_game(&game);
+}
+
+void test_core_move_snake() {
+    printf("\n=== Test: move_snake du noyau ===\n");
+    Game game;
+    init_game(&game, MODE_FREE, DIFF_MEDIUM, 0);
+    game.food_count = 0;
+    game.snake1.body[0] = (Position){game.grid_width - 1, 5};
+    game.snake1.body[1] = (Position){game.grid_width - 2, 5};
+    game.snake1.body[2] = (Position){game.grid_width - 3, 5};
+    move_snake(&game, &game.snake1);
+    TEST_EQUAL(game.snake1.body[0].x, 0, "Mode libre : traversée du bord droit");
+    TEST_EQUAL(game.snake1.body[1].x, game.grid_width - 1, "Le corps suit la tête");
+    TEST_EQUAL(game.game_over, 0, "Pas de fin de partie en mode libre");
+    free_game(&game);
+
+    init_game(&game, MODE_CLASSIC, DIFF_MEDIUM, 0);
+    game.food_count = 0;
+    game.snake1.body[0] = (Position){game.grid_width - 1, 5};
+    move_snake(&game, &game.snake1);
+    TEST_EQUAL(game.game_over, 1, "Mode classique : le bord est mortel");
+    free_game(&game);
+}
+
+void test_mapgen_connected() {
+    printf("\n=== Test: génération connexe ===\n");
+    TileMap map;
+    TEST_ASSERT(tilemap_init(&map, 120, 80), "Allocation de la carte");
+    MapGenParams params;
+    mapgen_default_params(&params);
+    params.density = 0.35;
+    params.clear_x0 = 10;
+    params.clear_y0 = 10;
+    params.clear_x1 = 20;
+    params.clear_y1 = 12;
+    int bad = 0, clear_hit = 0, dense_enough = 1;
+    for (int p = 0; p < MAPGEN_PATTERN_COUNT; p++) {
+        params.pattern = (MapPattern)p;
+        for (unsigned int seed = 1; seed <= 20; seed++) {
+            params.seed = seed;
+            int placed = mapgen_generate(&map, &params);
+            MapReport report;
+            if (!mapgen_check(&map, &report)) bad++;
+            if (placed < 120 * 80 / 5) dense_enough = 0;
+            for (int y = params.clear_y0; y <= params.clear_y1; y++) {
+                for (int x = params.clear_x0; x <= params.clear_x1; x++) {
+                    if (tilemap_get(&map, (Position){x, y}) != TILE_EMPTY) clear_hit++;
+                }
+            }
+        }
+    }
+    TEST_EQUAL(bad, 0, "Toutes les cartes sont connexes, portails vers des cases vides");
+    TEST_EQUAL(clear_hit, 0, "Zone d'apparition laissée libre");
+    TEST_ASSERT(dense_enough, "Densité élevée atteinte malgré la contrainte");
+
+    params.seed = 7;
+    mapgen_generate(&map, &params);
+    unsigned long first = 0;
+    for (long i = 0; i < 120L * 80; i++) first = first * 31 + map.tiles[i];
+    mapgen_generate(&map, &params);
+    unsigned long second = 0;
+    for (long i = 0; i < 120L * 80; i++) second = second * 31 + map.tiles[i];
+    TEST_EQUAL(first, second, "Même graine, même carte");
+    tilemap_free(&map);
+}
+
+void test_mapgen_check() {
+    printf("\n=== Test: vérification des cartes ===\n");
+    TileMap map;
+    tilemap_init(&map, 10, 10);
+    MapReport report;
+    TEST_EQUAL(mapgen_check(&map, &report), 1, "Carte vide valide");
+    TEST_EQUAL(report.free_cells, 100, "100 cases libres");
+
+    // Poche fermée : anneau de murs autour de (5, 5)
+    for (int d = -1; d <= 1; d++) {
+        tilemap_set_wall(&map, (Position){4 + d + 1, 4});
+        tilemap_set_wall(&map, (Position){4 + d + 1, 6});
+    }
+    tilemap_set_wall(&map, (Position){4, 5});
+    tilemap_set_wall(&map, (Position){6, 5});
+    TEST_EQUAL(mapgen_check(&map, &report), 0, "Poche fermée détectée");
+    TEST_EQUAL(report.components, 2, "Deux composantes");
+    TEST_EQUAL(report.largest, report.free_cells - 1, "Une case isolée");
+
+    tilemap_clear(&map);
+    tilemap_set_wall(&map, (Position){2, 2});
+    tilemap_add_portal(&map, (Position){7, 7}, (Position){2, 2});
+    TEST_EQUAL(mapgen_check(&map, &report), 0, "Portail vers un mur détecté");
+    TEST_EQUAL(report.portals_blocked, 1, "Un portail bloqué");
+
+    // Couloir d'une case de large : toujours une seule composante
+    tilemap_clear(&map);
+    for (int x = 0; x < 10; x++) {
+        for (int y = 0; y < 10; y++) {
+            if (y != 5) tilemap_set_wall(&map, (Position){x, y});
+        }
+    }
+    TEST_EQUAL(mapgen_check(&map, &report), 1, "Couloir connexe");
+    TEST_EQUAL(report.free_cells, 10, "10 cases dans le couloir");
+    tilemap_free(&map);
+}
+
+void test_core_obstacles_connected() {
+    printf("\n=== Test: obstacles du mode défi connexes ===\n");
+    int bad = 0, food_blocked = 0;
+    for (unsigned int seed = 1; seed <= 50; seed++) {
+        for (int d = DIFF_EASY; d <= DIFF_EXTREME; d++) {
+            Game game;
+            srand(seed);
+            init_game(&game, MODE_CHALLENGE, (Difficulty)d, seed % 2);
+            MapReport report;
+            if (!mapgen_check(&game.map, &report)) bad++;
+            for (int i = 0; i < game.food_count; i++) {
+                if (tilemap_get(&game.map, game.foods[i].pos) != TILE_EMPTY) food_blocked++;
+            }
+            free_game(&game);
+        }
+    }
+    TEST_EQUAL(bad, 0, "Cartes du mode défi connexes (50 graines x 4 difficultés)");
+    TEST_EQUAL(food_blocked, 0, "Nourriture jamais sur un obstacle");
+}
+
+void test_net_loopback() {
+    printf("\n=== Test: serveur UDP et deltas ===\n");
+    NetServer server;
+    int ok = net_server_init(&server, 0, 48, 32, 2, 6, 64, 6, 777);
+    TEST_ASSERT(ok, "Serveur ouvert sur un port libre");
+    if (!ok) return;
+    TEST_ASSERT(net_full_size_bound(&server.arena) > 0, "Instantané complet tient dans un paquet");
+
+    NetClient clients[3];
+    for (int i = 0; i < 3; i++) {
+        net_client_init(&clients[i], "127.0.0.1", server.port);
+        net_client_hello(&clients[i]);
+    }
+    clients[1].drop_every = 3;  // perte d'un paquet sur trois
+    net_server_poll(&server);
+    TEST_EQUAL(server.client_count, 2, "Deux places pour deux joueurs");
+    net_server_flush(&server);
+
+    int synced = 0;
+    for (int t = 0; t < 300; t++) {
+        for (int i = 0; i < 2; i++) {
+            net_client_poll(&clients[i]);
+            net_client_send_input(&clients[i], (Direction)((t / 7 + i) % 4));
+        }
+        net_server_poll(&server);
+        net_server_step(&server);
+        net_server_flush(&server);
+    }
+    net_client_poll(&clients[2]);
+    TEST_ASSERT(clients[2].refused, "Troisième client refusé");
+
+    for (int i = 0; i < 2; i++) {
+        net_client_poll(&clients[i]);
+        if (clients[i].ready && clients[i].mirror.tick == server.arena.tick &&
+            arena_hash(&clients[i].mirror) == arena_hash(&server.arena))
+            synced++;
+    }
+    TEST_EQUAL(synced, 2, "Copies des clients identiques au serveur");
+    TEST_ASSERT(clients[0].snake_id != clients[1].snake_id, "Chaque client pilote son serpent");
+    TEST_ASSERT(server.arena.snakes[clients[0].snake_id].controlled, "Serpent piloté par le réseau");
+    TEST_EQUAL(server.clients[0].full_sent, 1, "Un seul instantané complet sans perte");
+    TEST_ASSERT(clients[1].packets_ignored > 0, "Pertes simulées");
+    long full = net_full_size_bound(&server.arena);
+    TEST_ASSERT(server.clients[0].bytes_sent / 300 < (unsigned long)full / 4, "Deltas bien plus petits que l'état complet");
+
+    net_client_bye(&clients[0]);
+    net_server_poll(&server);
+    TEST_EQUAL(server.client_count, 1, "Départ libère la place");
+    TEST_EQUAL(server.arena.snakes[clients[0].snake_id].controlled, 0, "Serpent rendu à l'IA");
+    for (int i = 0; i < 3; i++) net_client_free(&clients[i]);
+    net_server_free(&server);
+}
+
+// Partie factice : un serpent qui avance, grandit, mange et réapparaît.
+static void fake_stream_step(StreamFrame *f, unsigned long t) {
+    f->tick = t;
+    f->width = 60;
+    f->height = 20;
+    f->snake_count = 1;
+    StreamSnake *snake = &f->snakes[0];
+    if (t % 250 == 0 || snake->length == 0) {
+        snake->length = 1;
+        snake->lives = 3 - (int)(t / 250) % 3;
+    } else {
+        int keep = (t % 10 == 0 && snake->length < STREAM_MAX_LENGTH) ? snake->length : snake->length - 1;
+        memmove(snake->body + 1, snake->body, keep * sizeof(StreamPos));
+        snake->length = keep + 1;
+    }
+    snake->body[0].x = (short)(t % 60);
+    snake->body[0].y = (short)((t / 60) % 20);
+    if (t % 10 == 0) snake->score += 10;
+    f->food_count = 1 + (int)(t / 50) % 3;
+    for (int i = 0; i < f->food_count; i++) {
+        f->foods[i].pos.x = (short)((t / 7 + i * 13) % 60);
+        f->foods[i].pos.y = (short)(i * 3);
+        f->foods[i].type = (unsigned char)i;
+    }
+    f->powerup_active = (t / 30) % 2;
+    f->score = snake->score;
+    f->level = 1 + (int)(t / 100);
+}
+
+static int stream_frames_equal(const StreamFrame *a, const StreamFrame *b) {
+    if (a->tick != b->tick || a->snake_count != b->snake_count || a->food_count != b->food_count ||
+        a->score != b->score || a->level != b->level || a->powerup_active != b->powerup_active ||
+        a->obstacle_count != b->obstacle_count)
+        return 0;
+    for (int s = 0; s < a->snake_count; s++) {
+        const StreamSnake *x = &a->snakes[s], *y = &b->snakes[s];
+        if (x->length != y->length || x->score != y->score || x->lives != y->lives) return 0;
+        for (int i = 0; i < x->length; i++) {
+            if (x->body[i].x != y->body[i].x || x->body[i].y != y->body[i].y) return 0;
+        }
+    }
+    for (int i = 0; i < a->food_count; i++) {
+        if (a->foods[i].pos.x != b->foods[i].pos.x || a->foods[i].type != b->foods[i].type) return 0;
+    }
+    return 1;
+}
+
+void test_stream_pipe() {
+    printf("\n=== Test: flux spectateur ===\n");
+    int fds[2];
+    TEST_ASSERT(pipe(fds) == 0, "Tube créé");
+    StreamWriter writer;
+    StreamReader reader;
+    TEST_ASSERT(stream_writer_open_fd(&writer, fds[1]), "Écrivain ouvert");
+    TEST_ASSERT(stream_reader_open_fd(&reader, fds[0]), "Lecteur ouvert");
+    StreamFrame *frame = calloc(1, sizeof(StreamFrame));
+    frame->obstacle_count = 2;
+    frame->obstacles[1].type = 1;
+    frame->obstacles[1].pos.x = 5;
+
+    int mismatches = 0;
+    unsigned long t;
+    for (t = 1; t <= 600; t++) {
+        fake_stream_step(frame, t);
+        stream_publish(&writer, frame);
+        stream_reader_poll(&reader);
+        if (!reader.synced || !stream_frames_equal(reader.frame, frame)) mismatches++;
+    }
+    TEST_EQUAL(mismatches, 0, "Lecteur identique au jeu à chaque tick");
+    TEST_RANGE(writer.keyframes, 6, 12, "Instantanés périodiques et à chaque réapparition");
+    TEST_EQUAL(writer.dropped, 0, "Aucune perte avec un lecteur rapide");
+    TEST_ASSERT(writer.bytes_written / writer.frames < 40, "Deltas de quelques octets");
+
+    // Lecteur arrêté : le jeu ne bloque jamais et abandonne des messages
+    for (; t <= 20000; t++) {
+        fake_stream_step(frame, t);
+        stream_publish(&writer, frame);
+    }
+    TEST_ASSERT(writer.dropped > 0, "Messages abandonnés quand le tube est plein");
+    while (stream_reader_poll(&reader) > 0) {
+    }
+    fake_stream_step(frame, t);
+    stream_publish(&writer, frame);
+    stream_reader_poll(&reader);
+    TEST_ASSERT(reader.synced && stream_frames_equal(reader.frame, frame), "Resynchronisé après les pertes");
+
+    stream_writer_close(&writer);
+    stream_reader_close(&reader);
+    close(fds[0]);
+    close(fds[1]);
+    free(frame);
+}
+
+void test_stream_next() {
+    printf("\n=== Test: relecture image par image ===\n");
+    int fds[2];
+    TEST_ASSERT(pipe(fds) == 0, "Tube créé");
+    StreamWriter writer;
+    StreamReader reader;
+    stream_writer_open_fd(&writer, fds[1]);
+    stream_reader_open_fd(&reader, fds[0]);
+    StreamFrame *frame = calloc(1, sizeof(StreamFrame));
+    for (unsigned long t = 1; t <= 40; t++) {
+        fake_stream_step(frame, t);
+        stream_publish(&writer, frame);
+    }
+    stream_writer_close(&writer);
+    close(fds[1]);
+    unsigned long expected = 1;
+    int in_order = 1, status;
+    while ((status = stream_reader_next(&reader)) > 0) {
+        if (reader.frame->tick != expected++) in_order = 0;
+    }
+    TEST_EQUAL(expected - 1, 40, "Une image par appel, toutes lues");
+    TEST_ASSERT(in_order, "Images dans l'ordre des ticks");
+    TEST_EQUAL(status, -1, "Fin signalée une fois tout lu");
+    TEST_ASSERT(stream_frames_equal(reader.frame, frame), "Dernière image identique");
+    stream_reader_close(&reader);
+    close(fds[0]);
+    free(frame);
+}
+
+void test_turn_queue() {
+    printf("\n=== Test: file de virages ===\n");
+    Game game;
+    init_game(&game, MODE_FREE, DIFF_MEDIUM, 0);
+    TickProfiler profiler;
+    profiler_init(&profiler);
+    game.profiler = &profiler;
+    Snake *snake = &game.snake1;
+    TEST_EQUAL(snake->direction, RIGHT, "Départ vers la droite");
+
+    // Haut puis gauche pendant le même tick : les deux virages sont joués
+    unsigned int now = snake_ticks_ms();
+    TEST_EQUAL(queue_turn(snake, UP, now), 1, "Haut accepté");
+    TEST_EQUAL(queue_turn(snake, LEFT, now), 1, "Gauche accepté après haut");
+    Position start = snake->body[0];
+    move_snake(&game, snake);
+    TEST_EQUAL(snake->direction, UP, "Premier tick : haut");
+    move_snake(&game, snake);
+    TEST_EQUAL(snake->direction, LEFT, "Deuxième tick : gauche");
+    TEST_EQUAL(snake->body[0].x, start.x - 1, "Tête décalée à gauche");
+    move_snake(&game, snake);
+    TEST_EQUAL(snake->direction, LEFT, "File vide : direction conservée");
+
+    // Demi-tour : comparé au dernier virage en attente, puis à la direction exécutée
+    TEST_EQUAL(queue_turn(snake, RIGHT, now), 0, "Demi-tour refusé");
+    TEST_EQUAL(queue_turn(snake, UP, now), 1, "Haut accepté");
+    TEST_EQUAL(queue_turn(snake, DOWN, now), 0, "Haut puis bas refusé");
+    TEST_EQUAL(queue_turn(snake, UP, now), 0, "Répétition refusée");
+    TEST_EQUAL(queue_turn(snake, RIGHT, now), 1, "Droite accepté");
+    TEST_EQUAL(queue_turn(snake, DOWN, now), 1, "Bas accepté");
+    TEST_EQUAL(queue_turn(snake, LEFT, now), 0, "File pleine");
+    TEST_EQUAL(snake->turn_count, TURN_QUEUE_SIZE, "Trois virages en attente");
+    for (int i = 0; i < 3; i++) move_snake(&game, snake);
+    TEST_EQUAL(snake->direction, DOWN, "Virages joués dans l'ordre");
+    TEST_EQUAL(game.game_over, 0, "Aucune mort par demi-tour");
+
+    TEST_EQUAL(profiler.input_latency.total, 5, "Latence mesurée pour chaque virage joué");
+    TEST_RANGE(profile_percentile(&profiler.input_latency, 50), 0, 1000, "Latence plausible");
+
+    // Virage sans horodatage (bot, IA) : joué mais hors mesure
+    TEST_EQUAL(queue_turn(snake, LEFT, 0), 1, "Virage automatique accepté");
+    move_snake(&game, snake);
+    TEST_EQUAL(snake->direction, LEFT, "Virage automatique joué");
+    TEST_EQUAL(profiler.input_latency.total, 5, "Virage automatique non mesuré");
+    free_game(&game);
+}
+
+void test_profiler() {
+    printf("\n=== Test: profileur de ticks ===\n");
+    TickProfiler profiler;
+    profiler_init(&profiler);
+    for (int i = 1; i <= 100; i++) profile_add(&profiler.update, i);
+    TEST_EQUAL(profiler.update.total, 100, "100 échantillons");
+    TEST_EQUAL((int)profile_percentile(&profiler.update, 50), 51, "Médiane");
+    TEST_EQUAL((int)profile_percentile(&profiler.update, 95), 95, "p95");
+    TEST_EQUAL((int)profiler.update.max, 100, "Maximum");
+    for (int i = 0; i < PROFILE_SAMPLES; i++) profile_add(&profiler.frame, 2);
+    profile_add(&profiler.frame, 7);
+    TEST_EQUAL(profiler.frame.count, PROFILE_SAMPLES, "Fenêtre glissante bornée");
+    TEST_EQUAL((int)profile_percentile(&profiler.frame, 100), 7, "Dernier échantillon gardé");
+    profiler.refresh_ms = 16.0;
+    profile_render(&profiler, 5);
+    profile_render(&profiler, 20);
+    profile_render(&profiler, 40);
+    TEST_EQUAL(profiler.render.total, 3, "Rendus comptés");
+    TEST_EQUAL(profiler.missed_vsyncs, 3, "Vsync manquées : une par période entière dépassée");
+}
+
+void test_frame_pacer() {
+    printf("\n=== Test: cadence d'affichage ===\n");
+    FramePacer pacer;
+    pacer_init(&pacer, 50);
+    TEST_EQUAL(pacer_should_render(&pacer, 0, 0), 1, "Première image toujours dessinée");
+    pacer_rendered(&pacer, 0, 0);
+    TEST_EQUAL(pacer_should_render(&pacer, 0, 100), 0, "Rien de changé : pas d'image");
+    TEST_EQUAL(pacer_should_render(&pacer, 1, 10), 0, "Changement avant le plafond : reporté");
+    TEST_RANGE(pacer_wait_ms(&pacer, 1, 10, 200), 9.9, 10.1, "Attente jusqu'au rendu permis");
+    TEST_EQUAL(pacer_should_render(&pacer, 1, 20), 1, "Changement après le plafond : dessiné");
+    pacer_rendered(&pacer, 1, 20);
+    TEST_RANGE(pacer_wait_ms(&pacer, 1, 20, 70), 49.9, 50.1, "Sans image en attente : jusqu'au tick");
+    TEST_RANGE(pacer_wait_ms(&pacer, 1, 20, 1000), PACER_MAX_WAIT_MS, PACER_MAX_WAIT_MS, "Attente bornée");
+    TEST_RANGE(pacer_wait_ms(&pacer, 1, 90, 70), 0, 0, "Échéance passée : pas d'attente");
+    pacer_invalidate(&pacer);
+    TEST_EQUAL(pacer_should_render(&pacer, 1, 45), 1, "Invalidation : image refaite à clé égale");
+    TEST_EQUAL(pacer.skipped, 2, "Passages sans image comptés");
+
+    // Une partie au rythme facile (200 ms par tick) : une image par tick au
+    // lieu d'une par passage de 10 ms
+    pacer_init(&pacer, 0);
+    unsigned long key = 0;
+    for (int now = 0; now < 2000; now += 10) {
+        if (now % 200 == 0) key++;
+        if (pacer_should_render(&pacer, key, now)) pacer_rendered(&pacer, key, now);
+    }
+    TEST_EQUAL(pacer.presented, 10, "Une image par tick");
+}
+
+void test_font() {
+    printf("\n=== Test: police bitmap ===\n");
+    int bar = 0;
+    for (int y = 0; y < FONT_GLYPH_H; y++) bar += font_glyph_pixel('|', 2, y);
+    TEST_EQUAL(bar, FONT_GLYPH_H, "Barre verticale pleine");
+    TEST_EQUAL(font_glyph_pixel(' ', 2, 3), 0, "Espace vide");
+    TEST_EQUAL(font_glyph_pixel('A', FONT_GLYPH_W, 0), 0, "Hors du glyphe : vide");
+
+    // L'atlas contient exactement les pixels des glyphes, chacun dans sa cellule
+    static uint32_t atlas[FONT_ATLAS_W * FONT_ATLAS_H];
+    font_build_atlas(atlas, FONT_ATLAS_W, 1, 0);
+    long expected = 0, inked = 0;
+    int misplaced = 0;
+    for (int c = FONT_FIRST_CHAR; c < FONT_FIRST_CHAR + FONT_GLYPH_COUNT; c++) {
+        FontQuad q;
+        char text[2] = {(char)c, '\0'};
+        if (font_layout(text, 0, 0, 1, &q, 1) == 0) continue;
+        for (int y = 0; y < FONT_GLYPH_H; y++) {
+            for (int x = 0; x < FONT_GLYPH_W; x++) {
+                expected += font_glyph_pixel((unsigned char)c, x, y);
+                if (atlas[(q.v + y) * FONT_ATLAS_W + q.u + x] != (uint32_t)font_glyph_pixel((unsigned char)c, x, y)) {
+                    misplaced++;
+                }
+            }
+        }
+    }
+    for (int i = 0; i < FONT_ATLAS_W * FONT_ATLAS_H; i++) inked += atlas[i];
+    TEST_EQUAL(misplaced, 0, "Glyphes à leur place dans l'atlas");
+    TEST_EQUAL(inked, expected, "Rien d'autre dans l'atlas");
+
+    FontQuad quads[16];
+    int count = font_layout("Vies: 3", 10, 20, 2, quads, 16);
+    TEST_EQUAL(count, 6, "Un quad par caractère visible");
+    TEST_EQUAL(quads[5].x, 10 + 6 * FONT_CELL_W * 2, "Espace : avance sans quad");
+    TEST_EQUAL(quads[0].w, FONT_GLYPH_W * 2, "Quad à l'échelle");
+    FontQuad unknown, question;
+    font_layout("\x7f", 0, 0, 1, &unknown, 1);
+    font_layout("?", 0, 0, 1, &question, 1);
+    TEST_EQUAL(unknown.u == question.u && unknown.v == question.v, 1, "Caractère inconnu affiché en '?'");
+    TEST_EQUAL(font_layout("abcdef", 0, 0, 1, quads, 3), 3, "Mise en page bornée");
+    TEST_EQUAL(font_text_width("ab", 1), 2 * FONT_CELL_W - 1, "Largeur sans l'espacement final");
+}
+
+static uint32_t raster_pixel(const RasterImage *image, int x, int y) {
+    return image->pixels[y * image->width + x] & 0xFFFFFF;
+}
+
+void test_raster() {
+    printf("\n=== Test: rendu logiciel ===\n");
+    RasterImage image;
+    TEST_ASSERT(raster_init(&image, 10, 10), "Image créée");
+    raster_fill_rect(&image, -5, -5, 8, 8, 0xFFFFFFFFu);
+    raster_fill_rect(&image, 8, 8, 100, 100, 0xFFFFFFFFu);
+    long lit = 0;
+    for (int i = 0; i < 100; i++) lit += image.pixels[i] == 0xFFFFFFFFu;
+    TEST_EQUAL(lit, 9 + 4, "Rectangles découpés aux bords");
+    raster_free(&image);
+
+    Game game;
+    init_game_seeded(&game, MODE_CHALLENGE, DIFF_EASY, 0, 11);
+    Position wall = {game.snake1.body[0].x, game.snake1.body[0].y + 2};
+    tilemap_set_wall(&game.map, wall);
+    int cell = 10, width, height;
+    raster_game_size(game.grid_width, game.grid_height, cell, &width, &height);
+    TEST_EQUAL(width, game.grid_width * cell, "Largeur : la grille");
+    TEST_EQUAL(height, game.grid_height * cell + raster_hud_height(cell), "Hauteur : la grille et le HUD");
+
+    // Chaque niveau SIMD donne exactement la même image
+    RasterImage images[3];
+    int identical = 1;
+    RasterSimd best = raster_simd_available();
+    for (int level = RASTER_SCALAR; level <= RASTER_AVX2; level++) {
+        raster_set_simd((RasterSimd)level);
+        raster_init(&images[level], width, height);
+        raster_draw_game(&images[level], &game, cell);
+        if (memcmp(images[level].pixels, images[0].pixels, (size_t)width * height * 4) != 0) identical = 0;
+    }
+    raster_set_simd(best);
+    TEST_ASSERT(identical, "Image identique en scalaire, SSE2 et AVX2");
+
+    const RasterImage *img = &images[0];
+    Position head = game.snake1.body[0], tail = game.snake1.body[game.snake1.length - 1];
+    TEST_EQUAL(raster_pixel(img, head.x * cell + 5, head.y * cell + 5), 0x00FF00, "Tête verte");
+    TEST_EQUAL(raster_pixel(img, tail.x * cell + 5, tail.y * cell + 5), 0xFFFF00, "Corps jaune");
+    TEST_EQUAL(raster_pixel(img, wall.x * cell + 5, wall.y * cell + 5), 0xFFFFFF, "Mur blanc");
+    TEST_EQUAL(raster_pixel(img, width - 1, 1), 0x00FFFF, "Bordure cyan");
+    long hud = 0;
+    for (int y = game.grid_height * cell; y < height; y++) {
+        for (int x = 0; x < width; x++) hud += raster_pixel(img, x, y) != 0;
+    }
+    TEST_ASSERT(hud > 100, "Texte du HUD dessiné");
+
+    // PPM relu à l'identique, PNG de la taille attendue (blocs stockés)
+    char path[] = "/tmp/snake_raster_XXXXXX";
+    int fd = mkstemp(path);
+    TEST_ASSERT(fd >= 0, "Fichier temporaire");
+    close(fd);
+    TEST_ASSERT(raster_write_ppm(img, path), "PPM écrit");
+    FILE *f = fopen(path, "rb");
+    int w = 0, h = 0, max = 0;
+    int header = f && fscanf(f, "P6 %d %d %d", &w, &h, &max) == 3 && fgetc(f) == '\n';
+    int same = header && w == width && h == height && max == 255;
+    for (long i = 0; same && i < (long)w * h; i++) {
+        int r = fgetc(f), g = fgetc(f), b = fgetc(f);
+        same = ((uint32_t)r << 16 | (uint32_t)g << 8 | (uint32_t)b) == (img->pixels[i] & 0xFFFFFF);
+    }
+    if (f) fclose(f);
+    TEST_ASSERT(same, "PPM relu identique à l'image");
+    TEST_ASSERT(raster_write_png(img, path), "PNG écrit");
+    f = fopen(path, "rb");
+    unsigned char signature[8] = {0};
+    long size = -1;
+    if (f && fread(signature, 1, 8, f) == 8 && fseek(f, 0, SEEK_END) == 0) size = ftell(f);
+    if (f) fclose(f);
+    long raw = (long)height * (1 + width * 3);
+    long blocks = (raw + 65534) / 65535;
+    TEST_ASSERT(memcmp(signature, "\x89PNG\r\n\x1a\n", 8) == 0, "Signature PNG");
+    TEST_EQUAL(size, 8 + 25 + 12 + 2 + raw + 5 * blocks + 4 + 12, "PNG : IHDR, IDAT stocké, IEND");
+    remove(path);
+    for (int level = RASTER_SCALAR; level <= RASTER_AVX2; level++) raster_free(&images[level]);
+    free_game(&game);
+}
+
+void test_term() {
+    printf("\n=== Test: rendu terminal ANSI ===\n");
+    TermScreen screen;
+    TEST_ASSERT(term_init(&screen, 10, 3), "Écran créé");
+    TEST_EQUAL(term_render(&screen), 11, "Première image : effacement seul (écran vide)");
+    TEST_EQUAL(term_render(&screen), 0, "Rien de changé : aucun octet");
+
+    term_put(&screen, 3, 1, 'X', TERM_RED);
+    term_render(&screen);
+    TEST_ASSERT(screen.out_len == 12 && memcmp(screen.out, "\x1b[2;4H\x1b[31mX", 12) == 0,
+                "Une cellule : déplacement, couleur, caractère");
+    term_put(&screen, 4, 1, 'Y', TERM_RED);
+    term_put(&screen, 6, 1, 'Z', TERM_RED);
+    term_render(&screen);
+    TEST_ASSERT(screen.out_len == 6 && memcmp(screen.out, "Y\x1b[1CZ", 6) == 0,
+                "Curseur et style repris de l'image précédente, trou d'un autre style : \\e[1C");
+    term_text(&screen, 0, 2, "abc", TERM_GREEN);
+    term_render(&screen);
+    term_put(&screen, 0, 2, 'A', TERM_GREEN);
+    term_put(&screen, 2, 2, 'C', TERM_GREEN);
+    term_render(&screen);
+    TEST_ASSERT(screen.out_len == 9 && memcmp(screen.out, "\x1b[3;1HAbC", 9) == 0,
+                "Trou court du même style : réécrit");
+    term_put(&screen, 0, 2, 'A', TERM_GREEN | TERM_BOLD);
+    term_put(&screen, 1, 2, 'B', TERM_CYAN | TERM_BOLD);
+    term_render(&screen);
+    TEST_ASSERT(screen.out_len == 22 && memcmp(screen.out, "\x1b[3;1H\x1b[0;1;32mA\x1b[36mB", 22) == 0,
+                "Mêmes attributs : couleur seule");
+
+    // Un seul write() par image, aucun sans changement
+    int fds[2];
+    TEST_ASSERT(pipe(fds) == 0, "Tube créé");
+    term_put(&screen, 9, 0, '!', TERM_WHITE);
+    TEST_ASSERT(term_flush(&screen, fds[1]), "Image envoyée");
+    TEST_ASSERT(term_flush(&screen, fds[1]), "Image inchangée");
+    char buf[64];
+    ssize_t n = read(fds[0], buf, sizeof(buf));
+    TEST_EQUAL(screen.writes, 1, "Un write() pour deux images dont une inchangée");
+    TEST_EQUAL(n, (long)screen.bytes, "Octets comptés = octets lus");
+    close(fds[0]);
+    close(fds[1]);
+    term_invalidate(&screen);
+    TEST_ASSERT(term_render(&screen) > 11, "Après invalidation : tout est redessiné");
+    term_free(&screen);
+
+    Game game;
+    init_game_seeded(&game, MODE_CLASSIC, DIFF_MEDIUM, 0, 5);
+    TEST_ASSERT(term_init(&screen, game.grid_width + 2, game.grid_height + 2), "Écran de la partie");
+    term_draw_game(&screen, &game);
+    Position head = game.snake1.body[0];
+    TermCell cell = screen.cells[(head.y + 1) * screen.width + head.x + 1];
+    TEST_ASSERT(cell.ch == '@' && cell.style == TERM_GREEN, "Tête verte");
+    TEST_ASSERT(screen.cells[0].ch == '+' && screen.cells[0].style == TERM_CYAN, "Coin de la bordure");
+    TEST_ASSERT(screen.cells[2].ch == 'S' && screen.cells[3].ch == 'c', "HUD dans la bordure haute");
+    term_free(&screen);
+    free_game(&game);
+}
+
+// Joueur automatique des tests de rollback : garde sa direction, tourne
+// parfois au hasard et évite la case suivante si elle est occupée.
+static int test_cell_free(const Game *game, Position p) {
+    if (p.x < 0 || p.x >= game->grid_width || p.y < 0 || p.y >= game->grid_height) return 0;
+    const Snake *snakes[2] = {&game->snake1, &game->snake2};
+    for (int s = 0; s < 2; s++) {
+        for (int i = 0; i < snakes[s]->length; i++) {
+            if (snakes[s]->body[i].x == p.x && snakes[s]->body[i].y == p.y) return 0;
+        }
+    }
+    return 1;
+}
+
+static Direction test_bot(const Game *game, int player, unsigned int *rng) {
+    const Snake *snake = player ? &game->snake2 : &game->snake1;
+    Direction choice = snake->direction;
+    if (snake_rand(rng) % 10 == 0) choice = (Direction)((choice + (snake_rand(rng) % 2 ? 1 : 3)) % 4);
+    for (int k = 0; k < 4; k++) {
+        Direction d = (Direction)((choice + k) % 4);
+        if (d == (snake->direction + 2) % 4) continue;
+        Position next = snake->body[0];
+        switch (d) {
+            case UP: next.y--; break;
+            case RIGHT: next.x++; break;
+            case DOWN: next.y++; break;
+            case LEFT: next.x--; break;
+        }
+        if (test_cell_free(game, next)) return d;
+    }
+    return choice;
+}
+
+void test_core_determinism() {
+    printf("\n=== Test: simulation déterministe ===\n");
+    Game *a = malloc(sizeof(Game)), *b = malloc(sizeof(Game)), *snapshot = malloc(sizeof(Game));
+    init_game_seeded(a, MODE_ARCADE, DIFF_MEDIUM, 1, 1234);
+    init_game_seeded(b, MODE_ARCADE, DIFF_MEDIUM, 1, 1234);
+    TEST_EQUAL(game_hash(a), game_hash(b), "Même graine, même état initial");
+    // Nourriture juste devant le serpent 1 : la partie avance dès le début
+    a->foods[0].pos = b->foods[0].pos = (Position){a->snake1.body[0].x + 1, a->snake1.body[0].y};
+
+    unsigned int rng = 99;
+    unsigned char inputs[300][2];
+    int mismatches = 0;
+    for (int t = 0; t < 300; t++) {
+        inputs[t][0] = test_bot(a, 0, &rng);
+        inputs[t][1] = test_bot(a, 1, &rng);
+        if (t == 200) game_copy_state(snapshot, a);
+        rollback_step(a, inputs[t]);
+        rollback_step(b, inputs[t]);
+        if (game_hash(a) != game_hash(b)) mismatches++;
+    }
+    TEST_EQUAL(mismatches, 0, "Mêmes entrées : même empreinte à chaque tick");
+    TEST_ASSERT(a->food_eaten > 0, "La partie a avancé (nourriture mangée)");
+
+    // Instantané au tick 200, rejoué avec les mêmes entrées
+    unsigned long expected = game_hash(a);
+    game_copy_state(a, snapshot);
+    TEST_EQUAL(a->tick, 200, "Instantané restauré");
+    for (int t = 200; t < 300; t++) rollback_step(a, inputs[t]);
+    TEST_EQUAL(game_hash(a), expected, "Restauration puis re-simulation identique");
+
+    free_game(a);
+    free_game(b);
+    free(a);
+    free(b);
+    free(snapshot);
+}
+
+// Lien simulé entre deux pairs : retard aléatoire et pertes.
+typedef struct {
+    unsigned char data[ROLLBACK_MAX_PACKET];
+    int size;
+    int deliver_at;
+} TestPacket;
+
+typedef struct {
+    TestPacket packets[64];
+    int count;
+} TestLink;
+
+static void link_send(TestLink *link, const unsigned char *data, int size, int now,
+                      unsigned int *rng, int lossy) {
+    if (link->count == 64 || (lossy && snake_rand(rng) % 5 == 0)) return;
+    TestPacket *packet = &link->packets[link->count++];
+    memcpy(packet->data, data, size);
+    packet->size = size;
+    packet->deliver_at = now + (lossy ? (int)(snake_rand(rng) % 6) : 0);
+}
+
+static void link_deliver(TestLink *link, Rollback *to, int now) {
+    int kept = 0;
+    for (int i = 0; i < link->count; i++) {
+        if (link->packets[i].deliver_at <= now) {
+            rollback_decode(to, link->packets[i].data, link->packets[i].size);
+        } else {
+            link->packets[kept++] = link->packets[i];
+        }
+    }
+    link->count = kept;
+}
+
+void test_rollback_peers() {
+    printf("\n=== Test: rollback entre deux pairs ===\n");
+    Rollback *peers = malloc(2 * sizeof(Rollback));
+    Game *reference = malloc(sizeof(Game));
+    TEST_ASSERT(rollback_init(&peers[0], 0, MODE_ARCADE, DIFF_MEDIUM, 777, 1), "Pair 1");
+    TEST_ASSERT(rollback_init(&peers[1], 1, MODE_ARCADE, DIFF_MEDIUM, 777, 1), "Pair 2");
+    init_game_seeded(reference, MODE_ARCADE, DIFF_MEDIUM, 1, 777);
+
+    TestLink links[2] = {{.count = 0}, {.count = 0}};
+    unsigned int rng = 4242, bots[2] = {11, 22};
+    unsigned char packet[ROLLBACK_MAX_PACKET];
+    unsigned long checked = 0;
+    int mismatches = 0;
+    for (int now = 0; now < 2000; now++) {
+        int lossy = now < 1800;  // fin sans pertes : tout finit par être confirmé
+        for (int p = 0; p < 2; p++) {
+            rollback_local_input(&peers[p], test_bot(&peers[p].game, p, &bots[p]));
+            rollback_advance(&peers[p]);
+            int size = rollback_encode(&peers[p], packet, sizeof(packet));
+            link_send(&links[p], packet, size, now, &rng, lossy);
+        }
+        link_deliver(&links[0], &peers[1], now);
+        link_deliver(&links[1], &peers[0], now);
+
+        // Référence : les entrées définitives rejouées sans prédiction
+        unsigned long confirmed = rollback_confirmed(&peers[0]);
+        if (rollback_confirmed(&peers[1]) < confirmed) confirmed = rollback_confirmed(&peers[1]);
+        for (; checked < confirmed; checked++) {
+            unsigned char inputs[2] = {peers[0].inputs[0][checked % ROLLBACK_HISTORY],
+                                       peers[0].inputs[1][checked % ROLLBACK_HISTORY]};
+            rollback_step(reference, inputs);
+            unsigned long h0 = 0, h1 = 0;
+            if (!rollback_hash(&peers[0], checked, &h0) || !rollback_hash(&peers[1], checked, &h1) ||
+                h0 != game_hash(reference) || h1 != h0) {
+                mismatches++;
+            }
+        }
+    }
+    TEST_EQUAL(mismatches, 0, "Empreintes identiques aux deux pairs et à la référence");
+    TEST_ASSERT(checked > 1800, "Ticks confirmés et comparés");
+    TEST_ASSERT(peers[0].rollbacks > 0 && peers[1].rollbacks > 0, "Des prédictions ont été corrigées");
+    TEST_ASSERT(peers[0].max_depth < ROLLBACK_WINDOW, "Rollback borné par la fenêtre");
+    TEST_ASSERT(peers[0].hash_checks > 0 && peers[1].hash_checks > 0, "Empreintes échangées");
+    TEST_EQUAL(peers[0].desync_tick + peers[1].desync_tick, 0, "Aucune désynchronisation signalée");
+
+    // Une partie différente (autre graine) est refusée
+    Rollback *other = malloc(sizeof(Rollback));
+    rollback_init(other, 1, MODE_ARCADE, DIFF_MEDIUM, 778, 1);
+    int size = rollback_encode(&peers[0], packet, sizeof(packet));
+    TEST_EQUAL(rollback_decode(other, packet, size), 0, "Graine différente : paquet ignoré");
+    rollback_free(other);
+    free(other);
+
+    rollback_free(&peers[0]);
+    rollback_free(&peers[1]);
+    free_game(reference);
+    free(reference);
+    free(peers);
+}
+
+typedef struct {
+    ShmLink *link;
+    Game *game;
+    volatile int done;
+} ShmWriter;
+
+// Écrivain concurrent : publie des ticks en boucle pendant que le test lit.
+static void *shm_writer_thread(void *data) {
+    ShmWriter *writer = data;
+    for (int i = 0; i < 20000; i++) {
+        step_game(writer->game);
+        if (writer->game->game_over) writer->game->game_over = 0;
+        shm_publish(writer->link, writer->game);
+    }
+    writer->done = 1;
+    return NULL;
+}
+
+void test_shm_bot() {
+    printf("\n=== Test: interface mémoire partagée ===\n");
+    char name[64];
+    snprintf(name, sizeof(name), "snake_test_%d", (int)getpid());
+    ShmLink game_side, bot;
+    TEST_EQUAL(shm_attach(&bot, name), 0, "Pas de région avant sa création");
+    TEST_ASSERT(shm_create(&game_side, name, 1), "Création de la région");
+    TEST_ASSERT(shm_attach(&bot, name), "Le bot s'attache");
+
+    Game *game = malloc(sizeof(Game));
+    ShmState *state = malloc(sizeof(ShmState));
+    init_game_seeded(game, MODE_FREE, DIFF_MEDIUM, 0, 31);
+    step_game(game);
+    shm_publish(&game_side, game);
+    shm_read(&bot, state);
+    TEST_EQUAL(state->tick, 1, "Tick publié");
+    TEST_EQUAL(state->snakes[0].length, 3, "Longueur publiée");
+    TEST_EQUAL(state->snakes[0].body[0].x, game->snake1.body[0].x, "Tête publiée");
+    Position head = game->snake1.body[0], food = game->foods[0].pos;
+    TEST_EQUAL(state->cells[head.y * state->width + head.x], SHM_CELL_SNAKE1, "Case de la tête");
+    TEST_EQUAL(state->cells[food.y * state->width + food.x], SHM_CELL_FOOD, "Case de la nourriture");
+
+    // Commande du bot : appliquée une seule fois, au tick suivant
+    shm_send(&bot, 0, state->tick, UP);
+    shm_apply_commands(&game_side, game);
+    TEST_EQUAL(game->snake1.turn_count, 1, "Virage du bot mis en file");
+    shm_apply_commands(&game_side, game);
+    TEST_EQUAL(game->snake1.turn_count, 1, "Même commande : pas de second virage");
+    step_game(game);
+    TEST_EQUAL(game->snake1.direction, UP, "Direction du bot exécutée");
+    TEST_EQUAL(game_side.late, 0, "Réponse à temps");
+
+    // Lectures pendant des écritures concurrentes : jamais d'état déchiré
+    ShmWriter writer = {&game_side, game, 0};
+    pthread_t thread;
+    pthread_create(&thread, NULL, shm_writer_thread, &writer);
+    long reads = 0, torn = 0;
+    while (!writer.done) {
+        shm_read(&bot, state);
+        for (uint32_t i = 0; i < state->snakes[0].length; i++) {
+            ShmPos p = state->snakes[0].body[i];
+            if (state->cells[p.y * state->width + p.x] != SHM_CELL_SNAKE1) torn++;
+        }
+        reads++;
+    }
+    pthread_join(thread, NULL);
+    TEST_ASSERT(reads > 0, "Lectures concurrentes effectuées");
+    TEST_EQUAL(torn, 0, "Aucune lecture incohérente");
+    TEST_EQUAL(atomic_load(&game_side.region->seq) % 2, 0, "Séquence paire au repos");
+
+    shm_close(&bot);
+    shm_close(&game_side);
+    TEST_EQUAL(shm_attach(&bot, name), 0, "Région supprimée à la fermeture");
+    free_game(game);
+    free(game);
+    free(state);
+}
+
+typedef struct {
+    BotPipe *bp;
+    int in_fd;
+    int out_fd;
+    int status;
+} BotPipeThread;
+
+static void *botpipe_thread(void *data) {
+    BotPipeThread *job = data;
+    job->status = botpipe_run(job->bp, job->in_fd, job->out_fd);
+    close(job->out_fd);
+    return NULL;
+}
+
+static int read_exact(int fd, unsigned char *buffer, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = read(fd, buffer + done, size - done);
+        if (n <= 0) return 0;
+        done += (size_t)n;
+    }
+    return 1;
+}
+
+void test_botpipe() {
+    printf("\n=== Test: protocole --bot-pipe ===\n");
+    BotPipeParams params;
+    botpipe_default_params(&params);
+    params.envs = 3;
+    params.batch = 4;
+    params.seed = 50;
+    params.max_steps = 40;
+    BotPipe bp;
+    TEST_ASSERT(botpipe_init(&bp, &params), "Initialisation");
+    int to_game[2], to_bot[2];
+    TEST_ASSERT(pipe(to_game) == 0 && pipe(to_bot) == 0, "Tubes");
+    BotPipeThread job = {&bp, to_game[0], to_bot[1], 0};
+    pthread_t thread;
+    pthread_create(&thread, NULL, botpipe_thread, &job);
+
+    unsigned char header[BOTPIPE_HEADER_SIZE];
+    TEST_ASSERT(read_exact(to_bot[0], header, sizeof(header)), "En-tête reçu");
+    TEST_EQUAL(header[0] | header[1] << 8 | header[2] << 16 | (unsigned long)header[3] << 24, BOTPIPE_MAGIC, "Nombre magique");
+    TEST_EQUAL(header[6], BOTPIPE_OBS_SIZE, "Taille d'observation annoncée");
+    TEST_EQUAL(header[8], 3, "Environnements annoncés");
+    TEST_EQUAL(header[12] * 100 + header[13], GRID_WIDTH * 100 + GRID_HEIGHT, "Grille annoncée");
+
+    // Référence : les mêmes parties jouées directement avec le noyau
+    Game *reference = malloc(3 * sizeof(Game));
+    unsigned long episodes[3] = {0, 0, 0};
+    for (int i = 0; i < 3; i++) init_game_seeded(&reference[i], MODE_CLASSIC, DIFF_MEDIUM, 0, 50 + i);
+    unsigned char actions[12], obs[12 * BOTPIPE_OBS_SIZE], expected[BOTPIPE_OBS_SIZE];
+    unsigned int rng = 8;
+    int mismatches = 0, dones = 0, truncated = 0;
+    for (int message = 0; message < 50; message++) {
+        for (int j = 0; j < 12; j++) actions[j] = (unsigned char)(snake_rand(&rng) % 6);
+        if (write(to_game[1], actions, sizeof(actions)) != (ssize_t)sizeof(actions)) break;
+        if (!read_exact(to_bot[0], obs, sizeof(obs))) break;
+        for (int k = 0; k < 4; k++) {
+            for (int i = 0; i < 3; i++) {
+                Game *game = &reference[i];
+                unsigned char action = actions[k * 3 + i];
+                if (action < BOTPIPE_KEEP) {
+                    game->snake1.turn_count = 0;
+                    queue_turn(&game->snake1, (Direction)action, 0);
+                }
+                int before = game->score;
+                step_game(game);
+                int flags = game->game_over ? BOTPIPE_FLAG_DONE
+                          : game->tick >= 40 ? BOTPIPE_FLAG_DONE | BOTPIPE_FLAG_TRUNCATED : 0;
+                int reward = game->score - before;
+                if (flags) {
+                    episodes[i]++;
+                    reset_game(game, 50 + episodes[i] * 3 + i);
+                }
+                botpipe_observe(game, reward, flags, episodes[i], expected);
+                const unsigned char *got = obs + (k * 3 + i) * BOTPIPE_OBS_SIZE;
+                if (memcmp(got, expected, BOTPIPE_OBS_SIZE) != 0) mismatches++;
+                if (got[7] & BOTPIPE_FLAG_DONE) dones++;
+                if (got[7] & BOTPIPE_FLAG_TRUNCATED) truncated++;
+            }
+        }
+    }
+    TEST_EQUAL(mismatches, 0, "Observations identiques à la simulation directe");
+    TEST_ASSERT(dones > 0 && truncated > 0, "Fins d'épisode et troncatures signalées");
+    TEST_EQUAL(bp.steps, 600, "600 pas joués");
+
+    close(to_game[1]);
+    pthread_join(thread, NULL);
+    TEST_EQUAL(job.status, 1, "Fin de stdin : sortie normale");
+    close(to_game[0]);
+    close(to_bot[0]);
+    for (int i = 0; i < 3; i++) free_game(&reference[i]);
+    free(reference);
+    botpipe_free(&bp);
+}
+
+void test_vec_env() {
+    printf("\n=== Test: environnement vectorisé ===\n");
+    VecEnv env;
+    TEST_ASSERT(vec_env_init(&env, 4, MODE_CHALLENGE, DIFF_MEDIUM, 30), "Initialisation");
+    int n, height, width;
+    vec_env_shape(&env, &n, &height, &width);
+    TEST_EQUAL(n * 10000 + height * 100 + width, 4 * 10000 + GRID_HEIGHT * 100 + GRID_WIDTH, "Forme [N][H][L]");
+
+    size_t cells = (size_t)width * height;
+    unsigned char *obs = malloc(4 * cells);
+    unsigned int seeds[4] = {70, 71, 72, 73};
+    vec_env_reset(&env, seeds, obs);
+    int heads = 0, walls = 0;
+    for (int i = 0; i < 4; i++) {
+        Position head = env.games[i].snake1.body[0];
+        if (obs[i * cells + head.y * width + head.x] == VEC_CELL_HEAD) heads++;
+        for (size_t c = 0; c < cells; c++) walls += obs[i * cells + c] == VEC_CELL_WALL;
+    }
+    TEST_EQUAL(heads, 4, "Tête à sa place dans chaque observation");
+    TEST_ASSERT(walls > 0, "Obstacles du mode défi dans la couche statique");
+
+    // Référence : mêmes graines, mêmes actions, noyau seul
+    Game *reference = malloc(4 * sizeof(Game));
+    unsigned long episodes[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++) init_game_seeded(&reference[i], MODE_CHALLENGE, DIFF_MEDIUM, 0, seeds[i]);
+    unsigned char actions[4], dones[4];
+    float rewards[4];
+    unsigned char *expected = malloc(cells);
+    unsigned int rng = 3;
+    int mismatches = 0, done_count = 0, truncated = 0;
+    for (int step = 0; step < 200; step++) {
+        for (int i = 0; i < 4; i++) actions[i] = (unsigned char)(snake_rand(&rng) % 6);
+        vec_env_step(&env, actions, obs, rewards, dones);
+        for (int i = 0; i < 4; i++) {
+            Game *game = &reference[i];
+            if (actions[i] < VEC_ENV_KEEP) {
+                game->snake1.turn_count = 0;
+                queue_turn(&game->snake1, (Direction)actions[i], 0);
+            }
+            int before = game->score;
+            step_game(game);
+            int reward = game->score - before;
+            int done = game->game_over || game->tick >= 30;
+            if (done) {
+                episodes[i]++;
+                reset_game(game, seeds[i] + episodes[i] * 4);
+            }
+            if (game_hash(game) != game_hash(&env.games[i]) || rewards[i] != (float)reward ||
+                (dones[i] & VEC_ENV_DONE) != done) mismatches++;
+            done_count += dones[i] & VEC_ENV_DONE;
+            truncated += (dones[i] & VEC_ENV_TRUNCATED) != 0;
+        }
+    }
+    TEST_EQUAL(mismatches, 0, "Parties, récompenses et fins identiques à la simulation directe");
+    TEST_ASSERT(done_count > 0 && truncated > 0, "Remise à zéro automatique des parties finies");
+
+    // L'observation d'une partie remise à zéro est celle du nouvel épisode
+    vec_env_observe(&env, 2, expected);
+    TEST_ASSERT(memcmp(expected, obs + 2 * cells, cells) == 0, "Observation écrite dans le tampon de l'appelant");
+    TEST_EQUAL(env.steps, 800, "800 pas joués");
+
+    // Sorties facultatives
+    vec_env_step(&env, actions, NULL, NULL, NULL);
+    TEST_EQUAL(env.steps, 804, "Pas sans sorties");
+
+    for (int i = 0; i < 4; i++) free_game(&reference[i]);
+    free(reference);
+    free(expected);
+    free(obs);
+    vec_env_free(&env);
+}
+
+void test_features() {
+    printf("\n=== Test: plans de caractéristiques ===\n");
+    Game *games = malloc(3 * sizeof(Game));
+    for (int i = 0; i < 3; i++) init_game_seeded(&games[i], MODE_CHALLENGE, DIFF_HARD, 0, 90 + i);
+    // Un portail, de la nourriture de chaque type et un power-up
+    Position portal, far_portal;
+    do portal = generate_random_position(&games[0]); while (!is_position_valid(&games[0], portal, 1));
+    TEST_ASSERT(tilemap_add_portal(&games[0].map, portal, (Position){1, 1}) >= 0, "Portail ajouté");
+    // Identifiant au-delà de 32767 (les comparaisons SIMD sont signées)
+    do far_portal = generate_random_position(&games[0]); while (!is_position_valid(&games[0], far_portal, 1));
+    games[0].map.tiles[far_portal.y * games[0].grid_width + far_portal.x] = 0xFFF0;
+    for (int i = 0; i < games[1].food_count; i++) games[1].foods[i].type = (FoodType)(i % 5);
+    generate_powerup(&games[2]);
+    games[2].powerup.active = 1;
+    for (int t = 0; t < 20; t++) step_game(&games[1]);
+
+    size_t size = features_size(&games[0]);
+    size_t cells = (size_t)games[0].grid_width * games[0].grid_height;
+    TEST_EQUAL(size, FEATURE_PLANES * cells, "Taille d'un tenseur [C][H][W]");
+    unsigned char *u8 = malloc(3 * size), *u8_ref = malloc(3 * size);
+    float *f32 = malloc(3 * size * sizeof(float)), *f32_ref = malloc(3 * size * sizeof(float));
+    for (int i = 0; i < 3; i++) {
+        features_encode_naive_u8(&games[i], u8_ref + i * size);
+        features_encode_naive_f32(&games[i], f32_ref + i * size);
+    }
+
+    // Contenu de la référence
+    const Game *game = &games[1];
+    int heads = 0, foods = 0, walls = 0, max_age = 0;
+    for (size_t c = 0; c < cells; c++) {
+        heads += u8_ref[size + FEATURE_HEAD * cells + c];
+        for (int f = 0; f < 5; f++) foods += u8_ref[size + (FEATURE_FOOD + f) * cells + c];
+        walls += u8_ref[size + FEATURE_WALL * cells + c];
+        if (u8_ref[size + FEATURE_BODY * cells + c] > max_age) max_age = u8_ref[size + FEATURE_BODY * cells + c];
+    }
+    TEST_EQUAL(heads, 1, "Une tête");
+    TEST_EQUAL(foods, game->food_count, "Nourritures réparties par type");
+    TEST_EQUAL(walls, game->map.wall_count, "Murs de la couche de tuiles");
+    TEST_EQUAL(max_age, game->snake1.length - 1, "Âge du segment suivant la tête");
+    TEST_EQUAL(u8_ref[FEATURE_PORTAL * cells + portal.y * games[0].grid_width + portal.x], 1, "Entrée de portail");
+    TEST_EQUAL(u8_ref[FEATURE_PORTAL * cells + far_portal.y * games[0].grid_width + far_portal.x], 1, "Portail d'identifiant élevé");
+    Position pw = games[2].powerup.pos;
+    TEST_EQUAL(f32_ref[2 * size + FEATURE_POWERUP * cells + pw.y * games[2].grid_width + pw.x], 1.0f, "Power-up (float)");
+
+    // Chaque jeu d'instructions disponible donne exactement la référence
+    FeaturesSimd best = features_simd_available();
+    int mismatches = 0;
+    for (int level = FEATURES_SCALAR; level <= (int)best; level++) {
+        features_set_simd((FeaturesSimd)level);
+        memset(u8, 0xAA, 3 * size);
+        memset(f32, 0xAA, 3 * size * sizeof(float));
+        features_encode_batch_u8(games, 3, u8);
+        features_encode_batch_f32(games, 3, f32);
+        if (memcmp(u8, u8_ref, 3 * size) != 0) mismatches++;
+        if (memcmp(f32, f32_ref, 3 * size * sizeof(float)) != 0) mismatches++;
+    }
+    features_set_simd(best);
+    TEST_EQUAL(mismatches, 0, "Encodeurs scalaire et SIMD identiques à la référence");
+
+    for (int i = 0; i < 3; i++) free_game(&games[i]);
+    free(games);
+    free(u8);
+    free(u8_ref);
+    free(f32);
+    free(f32_ref);
+}
+
+void test_grid_kernels() {
+    printf("\n=== Test: noyaux par taille de grille ===\n");
+    TEST_ASSERT(grid_kernel_find(GRID_WIDTH, GRID_HEIGHT) != NULL, "Noyau pour la grille moyenne");
+    TEST_ASSERT(grid_kernel_find(61, 20) == NULL, "Pas de noyau pour une taille libre");
+
+    // Même graine, mêmes virages : noyau spécialisé et noyau générique
+    // doivent produire les mêmes parties, tick par tick.
+    Game *games = malloc(2 * sizeof(Game));
+    int mismatches = 0, missing = 0, games_over = 0;
+    for (int diff = DIFF_EASY; diff <= DIFF_EXTREME; diff++) {
+        for (int mode = MODE_CLASSIC; mode <= MODE_FREE; mode++) {
+            for (int g = 0; g < 2; g++) init_game_seeded(&games[g], (GameMode)mode, (Difficulty)diff, 1, 300 + diff * 4 + mode);
+            if (!games[0].kernel) missing++;
+            games[1].kernel = NULL;
+            unsigned int rng = 17;
+            for (int t = 0; t < 1500; t++) {
+                for (int p = 0; p < 2; p++) {
+                    unsigned int r = snake_rand(&rng);
+                    if (r % 5 == 0) {
+                        for (int g = 0; g < 2; g++) {
+                            Snake *snake = p ? &games[g].snake2 : &games[g].snake1;
+                            queue_turn(snake, (Direction)(r / 5 % 4), 0);
+                        }
+                    }
+                }
+                for (int g = 0; g < 2; g++) step_game(&games[g]);
+                if (game_hash(&games[0]) != game_hash(&games[1])) mismatches++;
+                if (games[0].game_over) {
+                    games_over++;
+                    for (int g = 0; g < 2; g++) reset_game(&games[g], 400 + t);
+                }
+            }
+            for (int g = 0; g < 2; g++) free_game(&games[g]);
+        }
+    }
+    TEST_EQUAL(missing, 0, "Noyau spécialisé pour les quatre difficultés");
+    TEST_EQUAL(mismatches, 0, "Parties identiques avec le noyau générique");
+    TEST_ASSERT(games_over > 0, "Fins de partie rencontrées");
+    free(games);
+}
+
+// Remplissage de référence, case par case (parcours en largeur)
+static long reference_flood(const Bitboard *passable, Position start, Bitboard *out) {
+    int width = passable->width, height = passable->height;
+    Position *queue = malloc((size_t)width * height * sizeof(Position));
+    bitboard_init(out, width, height);
+    long head = 0, tail = 0;
+    if (bitboard_get(passable, start)) {
+        bitboard_set(out, start);
+        queue[tail++] = start;
+    }
+    static const int dx[4] = {0, 1, 0, -1}, dy[4] = {-1, 0, 1, 0};
+    while (head < tail) {
+        Position p = queue[head++];
+        for (int d = 0; d < 4; d++) {
+            Position n = {p.x + dx[d], p.y + dy[d]};
+            if (!bitboard_get(passable, n) || bitboard_get(out, n)) continue;
+            bitboard_set(out, n);
+            queue[tail++] = n;
+        }
+    }
+    free(queue);
+    return tail;
+}
+
+void test_bitboard() {
+    printf("\n=== Test: bitboards ===\n");
+    Bitboard bb, other;
+    TEST_ASSERT(!bitboard_init(&bb, 129, 10) && !bitboard_init(&bb, 60, 65), "Grille trop grande refusée");
+    TEST_ASSERT(bitboard_init(&bb, 80, 30), "Grille 80x30");
+    bitboard_fill(&bb);
+    TEST_EQUAL(bitboard_count(&bb), 80 * 30, "Masque de 80 colonnes sur deux mots");
+    TEST_ASSERT(!bitboard_get(&bb, (Position){80, 0}) && !bitboard_get(&bb, (Position){-1, 0}), "Hors grille");
+
+    bitboard_init(&bb, 128, 4);
+    bitboard_set(&bb, (Position){63, 1});
+    bitboard_neighbors(&other, &bb);
+    TEST_EQUAL(bitboard_count(&other), 4, "Quatre voisines");
+    TEST_ASSERT(bitboard_get(&other, (Position){64, 1}) && bitboard_get(&other, (Position){62, 1}),
+                "Voisines à cheval sur les deux mots");
+    bitboard_set(&bb, (Position){127, 3});
+    Position pos;
+    TEST_ASSERT(bitboard_nth(&bb, 1, &pos) && pos.x == 127 && pos.y == 3, "n-ième case");
+    TEST_ASSERT(!bitboard_nth(&bb, 2, &pos), "Au-delà du nombre de cases");
+
+    // Remplissage comparé au parcours case par case sur des grilles au hasard
+    static const int sizes[][2] = {{80, 30}, {60, 20}, {100, 12}, {128, 64}, {7, 5}};
+    unsigned int rng = 21;
+    int mismatches = 0;
+    for (int k = 0; k < 40; k++) {
+        int width = sizes[k % 5][0], height = sizes[k % 5][1];
+        Bitboard passable, flood, expected;
+        bitboard_init(&passable, width, height);
+        int density = 45 + k % 4 * 10;
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                if ((int)(snake_rand(&rng) % 100) < density) bitboard_set(&passable, (Position){x, y});
+            }
+        }
+        Position start = {snake_rand(&rng) % width, snake_rand(&rng) % height};
+        bitboard_init(&flood, width, height);
+        bitboard_set(&flood, start);
+        long area = bitboard_flood(&flood, &flood, &passable);
+        long expected_area = reference_flood(&passable, start, &expected);
+        bitboard_andnot(&expected, &expected, &flood);
+        if (area != expected_area || bitboard_count(&expected) != 0) mismatches++;
+    }
+    TEST_EQUAL(mismatches, 0, "Remplissage identique au parcours case par case");
+
+    // Composantes : même rapport que l'union-find par segments
+    int differences = 0;
+    for (int k = 0; k < 30; k++) {
+        TileMap map;
+        tilemap_init(&map, sizes[k % 4][0], sizes[k % 4][1]);
+        for (long i = 0; i < (long)map.width * map.height * (k % 5) / 10; i++) {
+            tilemap_set_wall(&map, (Position){snake_rand(&rng) % map.width, snake_rand(&rng) % map.height});
+        }
+        MapReport runs;
+        mapgen_check(&map, &runs);
+        Bitboard walls, free_cells;
+        bitboard_from_map(&walls, NULL, &map);
+        bitboard_init(&free_cells, map.width, map.height);
+        bitboard_fill(&free_cells);
+        bitboard_andnot(&free_cells, &free_cells, &walls);
+        long largest;
+        int components = bitboard_components(&free_cells, &largest);
+        if (components != runs.components || bitboard_count(&free_cells) != runs.free_cells ||
+            largest != runs.largest) differences++;
+        tilemap_free(&map);
+    }
+    TEST_EQUAL(differences, 0, "Vérification de connexité identique à l'union-find");
+
+    // Cases libres d'une partie : exactement celles qu'accepte is_position_valid
+    Game game;
+    init_game_seeded(&game, MODE_CHALLENGE, DIFF_EASY, 1, 33);
+    for (int t = 0; t < 40; t++) step_game(&game);
+    Bitboard free_cells;
+    TEST_ASSERT(bitboard_game_free(&game, &free_cells), "Cases libres de la partie");
+    int disagree = 0;
+    for (int y = 0; y < game.grid_height; y++) {
+        for (int x = 0; x < game.grid_width; x++) {
+            Position p = {x, y};
+            if (bitboard_get(&free_cells, p) != is_position_valid(&game, p, 1)) disagree++;
+        }
+    }
+    TEST_EQUAL(disagree, 0, "Cases libres = is_position_valid");
+    Bitboard passable;
+    bitboard_game_passable(&game, &passable);
+    TEST_EQUAL(bitboard_game_area(&game, &passable, game.snake1.body[1]), 0, "Aucune région depuis le corps");
+    free_game(&game);
+}
+
+void test_policy() {
+    printf("\n=== Test: joueurs automatiques ===\n");
+    int names_ok = 1;
+    for (int k = 0; k < POLICY_COUNT; k++) names_ok &= policy_parse(policy_name((PolicyKind)k)) == k;
+    TEST_ASSERT(names_ok, "Noms des politiques");
+    TEST_EQUAL(policy_parse("astar"), -1, "Nom inconnu refusé");
+
+    Game *game = malloc(sizeof(Game));
+    init_game_seeded(game, MODE_CLASSIC, DIFF_MEDIUM, 0, 5);
+    tilemap_clear(&game->map);
+    game->obstacle_count = 0;
+    // Tête contre le bord droit, en direction du mur
+    Snake *snake = &game->snake1;
+    snake->length = 3;
+    for (int i = 0; i < 3; i++) snake->body[i] = (Position){game->grid_width - 1 - i, 10};
+    snake->direction = RIGHT;
+    unsigned int rng = 1;
+    TEST_EQUAL(policy_direction(POLICY_STRAIGHT, game, 0, &rng), RIGHT, "straight garde sa direction");
+    int into_wall = 0;
+    for (int k = 0; k < 50; k++) {
+        into_wall += policy_direction(POLICY_FLOOD, game, 0, &rng) == RIGHT;
+        into_wall += policy_direction(POLICY_GREEDY, game, 0, &rng) == RIGHT;
+    }
+    TEST_EQUAL(into_wall, 0, "flood et greedy évitent le mur");
+
+    for (int i = 0; i < 3; i++) snake->body[i] = (Position){10 - i, 10};
+    game->food_count = 1;
+    game->foods[0].pos = (Position){10, 3};
+    game->foods[0].type = FOOD_NORMAL;
+    TEST_EQUAL(policy_direction(POLICY_GREEDY, game, 0, &rng), UP, "greedy va vers le repas");
+    game->foods[0].type = FOOD_POISON;
+    unsigned int copy = rng;
+    Direction first = policy_direction(POLICY_GREEDY, game, 0, &rng);
+    TEST_EQUAL(policy_direction(POLICY_GREEDY, game, 0, &copy), first, "Même générateur, même direction");
+
+    free_game(game);
+
+    // Partie complète : greedy mange et deux passes donnent la même empreinte
+    unsigned long hashes[2];
+    int eaten = 0;
+    for (int run = 0; run < 2; run++) {
+        init_game_seeded(game, MODE_ARCADE, DIFF_HARD, 0, 77);
+        rng = 3;
+        for (int t = 0; t < 2000 && !game->game_over; t++) {
+            queue_turn(&game->snake1, policy_direction(POLICY_GREEDY, game, 0, &rng), 0);
+            step_game(game);
+        }
+        hashes[run] = game_hash(game);
+        eaten = game->food_eaten;
+        free_game(game);
+    }
+    TEST_ASSERT(eaten >= 5, "greedy mange");
+    TEST_EQUAL(hashes[0], hashes[1], "Partie reproductible");
+    free(game);
+}
+
+static void count_session(const SessionRecord *record, void *context) {
+    (void)record;
+    (*(int *)context)++;
+}
+
+void test_session_log() {
+    printf("\n=== Test: journal des parties ===\n");
+    char path[64], index_path[80];
+    snprintf(path, sizeof(path), "/tmp/snake_sessions_%d", (int)getpid());
+    snprintf(index_path, sizeof(index_path), "%s.idx", path);
+    unlink(path);
+    unlink(index_path);
+    TEST_EQUAL((int)sizeof(SessionRecord), 48, "Enregistrement de 48 octets");
+
+    // 1000 parties : 3 blocs complets et un bloc incomplet, un mode par
+    // tranche de 300 et des dates croissantes
+    Game *game = malloc(sizeof(Game));
+    init_game_seeded(game, MODE_ARCADE, DIFF_HARD, 0, 3);
+    SessionLog log;
+    TEST_ASSERT(session_log_open(&log, path, 128), "Journal créé");
+    SessionRecord record;
+    int appended = 1;
+    for (int i = 0; i < 1000; i++) {
+        session_record_fill(&record, game, (unsigned int)i, 0);
+        record.mode = (uint8_t)(i / 300);
+        record.end_time = 1000000 + i;
+        record.score = i;
+        appended &= session_log_append(&log, &record);
+    }
+    TEST_ASSERT(appended && session_log_close(&log), "Ajouts et fermeture");
+    TEST_EQUAL((int)log.written, 1000, "1000 enregistrements écrits");
+    TEST_EQUAL((int)log.syncs, 8, "fdatasync tous les 128, plus la fermeture");
+
+    SessionMap map;
+    TEST_ASSERT(session_map_open(&map, path), "Journal projeté");
+    TEST_EQUAL((int)map.count, 1000, "1000 parties lues");
+    TEST_ASSERT(map.records[999].score == 999 && map.records[0].difficulty == DIFF_HARD, "Contenu relu");
+    SessionIndex index;
+    TEST_ASSERT(session_index_open(&index, index_path, &map) && index.saved, "Index écrit");
+    TEST_EQUAL((int)index.count, 3, "Trois blocs complets");
+
+    // Mode challenge (parties 600..899) après la partie 700
+    SessionQuery query = {MODE_CHALLENGE, DIFF_HARD, 1000000 + 700, 0};
+    SessionScan scan, full;
+    int visited = 0;
+    size_t matched = session_query(&map, &index, &query, count_session, &visited, &scan);
+    size_t expected = session_query(&map, NULL, &query, NULL, NULL, &full);
+    TEST_EQUAL((int)matched, 200, "Parties retenues");
+    TEST_ASSERT(visited == 200 && expected == matched, "Même résultat sans index");
+    TEST_EQUAL((int)scan.blocks_skipped, 2, "Blocs écartés par l'index");
+    TEST_ASSERT(scan.records_read < full.records_read, "Moins d'enregistrements lus");
+    query.difficulty = DIFF_EASY;
+    TEST_EQUAL((int)session_query(&map, &index, &query, NULL, NULL, &scan), 0, "Aucune partie en facile");
+    TEST_EQUAL((int)scan.blocks_read, 1, "Seul le bloc incomplet est lu");
+    session_index_free(&index);
+    session_map_close(&map);
+
+    // Écriture interrompue : l'enregistrement tronqué est ignoré ; un
+    // journal rouvert reprend à la suite et l'index est complété
+    int fd = open(path, O_WRONLY | O_APPEND);
+    TEST_ASSERT(fd >= 0 && write(fd, &record, 20) == 20, "Enregistrement tronqué");
+    if (fd >= 0) close(fd);
+    TEST_ASSERT(session_map_open(&map, path) && map.count == 1000, "Fin tronquée ignorée");
+    session_map_close(&map);
+    TEST_ASSERT(session_log_open(&log, path, 0), "Journal rouvert");
+    for (int i = 0; i < 300; i++) session_log_append(&log, &record);
+    session_log_close(&log);
+    TEST_ASSERT(session_map_open(&map, path) && session_index_open(&index, index_path, &map), "Relecture");
+    TEST_EQUAL((int)map.count, 1300, "1300 parties (sans la fin tronquée)");
+    TEST_ASSERT(memcmp(&map.records[1299], &record, sizeof(record)) == 0, "Ajouts alignés après réparation");
+    TEST_EQUAL((int)index.count, 5, "Index complété");
+    session_index_free(&index);
+    session_map_close(&map);
+
+    TEST_ASSERT(session_log_game(path, game, 3, SESSION_HEADLESS), "Une partie, un enregistrement");
+
+    // Plusieurs processus : deux écrivent par lots de 64 (3072 octets par
+    // write), deux ouvrent le journal en boucle (réparation de la fin) et y
+    // ajoutent une partie de temps en temps. Rien n'est coupé ni décalé.
+    unlink(path);
+    session_record_fill(&record, game, 4242, 0);
+    pid_t pids[4];
+    for (int w = 0; w < 4; w++) {
+        pids[w] = fork();
+        if (pids[w] != 0) continue;
+        int ok = 1;
+        if (w < 2) {
+            ok = session_log_open(&log, path, 0);
+            for (int i = 0; i < 64 * 40; i++) ok &= session_log_append(&log, &record);
+            ok &= session_log_close(&log);
+        } else {
+            for (int i = 0; i < 400; i++) {
+                ok &= session_log_open(&log, path, 0);
+                if (i % 8 == 0) ok &= session_log_append(&log, &record);
+                ok &= session_log_close(&log);
+            }
+        }
+        _exit(ok ? 0 : 1);
+    }
+    int children_ok = 1;
+    for (int w = 0; w < 4; w++) {
+        int status = 0;
+        children_ok &= pids[w] > 0 && waitpid(pids[w], &status, 0) == pids[w] && WIFEXITED(status) &&
+                       WEXITSTATUS(status) == 0;
+    }
+    TEST_ASSERT(children_ok, "Écritures concurrentes réussies");
+    int intact = session_map_open(&map, path) && map.count == 2 * 64 * 40 + 2 * 50;
+    for (size_t i = 0; intact && i < map.count; i++) intact = memcmp(&map.records[i], &record, sizeof(record)) == 0;
+    TEST_ASSERT(intact, "Aucun enregistrement coupé ni décalé");
+    session_map_close(&map);
+    free_game(game);
+    free(game);
+    unlink(path);
+    unlink(index_path);
+}
+
+// Classement de référence : tableau trié, insertion par décalage
+static int reference_insert(int *scores, int *count, int capacity, int score) {
+    int pos = 0;
+    while (pos < *count && scores[pos] >= score) pos++;
+    if (pos >= capacity) return 0;
+    if (*count < capacity) (*count)++;
+    memmove(scores + pos + 1, scores + pos, (size_t)(*count - 1 - pos) * sizeof(int));
+    scores[pos] = score;
+    return pos + 1;
+}
+
+static int leaderboard_matches(const Leaderboard *board, const int *scores, int count) {
+    if (leaderboard_count(board) != count) return 0;
+    LeaderEntry entry;
+    for (int i = 0; i < count; i++) {
+        if (!leaderboard_entry(board, i + 1, &entry) || entry.score != scores[i]) return 0;
+    }
+    for (int score = -1; score <= 1001; score += 7) {
+        int rank = 1;
+        while (rank <= count && scores[rank - 1] >= score) rank++;
+        if (leaderboard_rank(board, score) != rank) return 0;
+    }
+    return 1;
+}
+
+void test_leaderboard() {
+    printf("\n=== Test: classements ===\n");
+    char dir[64], path[96];
+    snprintf(dir, sizeof(dir), "/tmp/snake_leaderboards_%d", (int)getpid());
+    leaderboard_path(path, sizeof(path), dir, MODE_ARCADE, DIFF_HARD, 2);
+    TEST_ASSERT(strstr(path, "/arcade-hard-2.bin") != NULL, "Un fichier par mode, difficulté et joueurs");
+    TEST_EQUAL((int)sizeof(LeaderEntry), 32, "Entrée de 32 octets");
+
+    // Nom du joueur : option, sinon $USER, sinon "Player", 15 caractères au plus
+    char name[16];
+    char *user = getenv("USER") ? strdup(getenv("USER")) : NULL;
+    leaderboard_player_name(name, sizeof(name), "Alice");
+    TEST_ASSERT(strcmp(name, "Alice") == 0, "Nom donné");
+    leaderboard_player_name(name, sizeof(name), "UnNomBeaucoupTropLong");
+    TEST_ASSERT(strcmp(name, "UnNomBeaucoupTr") == 0, "Nom tronqué à 15 caractères");
+    setenv("USER", "bob", 1);
+    leaderboard_player_name(name, sizeof(name), NULL);
+    TEST_ASSERT(strcmp(name, "bob") == 0, "Nom par défaut : $USER");
+    unsetenv("USER");
+    leaderboard_player_name(name, sizeof(name), "");
+    TEST_ASSERT(strcmp(name, "Player") == 0, "Sans $USER : Player");
+    if (user) setenv("USER", user, 1);
+    free(user);
+
+    Leaderboard board;
+    TEST_ASSERT(leaderboard_open(&board, path, 300), "Classement absent : vide");
+    TEST_EQUAL((int)leaderboard_count(&board), 0, "Aucune entrée");
+    TEST_EQUAL((int)leaderboard_rank(&board, 10), 1, "Premier rang libre");
+
+    // 2000 scores au hasard (beaucoup d'égalités) dans un classement de 300
+    static int scores[300];
+    int count = 0, ranks_ok = 1;
+    unsigned int rng = 8;
+    for (int i = 0; i < 2000; i++) {
+        int score = (int)(snake_rand(&rng) % 1000);
+        long rank = leaderboard_insert(&board, score, 1, "Test", 1000 + i);
+        ranks_ok &= rank == reference_insert(scores, &count, 300, score);
+    }
+    TEST_ASSERT(ranks_ok, "Rangs d'insertion identiques à la référence");
+    TEST_ASSERT(leaderboard_matches(&board, scores, count), "Entrées et rangs identiques");
+
+    LeaderEntry first, second;
+    leaderboard_insert(&board, 5000, 3, "Premier", 1);
+    leaderboard_insert(&board, 5000, 4, "Second", 2);
+    reference_insert(scores, &count, 300, 5000);
+    reference_insert(scores, &count, 300, 5000);
+    TEST_ASSERT(leaderboard_entry(&board, 1, &first) && leaderboard_entry(&board, 2, &second) &&
+                strcmp(first.name, "Premier") == 0 && strcmp(second.name, "Second") == 0 && second.level == 4,
+                "À score égal, le plus ancien devant");
+    TEST_ASSERT(leaderboard_save(&board), "Classement écrit");
+    leaderboard_close(&board);
+
+    // Relecture paresseuse (tableau projeté), puis arbre reconstruit au
+    // premier ajout
+    TEST_ASSERT(leaderboard_open(&board, path, 300) && !board.loaded, "Fichier projeté sans arbre");
+    TEST_ASSERT(leaderboard_matches(&board, scores, count), "Lecture directe du fichier trié");
+    ranks_ok = 1;
+    for (int i = 0; i < 500; i++) {
+        int score = (int)(snake_rand(&rng) % 1000);
+        ranks_ok &= leaderboard_insert(&board, score, 1, "Test", i) == reference_insert(scores, &count, 300, score);
+    }
+    TEST_ASSERT(board.loaded && ranks_ok && leaderboard_matches(&board, scores, count), "Arbre reconstruit");
+    TEST_EQUAL((int)leaderboard_insert(&board, -5, 1, "Test", 0), 0, "Classement plein : dernier score refusé");
+    TEST_ASSERT(leaderboard_save(&board), "Classement réécrit");
+    leaderboard_close(&board);
+
+    // Soumissions par le journal : comptées à la lecture avant toute fusion
+    for (int i = 0; i < 100; i++) {
+        int score = (int)(snake_rand(&rng) % 1000);
+        leaderboard_submit(path, 300, score, 1, "Journal", i);
+        reference_insert(scores, &count, 300, score);
+    }
+    TEST_ASSERT(leaderboard_open(&board, path, 300) && !board.loaded && board.pending_count == 100,
+                "Journal lu à l'ouverture");
+    TEST_ASSERT(leaderboard_matches(&board, scores, count), "Fichier et journal fusionnés à la lecture");
+    static int merged[300];
+    int merged_count = count;
+    memcpy(merged, scores, sizeof(merged));
+    leaderboard_insert(&board, 700, 1, "Test", 0);
+    reference_insert(scores, &count, 300, 700);
+    TEST_ASSERT(board.loaded && leaderboard_matches(&board, scores, count), "Journal inséré dans l'arbre");
+    leaderboard_close(&board);
+    TEST_ASSERT(leaderboard_compact(path, 300), "Journal fusionné");
+    char journal[128];
+    snprintf(journal, sizeof(journal), "%s.journal", path);
+    struct stat st;
+    TEST_ASSERT(stat(journal, &st) == 0 && st.st_size == 0, "Journal vidé après fusion");
+    TEST_ASSERT(leaderboard_open(&board, path, 300) && board.pending_count == 0 &&
+                leaderboard_matches(&board, merged, merged_count), "Classement seul, journal compris");
+    leaderboard_close(&board);
+
+    // 8 processus soumettent 200 scores chacun en même temps, avec des
+    // fusions en cours de route : aucun score perdu
+    enum { WRITERS = 8, SUBMITS = 200 };
+    char stress[96], stress_journal[128];
+    leaderboard_path(stress, sizeof(stress), dir, MODE_CLASSIC, DIFF_EASY, 1);
+    snprintf(stress_journal, sizeof(stress_journal), "%s.journal", stress);
+    pid_t pids[WRITERS];
+    for (int w = 0; w < WRITERS; w++) {
+        pids[w] = fork();
+        if (pids[w] == 0) {
+            int ok = 1;
+            for (int i = 0; i < SUBMITS; i++) ok &= leaderboard_submit(stress, 10000, w * 1000 + i, 1, "Stress", i);
+            _exit(ok ? 0 : 1);
+        }
+    }
+    int children_ok = 1;
+    for (int w = 0; w < WRITERS; w++) {
+        int status = 0;
+        children_ok &= pids[w] > 0 && waitpid(pids[w], &status, 0) == pids[w] && WIFEXITED(status) &&
+                       WEXITSTATUS(status) == 0;
+    }
+    TEST_ASSERT(children_ok, "Soumissions concurrentes réussies");
+    int all_there = leaderboard_open(&board, stress, 10000) && leaderboard_count(&board) == WRITERS * SUBMITS;
+    LeaderEntry entry;
+    for (int rank = 1; all_there && rank <= WRITERS * SUBMITS; rank++) {
+        int expected = (WRITERS - 1 - (rank - 1) / SUBMITS) * 1000 + SUBMITS - 1 - (rank - 1) % SUBMITS;
+        all_there = leaderboard_entry(&board, rank, &entry) && entry.score == expected;
+    }
+    TEST_ASSERT(all_there, "Tous les scores présents, une seule fois");
+    TEST_ASSERT(board.disk_count > 0 && board.pending_count < LEADERBOARD_COMPACT_EVERY, "Journal fusionné en route");
+    leaderboard_close(&board);
+
+    unlink(path);
+    unlink(journal);
+    unlink(stress);
+    unlink(stress_journal);
+    rmdir(dir);
+}
+
+int main() {
+    printf("═══════════════════════════════════════════════════════\n");
+    printf("  TESTS UNITAIRES - MODULES DU NOYAU\n");
+    printf("═══════════════════════════════════════════════════════\n");
+    srand(time(NULL));
+    test_arena_init();
+    test_arena_ticks_consistent();
+    test_arena_deterministic();
+    test_arena_eat_and_collide();
+    test_arena_simultaneous_moves();
+    test_arena_thread_independence();
+    test_tilemap();
+    test_core_obstacles();
+    test_core_move_snake();
+    test_mapgen_connected();
+    test_mapgen_check();
+    test_core_obstacles_connected();
+    test_net_loopback();
+    test_stream_pipe();
+    test_stream_next();
+    test_turn_queue();
+    test_profiler();
+    test_frame_pacer();
+    test_font();
+    test_raster();
+    test_term();
+    test_core_determinism();
+    test_rollback_peers();
+    test_shm_bot();
+    test_botpipe();
+    test_vec_env();
+    test_features();
+    test_grid_kernels();
+    test_bitboard();
+    test_policy();
+    test_session_log();
+    test_leaderboard();
+    printf("\n═══════════════════════════════════════════════════════\n");
+    printf("  RÉSULTATS DES TESTS\n");
+    printf("═══════════════════════════════════════════════════════\n");
+    printf("Tests exécutés: %d\n", tests_run);
+    printf("Tests réussis:  %d\n", tests_passed);
+    printf("Tests échoués:  %d\n", tests_failed);
+    if (tests_failed == 0) {
+        printf("\n✓ TOUS LES TESTS SONT PASSÉS!\n");
+        return 0;
+    } else {
+        printf("\n✗ CERTAINS TESTS ONT ÉCHOUÉ\n");
+        return 1;
+    }
+}